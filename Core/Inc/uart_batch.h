@@ -0,0 +1,99 @@
+/*
+ * uart_batch.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_BATCH_H_
+#define INC_UART_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+#include "uart_frame.h"
+
+/*
+ * Command execution over frames. Payloads (all fields u8):
+ *
+ *   CMD_REQ    { seq, cmd, args... }
+ *   CMD_RESP   { seq, status, reply... }
+ *
+ *   BATCH_REQ  { batch_id, flags, count, count x { cmd, len, args[len] } }
+ *   BATCH_RESP { batch_id, executed, executed x { status, len, reply[len] } }
+ *
+ * A batch runs in order and answers with one frame. Execution stops early
+ * on a malformed entry, when the next reply might not fit the response
+ * frame, or on the first failure with UART_BATCH_FLAG_STOP_ON_ERROR;
+ * "executed" tells the host where to resume. status is a UART_ErrorTypeDef.
+ */
+
+/**** Configuration ****/
+#ifndef UART_BATCH_MAX_REPLY
+#define UART_BATCH_MAX_REPLY 16         // Reply bytes one command may produce
+#endif
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_BATCH_FLAG_STOP_ON_ERROR = 0x01
+} UART_BatchFlagTypeDef;
+
+/**
+ * @brief Command handler
+ * @param args Argument bytes
+ * @param len Number of argument bytes
+ * @param reply Reply buffer, UART_BATCH_MAX_REPLY bytes
+ * @param reply_len Pointer to store the reply length (0 on entry)
+ * @return Status reported to the host
+ */
+typedef UART_ErrorTypeDef (*UART_BatchHandlerTypeDef)(const uint8_t *args, uint8_t len,
+                                                      uint8_t *reply, uint8_t *reply_len);
+
+typedef struct {
+    uint8_t id;
+    UART_BatchHandlerTypeDef handler;
+} UART_BatchCommandTypeDef;
+
+typedef struct {
+    uint32_t single_commands;
+    uint64_t single_us;             // Frame SOF received to reply queued, summed
+    uint32_t batch_frames;
+    uint32_t batch_commands;
+    uint64_t batch_us;
+    uint32_t failed_commands;       // Non-success status, either path
+    uint32_t truncated_batches;     // Stopped before count (error, malformed or reply space)
+} UART_BatchStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Install the command table and register the request frame handlers
+ * @param table Commands, may live in flash
+ * @param count Number of commands
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Batch_Init(const UART_BatchCommandTypeDef *table, uint8_t count);
+
+/**
+ * @brief Run one command locally through the table
+ * @param cmd Command id
+ * @param args Argument bytes
+ * @param len Number of argument bytes
+ * @param reply Reply buffer, UART_BATCH_MAX_REPLY bytes
+ * @param reply_len Pointer to store the reply length
+ * @return Handler status, UART_ERROR_NOT_FOUND for an unknown command
+ */
+UART_ErrorTypeDef UART_Batch_Execute(uint8_t cmd, const uint8_t *args, uint8_t len,
+                                     uint8_t *reply, uint8_t *reply_len);
+
+/**
+ * @brief Get per-path command counts and service time
+ * @param out Destination for a snapshot of the statistics
+ * @note single_us / single_commands against batch_us / batch_commands is the
+ *       firmware share of configuration time per command for each path; it
+ *       leaves out the wire and host round trip, which Tools/batch_timing.py
+ *       measures end to end over the same frames
+ */
+void UART_Batch_GetStats(UART_BatchStatsTypeDef *out);
+
+#endif /* INC_UART_BATCH_H_ */
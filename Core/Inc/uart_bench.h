@@ -0,0 +1,94 @@
+/*
+ * uart_bench.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_BENCH_H_
+#define INC_UART_BENCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+#include "uart_frame.h"
+
+/*
+ * Link benchmark, driven by Tools/uart_bench.py. All fields little endian.
+ *
+ *   BENCH_CTRL   { op=START, mode, count:u32, len:u16 }   reset counters, enter mode
+ *                { op=STOP }                              back to IDLE
+ *                { op=SET_BAUD, baud:u32 }                switch after the reply has gone out
+ *                { op=ISR }                               answered with BENCH_ISR instead
+ *   BENCH_DATA   { seq:u32, host_us:u32, rx_us:u32, tx_us:u32, fill... }
+ *   BENCH_REPORT { mode, 0, buffer_size:u16, baud:u32, rx_frames, rx_bytes,
+ *                  tx_frames, tx_bytes, lost, first_rx_us, last_rx_us,
+ *                  checksum_errors, overruns }             (all u32)
+ *   BENCH_ISR    { features, idle, rx, tx, tx_empty, error } UART_BenchmarkIsr(), all u32
+ *
+ * Every BENCH_CTRL is answered with a BENCH_REPORT. In SINK mode DATA is
+ * counted and sequence gaps are reported as lost. SOURCE sends count DATA
+ * frames of len payload bytes as fast as the TX ring drains, stamped with
+ * tx_us. ECHO stamps rx_us (the SOF time when UART_ENABLE_TIMESTAMPS is
+ * set) and tx_us and sends the frame back; the host uses it both for
+ * streaming echo and for ping-pong round trips, where tx_us - rx_us is the
+ * board's share of the RTT. Fill byte i of frame seq is (seq + i) & 0xFF.
+ */
+
+/**** Configuration ****/
+#define UART_BENCH_DATA_HEADER 16U      // seq, host_us, rx_us, tx_us
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_BENCH_MODE_IDLE = 0,
+    UART_BENCH_MODE_SINK,
+    UART_BENCH_MODE_SOURCE,
+    UART_BENCH_MODE_ECHO
+} UART_BenchModeTypeDef;
+
+typedef enum {
+    UART_BENCH_OP_START = 1,
+    UART_BENCH_OP_STOP,
+    UART_BENCH_OP_SET_BAUD,
+    UART_BENCH_OP_ISR               // Needs UART_ENABLE_ISR_BENCHMARK, ignored otherwise
+} UART_BenchOpTypeDef;
+
+typedef struct {
+    UART_BenchModeTypeDef mode;
+    uint32_t rx_frames;
+    uint32_t rx_bytes;          // On the wire, framing included
+    uint32_t tx_frames;
+    uint32_t tx_bytes;
+    uint32_t lost;              // Sequence numbers skipped by received DATA
+    uint32_t first_rx_us;       // UART_TIME_US32() clock
+    uint32_t last_rx_us;
+} UART_BenchStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Register the benchmark frame handlers and enter IDLE
+ * @return UART_SUCCESS on success, error code otherwise
+ * @note Call after UART_Frame_Init() and UART_Timebase_Init()
+ */
+UART_ErrorTypeDef UART_Bench_Init(void);
+
+/**
+ * @brief Generate SOURCE traffic and apply a pending baud change
+ * @note Call from the main loop after UART_Frame_Poll(); never blocks on a full TX ring
+ */
+void UART_Bench_Process(void);
+
+/**
+ * @brief Check whether the benchmark has work without new RX bytes
+ * @return true while SOURCE frames, a baud change or an ISR benchmark are pending
+ */
+bool UART_Bench_Busy(void);
+
+/**
+ * @brief Get the counters of the current run
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Bench_GetStats(UART_BenchStatsTypeDef *out);
+
+#endif /* INC_UART_BENCH_H_ */
@@ -0,0 +1,84 @@
+/*
+ * uart_boot.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_BOOT_H_
+#define INC_UART_BOOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Fast start and boot-latency instrumentation.
+ *
+ * With UART_FAST_BOOT, main() calls UART_Boot_FastInit() before HAL_Init().
+ * USART2, its pins and its clock are brought up with LL register writes
+ * on HSI16, so the baud rate is unaffected when SystemClock_Config()
+ * later starts the LSE and PLL. The board can receive (and answer from
+ * an interrupt-driven ring) while that runs; MX_USART2_UART_Init() then
+ * leaves the port alone. If it fails, main() falls back to the usual HAL
+ * bring-up in MX_USART2_UART_Init() followed by UART_RingBuff_Init().
+ *
+ * With UART_BOOT_PROFILE, SystemInit() starts the DWT cycle counter at
+ * the reset vector and the driver marks the first TX byte and the moment
+ * RX is armed. UART_Boot_GetReport() converts the marks to microseconds
+ * using the core clock recorded at each mark.
+ */
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_BOOT_MARK_MAIN = 0,        // main() entered (.data/.bss/constructors done)
+    UART_BOOT_MARK_RX_READY,        // RX interrupt armed, rings ready
+    UART_BOOT_MARK_CLOCK_READY,     // SystemClock_Config() returned
+    UART_BOOT_MARK_INIT_DONE,       // main() initialization finished
+    UART_BOOT_MARK_FIRST_TX,        // First byte written to TDR
+    UART_BOOT_MARK_COUNT
+} UART_BootMarkTypeDef;
+
+typedef struct {
+    uint32_t valid;                         // Bit per recorded mark
+    uint32_t us[UART_BOOT_MARK_COUNT];      // Microseconds since the reset vector
+} UART_BootReportTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Bring USART2 up with LL register writes and arm the rings
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if HSI16 did not start
+ * @note Call first thing in main(), before HAL_Init(); requires UART_FAST_BOOT.
+ *       SysTick is not running until HAL_Init(), so driver timeouts do not
+ *       expire before then; only queue what fits in the TX ring
+ */
+UART_ErrorTypeDef UART_Boot_FastInit(void);
+
+/**
+ * @brief Record a boot milestone, first occurrence only
+ * @param mark Milestone
+ * @note Safe from interrupt context; a no-op without UART_BOOT_PROFILE
+ */
+void UART_Boot_Mark(UART_BootMarkTypeDef mark);
+
+/**
+ * @brief Milestones recorded so far
+ * @return Bit (1 << mark) per recorded mark, 0 without UART_BOOT_PROFILE
+ */
+uint32_t UART_Boot_GetMarks(void);
+
+/**
+ * @brief Forget milestones recorded since a UART_Boot_GetMarks() snapshot
+ * @param keep Snapshot from UART_Boot_GetMarks()
+ * @note UART_BenchmarkIsr() uses it so its own TX bytes do not count as the first TX
+ */
+void UART_Boot_RestoreMarks(uint32_t keep);
+
+/**
+ * @brief Convert the recorded milestones to microseconds since reset
+ * @param out Destination for the report
+ */
+void UART_Boot_GetReport(UART_BootReportTypeDef *out);
+
+#endif /* INC_UART_BOOT_H_ */
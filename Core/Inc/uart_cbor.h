@@ -0,0 +1,215 @@
+/*
+ * uart_cbor.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_CBOR_H_
+#define INC_UART_CBOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Allocation-free CBOR (RFC 8949) for structured telemetry.
+ *
+ * The encoder writes into a caller buffer, normally a frame reserved in
+ * the TX ring. Initialised with a NULL buffer it only counts, so running
+ * the same encode function twice gives the exact size first and the bytes
+ * second:
+ *
+ *   UART_Cbor_EncoderInit(&enc, NULL, 0);   Encode(&enc);
+ *   p = UART_Frame_Reserve(enc.len);
+ *   UART_Cbor_EncoderInit(&enc, p, enc.len); Encode(&enc);
+ *   UART_Frame_Commit(UART_FRAME_TYPE_CBOR, enc.len);
+ *
+ * The decoder pulls one item at a time from a slice, e.g. from
+ * UART_RxPeekSlice(), so items that straddle the ring wrap are read in
+ * place. Arrays and maps are returned as headers; the caller walks their
+ * contents. Indefinite lengths are not supported.
+ */
+
+/**** Configuration ****/
+#ifndef UART_CBOR_ENABLE_BENCHMARK
+#define UART_CBOR_ENABLE_BENCHMARK 0    // 1: build UART_Cbor_Benchmark() (links snprintf)
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint8_t *buf;               // NULL: size only
+    uint16_t size;
+    uint16_t len;               // Bytes encoded so far, including any that did not fit
+} UART_CborEncoderTypeDef;
+
+typedef struct {
+    UART_SliceTypeDef slice;
+    uint16_t pos;               // Offset of the next item; consume this many bytes when done
+} UART_CborDecoderTypeDef;
+
+typedef enum {
+    UART_CBOR_UINT = 0,         // u
+    UART_CBOR_NINT,             // i (always negative)
+    UART_CBOR_BYTES,            // data
+    UART_CBOR_TEXT,             // data, not NUL-terminated
+    UART_CBOR_ARRAY,            // u = element count
+    UART_CBOR_MAP,              // u = pair count
+    UART_CBOR_TAG,              // u = tag number, the tagged item follows
+    UART_CBOR_BOOL,             // b
+    UART_CBOR_NULL,
+    UART_CBOR_UNDEFINED,
+    UART_CBOR_FLOAT             // f (half, single and double precision)
+} UART_CborTypeTypeDef;
+
+typedef struct {
+    UART_CborTypeTypeDef type;
+    union {
+        uint64_t u;
+        int64_t i;
+        float f;
+        bool b;
+    };
+    UART_SliceTypeDef data;     // Payload of BYTES/TEXT, may span the ring wrap
+} UART_CborItemTypeDef;
+
+typedef struct {
+    uint32_t records;               // Records encoded per measurement
+    uint32_t cbor_bytes;            // Size of the last record, 0 if a record did not fit
+    uint32_t cbor_cycles;           // Sizing pass + encode pass, all records
+    uint32_t json_bytes;
+    uint32_t json_cycles;           // snprintf() of the same record
+} UART_CborBenchmarkTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Start encoding
+ * @param enc Encoder
+ * @param buf Destination, NULL to only compute the size
+ * @param size Capacity of buf
+ */
+void UART_Cbor_EncoderInit(UART_CborEncoderTypeDef *enc, uint8_t *buf, uint16_t size);
+
+/**
+ * @brief Encode an unsigned integer in the shortest form
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeUint(UART_CborEncoderTypeDef *enc, uint32_t value);
+
+/**
+ * @brief Encode a signed integer in the shortest form
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeInt(UART_CborEncoderTypeDef *enc, int32_t value);
+
+/**
+ * @brief Encode a single-precision float
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeFloat(UART_CborEncoderTypeDef *enc, float value);
+
+/**
+ * @brief Encode true or false
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeBool(UART_CborEncoderTypeDef *enc, bool value);
+
+/**
+ * @brief Encode null
+ * @param enc Encoder
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeNull(UART_CborEncoderTypeDef *enc);
+
+/**
+ * @brief Encode a byte string
+ * @param enc Encoder
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeBytes(UART_CborEncoderTypeDef *enc, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Encode a NUL-terminated UTF-8 text string
+ * @param enc Encoder
+ * @param text String
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeText(UART_CborEncoderTypeDef *enc, const char *text);
+
+/**
+ * @brief Encode an array header; the count items follow
+ * @param enc Encoder
+ * @param count Number of elements
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeArray(UART_CborEncoderTypeDef *enc, uint32_t count);
+
+/**
+ * @brief Encode a map header; count key/value pairs follow
+ * @param enc Encoder
+ * @param count Number of pairs
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeMap(UART_CborEncoderTypeDef *enc, uint32_t count);
+
+/**
+ * @brief Start decoding a slice
+ * @param dec Decoder
+ * @param slice Input, e.g. from UART_RxPeekSlice() or UART_SLICE() (uart_number.h)
+ */
+void UART_Cbor_DecoderInit(UART_CborDecoderTypeDef *dec, const UART_SliceTypeDef *slice);
+
+/**
+ * @brief Decode the next item
+ * @param dec Decoder
+ * @param item Pointer to store the item
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if the item is not
+ *         complete yet (dec is unchanged), UART_ERROR_INVALID_DATA if it is malformed
+ *         or uses an unsupported encoding
+ */
+UART_ErrorTypeDef UART_Cbor_Next(UART_CborDecoderTypeDef *dec, UART_CborItemTypeDef *item);
+
+/**
+ * @brief Skip the next item including everything nested in it
+ * @param dec Decoder
+ * @return As UART_Cbor_Next(); on error dec is unchanged
+ */
+UART_ErrorTypeDef UART_Cbor_Skip(UART_CborDecoderTypeDef *dec);
+
+/**
+ * @brief Copy the payload of a BYTES or TEXT item
+ * @param item Decoded item
+ * @param dst Destination
+ * @param size Capacity of dst
+ * @return Bytes copied, at most size
+ */
+uint16_t UART_Cbor_Copy(const UART_CborItemTypeDef *item, uint8_t *dst, uint16_t size);
+
+/**
+ * @brief Compare a TEXT item with a NUL-terminated string
+ * @param item Decoded item
+ * @param text String
+ * @return true if item is TEXT with exactly these bytes, false otherwise
+ */
+bool UART_Cbor_TextEquals(const UART_CborItemTypeDef *item, const char *text);
+
+/**
+ * @brief Encode the same telemetry record as CBOR and as snprintf() JSON
+ * @param result Pointer to store sizes and DWT cycle counts
+ * @note Requires UART_CBOR_ENABLE_BENCHMARK and UART_Timebase_Init() (DWT)
+ */
+void UART_Cbor_Benchmark(UART_CborBenchmarkTypeDef *result);
+
+#endif /* INC_UART_CBOR_H_ */
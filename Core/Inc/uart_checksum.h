@@ -0,0 +1,100 @@
+/*
+ * uart_checksum.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_CHECKSUM_H_
+#define INC_UART_CHECKSUM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Software checksums for frame validation when the CRC unit is not an
+ * option. Update() consumes a 32-bit word per step and defers the modulo
+ * reduction to once per block; on Cortex-M4 the byte sums use USADA8 and
+ * the position-weighted sums UXTB16 + SMUAD/SMLAD. Other targets use the
+ * same word-wise arithmetic in plain C.
+ */
+
+/**** Configuration ****/
+#ifndef UART_CHECKSUM_ENABLE_BENCHMARK
+#define UART_CHECKSUM_ENABLE_BENCHMARK 0    // 1: build UART_Checksum_Benchmark()
+#endif
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_CHECKSUM_FLETCHER16 = 0,   // 2 bytes, sums mod 255
+    UART_CHECKSUM_FLETCHER32,       // 4 bytes, little-endian 16-bit words, sums mod 65535
+    UART_CHECKSUM_ADLER32,          // 4 bytes, RFC 1950
+    UART_CHECKSUM_XOR8,             // 1 byte, XOR of all bytes
+    UART_CHECKSUM_SUM8,             // 1 byte, sum of all bytes mod 256
+    UART_CHECKSUM_COUNT
+} UART_ChecksumAlgoTypeDef;
+
+typedef struct {
+    uint32_t a;
+    uint32_t b;
+    UART_ChecksumAlgoTypeDef algo;
+    uint8_t odd_byte;               // Fletcher-32: first half of a split 16-bit word
+    bool has_odd_byte;
+} UART_ChecksumTypeDef;
+
+typedef struct {
+    uint32_t bytes;                             // Buffer size used for every measurement
+    uint32_t cycles[UART_CHECKSUM_COUNT];
+    uint32_t centicycles_per_byte[UART_CHECKSUM_COUNT];  // Cycles per byte x 100
+    uint32_t fletcher16_bytewise_cycles;        // Per-byte modulo reference
+} UART_ChecksumBenchmarkTypeDef;
+
+/**** Convenience Macros ****/
+#define UART_CHECKSUM_SIZE(algo) \
+    (((algo) == UART_CHECKSUM_FLETCHER32 || (algo) == UART_CHECKSUM_ADLER32) ? 4U : \
+     ((algo) == UART_CHECKSUM_FLETCHER16) ? 2U : 1U)
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Start a checksum
+ * @param ctx Accumulator
+ * @param algo Algorithm
+ */
+void UART_Checksum_Init(UART_ChecksumTypeDef *ctx, UART_ChecksumAlgoTypeDef algo);
+
+/**
+ * @brief Add a block of bytes
+ * @param ctx Accumulator
+ * @param data Bytes, any alignment
+ * @param len Number of bytes
+ * @note Blocks may be split anywhere, e.g. along ring segment boundaries
+ */
+void UART_Checksum_Update(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Get the checksum of everything added so far
+ * @param ctx Accumulator
+ * @return Checksum in the low UART_CHECKSUM_SIZE(algo) bytes
+ */
+uint32_t UART_Checksum_Value(const UART_ChecksumTypeDef *ctx);
+
+/**
+ * @brief Checksum a single buffer
+ * @param algo Algorithm
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return Checksum
+ */
+uint32_t UART_Checksum_Compute(UART_ChecksumAlgoTypeDef algo, const uint8_t *data, size_t len);
+
+/**
+ * @brief Measure every algorithm over the same buffer
+ * @param result Pointer to store DWT cycle counts
+ * @note Requires UART_CHECKSUM_ENABLE_BENCHMARK and UART_Timebase_Init() (DWT)
+ */
+void UART_Checksum_Benchmark(UART_ChecksumBenchmarkTypeDef *result);
+
+#endif /* INC_UART_CHECKSUM_H_ */
@@ -0,0 +1,113 @@
+/*
+ * uart_clock_gov.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_CLOCK_GOV_H_
+#define INC_UART_CLOCK_GOV_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Load governor: samples ring occupancy and byte rate every
+ * UART_CLOCK_GOV_SAMPLE_MS and moves SYSCLK between three profiles:
+ *
+ *   HIGH  80 MHz  PLL (MSI 4 MHz x 40 / 2)  Range 1  4 WS
+ *   MID   16 MHz  HSI16                     Range 2  2 WS
+ *   LOW    4 MHz  MSI (LSE-trimmed)         Range 2  0 WS
+ *
+ * USART2 is moved to HSI16 at init, so its baud rate does not depend on
+ * SYSCLK. PLL lock and voltage scaling run with interrupts enabled; only
+ * the SYSCLK switch itself is done with interrupts masked, which is a few
+ * cycles against one character time, so no RX byte can be overrun.
+ * Demand raises the clock at once; it drops one profile after
+ * UART_CLOCK_GOV_DOWN_SAMPLES quiet samples in a row.
+ */
+
+/**** Configuration ****/
+#ifndef UART_CLOCK_GOV_SAMPLE_MS
+#define UART_CLOCK_GOV_SAMPLE_MS 10
+#endif
+
+#ifndef UART_CLOCK_GOV_DOWN_SAMPLES
+#define UART_CLOCK_GOV_DOWN_SAMPLES 20      // Quiet samples before stepping down
+#endif
+
+#ifndef UART_CLOCK_GOV_HIGH_RATE
+#define UART_CLOCK_GOV_HIGH_RATE 4000U      // Bytes/s (RX + TX) that call for HIGH
+#endif
+
+#ifndef UART_CLOCK_GOV_MID_RATE
+#define UART_CLOCK_GOV_MID_RATE 200U        // Bytes/s (RX + TX) that call for MID
+#endif
+
+#ifndef UART_CLOCK_GOV_HIGH_FILL
+#define UART_CLOCK_GOV_HIGH_FILL (UART_BUFFER_SIZE / 4U)   // Ring backlog that calls for HIGH
+#endif
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_CLOCK_PROFILE_LOW = 0,
+    UART_CLOCK_PROFILE_MID,
+    UART_CLOCK_PROFILE_HIGH,
+    UART_CLOCK_PROFILE_COUNT
+} UART_ClockProfileTypeDef;
+
+typedef struct {
+    uint32_t transitions;
+    uint32_t transitions_up;
+    uint32_t transitions_down;
+    uint32_t failures;                      // Oscillator or regulator did not come up
+    uint32_t last_transition_us;            // Whole transition, PLL lock and regulator included
+    uint32_t max_transition_us;
+    uint64_t total_transition_us;
+    uint32_t max_masked_cycles;             // Core cycles with interrupts masked for the switch
+    uint64_t residency_us[UART_CLOCK_PROFILE_COUNT];
+    UART_ClockProfileTypeDef profile;
+} UART_ClockGovStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Move USART2 to HSI16 and enter the MID profile
+ * @return UART_SUCCESS on success, error code otherwise
+ * @note Call after UART_Timebase_Init() and UART_RingBuff_Init(), before traffic starts
+ */
+UART_ErrorTypeDef UART_ClockGov_Init(void);
+
+/**
+ * @brief Start periodic load sampling on the timer wheel
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockGov_Start(void);
+
+/**
+ * @brief Stop load sampling and stay on the current profile
+ */
+void UART_ClockGov_Stop(void);
+
+/**
+ * @brief Switch to a profile now
+ * @param profile Target profile
+ * @return UART_SUCCESS on success, error code otherwise
+ * @note Thread context only; the governor may move away again on its next sample
+ */
+UART_ErrorTypeDef UART_ClockGov_SetProfile(UART_ClockProfileTypeDef profile);
+
+/**
+ * @brief Get the active profile
+ * @return Profile
+ */
+UART_ClockProfileTypeDef UART_ClockGov_GetProfile(void);
+
+/**
+ * @brief Get transition counters, costs and per-profile residency
+ * @param stats Destination for a snapshot of the statistics
+ */
+void UART_ClockGov_GetStats(UART_ClockGovStatsTypeDef *stats);
+
+#endif /* INC_UART_CLOCK_GOV_H_ */
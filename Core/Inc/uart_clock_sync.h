@@ -0,0 +1,95 @@
+/*
+ * uart_clock_sync.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_CLOCK_SYNC_H_
+#define INC_UART_CLOCK_SYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Two-way time transfer, board is the client:
+ *
+ *   board -> host  TIME_SYNC_REQ  { seq:u32 }                     sent at T1 (board clock)
+ *   host  -> board TIME_SYNC_RESP { seq:u32, t2:u64, t3:u64 }     T2 = host RX, T3 = host TX
+ *                                                                 received at T4 (board clock)
+ *
+ * T1 and T4 are latched by the UART ISR (UART_ENABLE_TIMESTAMPS), all times in microseconds.
+ */
+
+/**** Configuration ****/
+#ifndef UART_CLOCK_SYNC_DELAY_WINDOW
+#define UART_CLOCK_SYNC_DELAY_WINDOW 8      // Samples used for the minimum round-trip delay
+#endif
+
+#ifndef UART_CLOCK_SYNC_DELAY_SLACK_US
+#define UART_CLOCK_SYNC_DELAY_SLACK_US 200  // Accepted delay above the windowed minimum
+#endif
+
+#ifndef UART_CLOCK_SYNC_MAX_DRIFT_PPB
+#define UART_CLOCK_SYNC_MAX_DRIFT_PPB 500000
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    bool synchronized;
+    int64_t offset_ns;          // Host minus board at the last update
+    int32_t drift_ppb;          // Host rate relative to board rate
+    int32_t last_error_ns;      // Measured minus predicted offset (sync error)
+    uint32_t last_delay_us;     // Round-trip delay excluding host turnaround
+    uint32_t samples;
+    uint32_t rejected;          // Dropped by the delay filter or sequence check
+    uint32_t timeouts;          // Requests without a response
+} UART_ClockSyncStatusTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Reset the estimator and register the response frame handler
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_Init(void);
+
+/**
+ * @brief Start periodic synchronization requests
+ * @param period_ms Request period in HAL ticks
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_Start(uint32_t period_ms);
+
+/**
+ * @brief Stop periodic synchronization requests
+ */
+void UART_ClockSync_Stop(void);
+
+/**
+ * @brief Send a single synchronization request now
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_SendRequest(void);
+
+/**
+ * @brief Convert a board timestamp into host time
+ * @param local_us Timestamp on the UART_Time_Us() clock
+ * @return Estimated host time in microseconds (local_us if not synchronized)
+ */
+uint64_t UART_ClockSync_ToHost(uint64_t local_us);
+
+/**
+ * @brief Current host time estimate, for stamping outgoing frames
+ * @return Estimated host time in microseconds
+ */
+uint64_t UART_ClockSync_HostTimeUs(void);
+
+/**
+ * @brief Get the estimator state
+ * @param status Destination for a snapshot of the state
+ */
+void UART_ClockSync_GetStatus(UART_ClockSyncStatusTypeDef *status);
+
+#endif /* INC_UART_CLOCK_SYNC_H_ */
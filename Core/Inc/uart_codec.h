@@ -0,0 +1,128 @@
+/*
+ * uart_codec.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_CODEC_H_
+#define INC_UART_CODEC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Hex and base64 codecs that convert a 32-bit word per step: all bytes of the
+ * word are classified and mapped at once with SWAR masks, using the Cortex-M4
+ * byte-lane instructions (UADD8/USUB8/SEL) where available. The ring
+ * variants encode straight into the TX ring and decode straight out of the
+ * RX ring through the zero-copy span API, without an intermediate buffer.
+ */
+
+/**** Configuration ****/
+#ifndef UART_CODEC_ENABLE_BENCHMARK
+#define UART_CODEC_ENABLE_BENCHMARK 0   // 1: build UART_Codec_Benchmark() and the naive reference codecs
+#endif
+
+/**** Convenience Macros ****/
+#define UART_HEX_ENCODED_LEN(n)     (2U * (n))
+#define UART_BASE64_ENCODED_LEN(n)  (4U * (((n) + 2U) / 3U))
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t bytes;                 // Payload size used for every measurement
+    uint32_t hex_encode_cycles;
+    uint32_t hex_encode_naive_cycles;   // sprintf("%02X")
+    uint32_t hex_decode_cycles;
+    uint32_t hex_decode_naive_cycles;   // sscanf("%2hhx")
+    uint32_t base64_encode_cycles;
+    uint32_t base64_encode_naive_cycles; // Byte-wise table lookup
+    uint32_t base64_decode_cycles;
+    uint32_t base64_decode_naive_cycles;
+} UART_CodecBenchmarkTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Encode bytes as uppercase hex
+ * @param src Bytes to encode
+ * @param len Number of bytes
+ * @param dst Destination, UART_HEX_ENCODED_LEN(len) characters, not null-terminated
+ * @return Characters written
+ */
+size_t UART_Hex_Encode(const uint8_t *src, size_t len, char *dst);
+
+/**
+ * @brief Decode hex (either case)
+ * @param src Characters to decode
+ * @param len Number of characters, must be even
+ * @param dst Destination, len / 2 bytes
+ * @param out_len Pointer to store the number of bytes written
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA on a non-hex character
+ */
+UART_ErrorTypeDef UART_Hex_Decode(const char *src, size_t len, uint8_t *dst, size_t *out_len);
+
+/**
+ * @brief Encode bytes as padded base64 (RFC 4648 alphabet)
+ * @param src Bytes to encode
+ * @param len Number of bytes
+ * @param dst Destination, UART_BASE64_ENCODED_LEN(len) characters, not null-terminated
+ * @return Characters written
+ */
+size_t UART_Base64_Encode(const uint8_t *src, size_t len, char *dst);
+
+/**
+ * @brief Decode padded base64
+ * @param src Characters to decode
+ * @param len Number of characters, must be a multiple of 4
+ * @param dst Destination, at most 3 * len / 4 bytes
+ * @param out_len Pointer to store the number of bytes written
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA on a malformed input
+ */
+UART_ErrorTypeDef UART_Base64_Decode(const char *src, size_t len, uint8_t *dst, size_t *out_len);
+
+/**
+ * @brief Send bytes hex-encoded through the TX ring
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if TX stayed full
+ */
+UART_ErrorTypeDef UART_Hex_Write(const uint8_t *data, size_t len);
+
+/**
+ * @brief Receive hex-encoded bytes from the RX ring
+ * @param data Destination
+ * @param len Number of bytes to receive (2 * len characters are consumed)
+ * @param timeout_ms Timeout in milliseconds while waiting for each character
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT or UART_ERROR_INVALID_DATA otherwise
+ * @note Characters up to and including a bad one are consumed
+ */
+UART_ErrorTypeDef UART_Hex_Read(uint8_t *data, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Send bytes base64-encoded through the TX ring
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if TX stayed full
+ */
+UART_ErrorTypeDef UART_Base64_Write(const uint8_t *data, size_t len);
+
+/**
+ * @brief Receive base64-encoded bytes from the RX ring
+ * @param data Destination
+ * @param len Number of bytes to receive (UART_BASE64_ENCODED_LEN(len) characters are consumed)
+ * @param timeout_ms Timeout in milliseconds while waiting for each character
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT or UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Base64_Read(uint8_t *data, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Time the word-wise codecs against naive byte-wise versions
+ * @param result Pointer to store DWT cycle counts
+ * @note Requires UART_CODEC_ENABLE_BENCHMARK and UART_Timebase_Init() (DWT)
+ */
+void UART_Codec_Benchmark(UART_CodecBenchmarkTypeDef *result);
+
+#endif /* INC_UART_CODEC_H_ */
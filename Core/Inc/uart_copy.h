@@ -0,0 +1,80 @@
+/*
+ * uart_copy.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_COPY_H_
+#define INC_UART_COPY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Bulk copies into and out of the rings. newlib-nano's memcpy is a byte
+ * loop; UART_Copy() aligns the destination to a word boundary, then moves
+ * 32-byte LDM/STM bursts when the source is aligned too, or unaligned LDR
+ * with aligned STR when it is not (Cortex-M4 allows unaligned LDR while
+ * CCR.UNALIGN_TRP is clear, the reset value). LDM/STM are interruptible,
+ * so a burst does not lengthen interrupt latency. Other targets use memcpy.
+ *
+ * The ring variants split a wrapping span into its two segments up front
+ * and copy both unconditionally; the second copy is empty when the span
+ * does not wrap.
+ */
+
+/**** Configuration ****/
+#ifndef UART_COPY_ENABLE_BENCHMARK
+#define UART_COPY_ENABLE_BENCHMARK 0    // 1: build UART_Copy_Benchmark()
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t bytes;                         // Copy size, 1 KB
+    uint32_t cycles_per_kb[4][4];           // UART_Copy(), [source & 3][destination & 3]
+    uint32_t memcpy_cycles_per_kb[4][4];    // Library memcpy, same cases
+    uint32_t ring_wrap_cycles_per_kb;       // UART_Copy_FromRing(), odd start, wrapping
+    uint32_t ring_wrap_memcpy_cycles_per_kb;    // Two memcpy calls, same span
+} UART_CopyBenchmarkTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Copy bytes between non-overlapping buffers
+ * @param dst Destination, any alignment
+ * @param src Source, any alignment
+ * @param len Number of bytes
+ */
+void UART_Copy(void *dst, const void *src, size_t len);
+
+/**
+ * @brief Copy a span out of a ring, across the wrap if needed
+ * @param dst Destination
+ * @param ring Ring storage
+ * @param size Ring size in bytes
+ * @param pos Read position, below size
+ * @param len Number of bytes, at most size
+ * @return Bytes taken from the first segment (from pos up to the end of the ring)
+ */
+size_t UART_Copy_FromRing(uint8_t *dst, const uint8_t *ring, size_t size, size_t pos, size_t len);
+
+/**
+ * @brief Copy bytes into a ring, across the wrap if needed
+ * @param ring Ring storage
+ * @param size Ring size in bytes
+ * @param pos Write position, below size
+ * @param src Source
+ * @param len Number of bytes, at most size
+ * @return Bytes stored in the first segment (from pos up to the end of the ring)
+ */
+size_t UART_Copy_ToRing(uint8_t *ring, size_t size, size_t pos, const uint8_t *src, size_t len);
+
+/**
+ * @brief Measure UART_Copy() and memcpy for every source/destination alignment
+ * @param result Pointer to store DWT cycle counts
+ * @note Requires UART_COPY_ENABLE_BENCHMARK and UART_Timebase_Init() (DWT)
+ */
+void UART_Copy_Benchmark(UART_CopyBenchmarkTypeDef *result);
+
+#endif /* INC_UART_COPY_H_ */
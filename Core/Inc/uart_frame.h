@@ -0,0 +1,140 @@
+/*
+ * uart_frame.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_FRAME_H_
+#define INC_UART_FRAME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+#include "uart_checksum.h"
+
+/*
+ * Wire format (little endian):
+ *
+ *   SOF | LEN_LO | LEN_HI | TYPE | PAYLOAD[LEN] | CHECKSUM_LO | CHECKSUM_HI
+ *
+ * The checksum (UART_FRAME_CHECKSUM, Fletcher-16 by default) covers LEN, TYPE
+ * and PAYLOAD. Both ends must be built with the same algorithm.
+ */
+
+/**** Configuration ****/
+#define UART_FRAME_SOF UART_TIMESTAMP_MARKER
+
+#ifndef UART_FRAME_MAX_PAYLOAD
+#define UART_FRAME_MAX_PAYLOAD 256
+#endif
+
+#ifndef UART_FRAME_MAX_HANDLERS
+#define UART_FRAME_MAX_HANDLERS 8
+#endif
+
+#ifndef UART_FRAME_CHECKSUM
+#define UART_FRAME_CHECKSUM UART_CHECKSUM_FLETCHER16   // Any UART_ChecksumAlgoTypeDef
+#endif
+
+#define UART_FRAME_HEADER_SIZE   4U     // SOF + LEN + TYPE
+#define UART_FRAME_TRAILER_SIZE  UART_CHECKSUM_SIZE(UART_FRAME_CHECKSUM)
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_FRAME_TYPE_TIME_SYNC_REQ  = 0x01,
+    UART_FRAME_TYPE_TIME_SYNC_RESP = 0x02,
+    UART_FRAME_TYPE_CMD_REQ        = 0x03,  // One command (uart_batch.h)
+    UART_FRAME_TYPE_CMD_RESP       = 0x04,
+    UART_FRAME_TYPE_BATCH_REQ      = 0x05,  // Many commands, one coalesced response
+    UART_FRAME_TYPE_BATCH_RESP     = 0x06,
+    UART_FRAME_TYPE_RPC_REQ        = 0x07,  // TLV procedure call (uart_rpc.h)
+    UART_FRAME_TYPE_RPC_RESP       = 0x08,
+    UART_FRAME_TYPE_CBOR           = 0x09,  // CBOR telemetry record (uart_cbor.h)
+    UART_FRAME_TYPE_BENCH_CTRL     = 0x0A,  // Benchmark control (uart_bench.h)
+    UART_FRAME_TYPE_BENCH_DATA     = 0x0B,
+    UART_FRAME_TYPE_BENCH_REPORT   = 0x0C,
+    UART_FRAME_TYPE_BENCH_ISR      = 0x0D   // UART_BenchmarkIsr() result
+} UART_FrameTypeTypeDef;
+
+typedef struct {
+    uint8_t type;
+    uint16_t len;
+    const uint8_t *payload;     // Valid only for the duration of the handler call
+    uint32_t rx_timestamp_us;   // ISR time of the SOF byte (UART_TIME_US32 clock)
+    bool rx_timestamp_valid;
+} UART_FrameTypeDef;
+
+typedef void (*UART_FrameHandlerTypeDef)(const UART_FrameTypeDef *frame);
+
+typedef struct {
+    uint32_t rx_frames;
+    uint32_t rx_checksum_errors;
+    uint32_t rx_oversize;
+    uint32_t rx_unhandled;
+    uint32_t tx_frames;
+} UART_FrameStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Reset the frame parser and handler table
+ */
+void UART_Frame_Init(void);
+
+/**
+ * @brief Register the handler for a frame type
+ * @param type Frame type
+ * @param handler Function called from UART_Frame_Poll(), NULL to remove
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_FULL if the table is full
+ */
+UART_ErrorTypeDef UART_Frame_RegisterHandler(uint8_t type, UART_FrameHandlerTypeDef handler);
+
+/**
+ * @brief Parse bytes waiting in the RX buffer and dispatch complete frames
+ * @note Call this from the main loop instead of reading the RX buffer directly
+ */
+void UART_Frame_Poll(void);
+
+/**
+ * @brief Parse RX bytes until one frame has been dispatched
+ * @return true if a frame was dispatched, false if RX ran dry first
+ * @note Lets a scheduler bound the work done per call, e.g. a pipeline stage
+ */
+bool UART_Frame_PollOne(void);
+
+/**
+ * @brief Send one frame through the TX buffer
+ * @param type Frame type
+ * @param payload Payload bytes (may be NULL when len is 0)
+ * @param len Payload length, up to UART_FRAME_MAX_PAYLOAD
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Frame_Send(uint8_t type, const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief Reserve room for a frame payload to be built in place
+ * @param max_len Largest payload the caller may write, up to UART_FRAME_MAX_PAYLOAD
+ * @return Payload area inside the TX buffer, or a staging buffer when the contiguous
+ *         free span is too short (near the ring wrap); NULL if max_len is too large
+ * @note Zero-copy send: write the payload, then call UART_Frame_Commit(). The
+ *       main loop must not queue other TX bytes in between
+ */
+uint8_t *UART_Frame_Reserve(uint16_t max_len);
+
+/**
+ * @brief Complete the header and checksum of a reserved frame and start sending
+ * @param type Frame type
+ * @param len Payload bytes written, at most the reserved length
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Frame_Commit(uint8_t type, uint16_t len);
+
+/**
+ * @brief Get frame statistics
+ * @param stats Destination for a snapshot of the statistics
+ */
+void UART_Frame_GetStats(UART_FrameStatsTypeDef *stats);
+
+#endif /* INC_UART_FRAME_H_ */
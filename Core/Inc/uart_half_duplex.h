@@ -0,0 +1,98 @@
+/*
+ * uart_half_duplex.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_HALF_DUPLEX_H_
+#define INC_UART_HALF_DUPLEX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Single-wire half-duplex mode (USART HDSEL) on the TX pin. The receiver
+ * stays enabled, so turnaround needs no register writes: every byte we
+ * send is read back from the wire, matched against what was sent and
+ * dropped in the ISR, and anything else lands in the RX ring as usual.
+ * A mismatch means another node drove the bus at the same time.
+ */
+
+/**** Configuration ****/
+#ifndef UART_HD_ECHO_DEPTH
+#define UART_HD_ECHO_DEPTH 8            // Power of two; TDR + shift register need 2
+#endif
+
+#ifndef UART_HD_INTERBYTE_CHARS
+#define UART_HD_INTERBYTE_CHARS 3       // Response gap allowed between bytes, in character times
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t transactions;
+    uint32_t timeouts;                  // No response, or it stopped early
+    uint32_t collisions;                // Transactions that read back a foreign byte
+    uint32_t echo_bytes;                // Own bytes dropped from RX
+    uint32_t echo_mismatches;           // Read back differently than sent
+    uint32_t last_turnaround_us;        // Last echoed stop bit to first response byte
+    uint32_t max_turnaround_us;
+} UART_HalfDuplexStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Switch the driver's USART to single-wire half-duplex on the TX pin
+ * @return UART_SUCCESS on success, error code otherwise
+ * @note Call after UART_RingBuff_Init() and UART_Timebase_Init(), before traffic starts.
+ *       The TX pin becomes open-drain with pull-up; the RX pin is released.
+ */
+UART_ErrorTypeDef UART_HalfDuplex_Init(void);
+
+/**
+ * @brief Send a request and receive a fixed-length response
+ * @param request Request bytes
+ * @param request_len Request length
+ * @param response Destination for the response
+ * @param response_len Expected response length, 0 for send-only
+ * @param turnaround_us Longest allowed gap from the end of the request to the first response byte
+ * @return UART_SUCCESS on success,
+ *         UART_ERROR_TIMEOUT if the request did not go out or the response was late or short,
+ *         UART_ERROR_INVALID_DATA if the request collided with another node
+ * @note Stale RX bytes are discarded before the request is sent
+ */
+UART_ErrorTypeDef UART_HalfDuplex_Transact(const uint8_t *request, uint16_t request_len,
+                                           uint8_t *response, uint16_t response_len,
+                                           uint32_t turnaround_us);
+
+/**
+ * @brief Get transaction and echo statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_HalfDuplex_GetStats(UART_HalfDuplexStatsTypeDef *out);
+
+/**
+ * @brief Record a byte written to TDR as an expected echo
+ * @param c Byte sent
+ * @note Called from UART_ISR_Handler() after each TDR write
+ */
+void UART_HalfDuplex_OnTransmit(uint8_t c);
+
+/**
+ * @brief Check a received byte against the expected echo
+ * @param c Byte received
+ * @return true if the byte is our own echo and must be dropped, false otherwise
+ * @note Called from UART_ISR_Handler() on RXNE
+ */
+bool UART_HalfDuplex_IsEcho(uint8_t c);
+
+/**
+ * @brief Stop echo tracking so the ISR hooks pass every byte by, or resume it
+ * @param hold true to stop, false to resume
+ * @note Call with interrupts masked and resume before unmasking; UART_BenchmarkIsr()
+ *       uses it so its own bytes neither queue echoes nor end a response wait
+ */
+void UART_HalfDuplex_HoldEcho(bool hold);
+
+#endif /* INC_UART_HALF_DUPLEX_H_ */
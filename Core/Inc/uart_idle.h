@@ -0,0 +1,105 @@
+/*
+ * uart_idle.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_IDLE_H_
+#define INC_UART_IDLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Tickless idle. SysTick exists only to advance HAL_GetTick() for our
+ * timeouts, yet it wakes the core 1000 times a second. UART_Idle_Sleep()
+ * stops the SysTick interrupt, programs the next deadline into LPTIM1
+ * (free-running on the LSE) and sleeps in WFI until that compare match or
+ * any other interrupt, e.g. UART RX. On wake the ticks that passed are read
+ * back from LPTIM1 and added to HAL_GetTick(), so timeouts and the timer
+ * wheel see the correct time.
+ *
+ * The deadline is the earlier of the timer wheel's next event and the
+ * caller's own bound (a blocking read's timeout, a TX flush deadline).
+ * The core uses Sleep mode, not Stop: TIM2 (uart_timebase.h) and USART2
+ * keep their clocks, so RX and microsecond timestamps are unaffected.
+ */
+
+/**** Configuration ****/
+#ifndef UART_IDLE_LPTIM_PRESCALER
+#define UART_IDLE_LPTIM_PRESCALER 16U       // LSE / 16 = 2048 Hz, ~0.5 ms resolution, 32 s range
+#endif
+
+#ifndef UART_IDLE_MIN_SLEEP_MS
+#define UART_IDLE_MIN_SLEEP_MS 2U           // Shorter waits sleep with SysTick left running
+#endif
+
+#ifndef UART_IDLE_MAX_SLEEP_MS
+#define UART_IDLE_MAX_SLEEP_MS 30000U       // Must stay inside the 16-bit LPTIM range
+#endif
+
+#ifndef UART_IDLE_LPTIM_IRQ_PRIORITY
+#define UART_IDLE_LPTIM_IRQ_PRIORITY 3
+#endif
+
+#ifndef UART_IDLE_RATE_WINDOW_MS
+#define UART_IDLE_RATE_WINDOW_MS 1000U      // Shortest window for the wake-up rate
+#endif
+
+#define UART_IDLE_FOREVER UINT32_MAX
+
+/**** Type Definitions ****/
+
+/**
+ * @brief Wake condition, evaluated with interrupts masked just before sleeping
+ * @return true if there is work and the sleep must be skipped
+ */
+typedef bool (*UART_IdleConditionTypeDef)(void);
+
+typedef struct {
+    uint32_t sleeps;                // Tickless sleeps entered
+    uint32_t short_sleeps;          // WFI with SysTick running, deadline under UART_IDLE_MIN_SLEEP_MS
+    uint32_t skipped;               // Condition held or deadline already due
+    uint32_t wakeups_deadline;      // LPTIM1 compare: a deadline was due
+    uint32_t wakeups_other;         // Any other interrupt, e.g. UART RX
+    uint32_t slept_ms;              // Total time with SysTick stopped
+    uint32_t max_sleep_ms;
+    uint32_t window_wakeups;        // Wake-ups in the last completed window
+    uint32_t window_ms;             // Length of that window, at least UART_IDLE_RATE_WINDOW_MS
+    uint32_t wakeups_per_s;         // window_wakeups scaled to one second, rounded down
+} UART_IdleStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Start LPTIM1 free-running on the LSE
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if the LSE is not running
+ * @note Call after SystemClock_Config() (which starts the LSE) and UART_Timer_Init()
+ */
+UART_ErrorTypeDef UART_Idle_Init(void);
+
+/**
+ * @brief Sleep until the next deadline or interrupt, with SysTick stopped
+ * @param max_ms Caller's own deadline in ms from now, or UART_IDLE_FOREVER
+ * @param wake Condition that cancels the sleep, or NULL
+ * @note Returns at once from interrupt context, with interrupts masked, or
+ *       before UART_Idle_Init(). Wakes at the latest when the timer wheel
+ *       next has work, so call UART_Timer_Process() after it returns
+ */
+void UART_Idle_Sleep(uint32_t max_ms, UART_IdleConditionTypeDef wake);
+
+/**
+ * @brief Get tickless idle statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Idle_GetStats(UART_IdleStatsTypeDef *out);
+
+/**
+ * @brief LPTIM1 interrupt handler
+ * @note Call this function from LPTIM1_IRQHandler
+ */
+void UART_Idle_IRQHandler(void);
+
+#endif /* INC_UART_IDLE_H_ */
@@ -0,0 +1,155 @@
+/*
+ * uart_match.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_MATCH_H_
+#define INC_UART_MATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Streaming matcher for line-oriented responses. A pattern is a const
+ * table of ops (literal text, typed captures, wildcards) built by the
+ * macros below, so it sits in flash and costs no RAM or parse time:
+ *
+ *   UART_PATTERN(csq_pattern, OnCsq, NULL,
+ *       UART_MATCH_LIT("+CSQ: "), UART_MATCH_INT(), UART_MATCH_LIT(","),
+ *       UART_MATCH_INT(), UART_MATCH_LIT("\r\n"));
+ *
+ *   UART_PATTERN(qiurc_pattern, OnRecv, NULL,
+ *       UART_MATCH_LIT("+QIURC: \""), UART_MATCH_STR(), UART_MATCH_LIT("\","),
+ *       UART_MATCH_INT(), UART_MATCH_LIT(","), UART_MATCH_INT(), UART_MATCH_LIT("\r"));
+ *
+ * All patterns advance together, one byte at a time, straight off the RX
+ * stream; captures are converted as the digits arrive and the callback
+ * gets typed values, so no line is ever buffered. Patterns are anchored at
+ * the start of a line: a pattern that fails waits for the next '\n'.
+ */
+
+/**** Configuration ****/
+#ifndef UART_MATCH_MAX_PATTERNS
+#define UART_MATCH_MAX_PATTERNS 8
+#endif
+
+#ifndef UART_MATCH_MAX_CAPTURES
+#define UART_MATCH_MAX_CAPTURES 4       // Capture ops per pattern
+#endif
+
+#ifndef UART_MATCH_STR_MAX
+#define UART_MATCH_STR_MAX 16           // String capture size including the terminating NUL
+#endif
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_MATCH_OP_LITERAL = 0,  // Exact text
+    UART_MATCH_OP_INT,          // Signed decimal -> int32_t
+    UART_MATCH_OP_HEX,          // Hex digits -> uint32_t
+    UART_MATCH_OP_STR,          // Bytes up to the next literal's first byte (or end of line) -> string
+    UART_MATCH_OP_ANY,          // Any single byte
+    UART_MATCH_OP_SKIP          // Any bytes up to the following literal, within the line
+} UART_MatchOpKindTypeDef;
+
+typedef struct {
+    uint8_t kind;               // UART_MatchOpKindTypeDef
+    uint8_t len;                // Literal length
+    const char *text;           // Literal text, NULL for other ops
+} UART_MatchOpTypeDef;
+
+typedef struct {
+    uint8_t kind;               // Op that produced the capture
+    union {
+        int32_t i;              // UART_MATCH_OP_INT
+        uint32_t u;             // UART_MATCH_OP_HEX
+        char s[UART_MATCH_STR_MAX]; // UART_MATCH_OP_STR, NUL-terminated
+    } value;
+} UART_MatchCaptureTypeDef;
+
+typedef void (*UART_MatchCallbackTypeDef)(const UART_MatchCaptureTypeDef *captures,
+                                          uint8_t count, void *context);
+
+typedef struct {
+    const UART_MatchOpTypeDef *ops;
+    uint8_t op_count;
+    UART_MatchCallbackTypeDef callback;
+    void *context;
+} UART_PatternTypeDef;
+
+typedef struct {
+    uint8_t op;                 // Current op index
+    uint8_t pos;                // Bytes of the current literal matched, or string length
+    uint8_t skip_op;            // Index of an active wildcard, 0xFF if none
+    uint8_t capture;            // Captures completed
+    uint8_t digits;             // Digits seen in the current number
+    bool negative;
+    bool waiting;               // Failed; idle until the next '\n'
+    UART_MatchCaptureTypeDef captures[UART_MATCH_MAX_CAPTURES];
+} UART_MatchStateTypeDef;
+
+typedef struct {
+    const UART_PatternTypeDef *const *patterns;
+    uint8_t count;
+    uint32_t matches;
+    UART_MatchStateTypeDef states[UART_MATCH_MAX_PATTERNS];
+} UART_MatcherTypeDef;
+
+/**** Convenience Macros ****/
+#define UART_MATCH_LIT(s)   { UART_MATCH_OP_LITERAL, (uint8_t)(sizeof(s) - 1U), (s) }
+#define UART_MATCH_INT()    { UART_MATCH_OP_INT, 0U, NULL }
+#define UART_MATCH_HEX()    { UART_MATCH_OP_HEX, 0U, NULL }
+#define UART_MATCH_STR()    { UART_MATCH_OP_STR, 0U, NULL }
+#define UART_MATCH_ANY()    { UART_MATCH_OP_ANY, 0U, NULL }
+#define UART_MATCH_SKIP()   { UART_MATCH_OP_SKIP, 0U, NULL }
+
+/**
+ * Define a flash-resident pattern: name is a const UART_PatternTypeDef,
+ * the remaining arguments are UART_MATCH_* ops in order
+ */
+#define UART_PATTERN(name, cb, ctx, ...)                                        \
+    static const UART_MatchOpTypeDef name##_ops[] = { __VA_ARGS__ };            \
+    const UART_PatternTypeDef name = {                                          \
+        name##_ops, (uint8_t)(sizeof(name##_ops) / sizeof(name##_ops[0])), (cb), (ctx) \
+    }
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Attach a set of patterns to a matcher
+ * @param matcher Matcher state owned by the caller
+ * @param patterns Array of pattern pointers, may live in flash
+ * @param count Number of patterns, at most UART_MATCH_MAX_PATTERNS
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if a pattern is malformed
+ *         (too many captures, or a wildcard not followed by a literal)
+ */
+UART_ErrorTypeDef UART_Match_Init(UART_MatcherTypeDef *matcher,
+                                  const UART_PatternTypeDef *const *patterns, uint8_t count);
+
+/**
+ * @brief Restart every pattern as if at the start of a line
+ * @param matcher Matcher
+ */
+void UART_Match_Reset(UART_MatcherTypeDef *matcher);
+
+/**
+ * @brief Advance all patterns over a block of bytes
+ * @param matcher Matcher
+ * @param data Bytes
+ * @param len Number of bytes
+ * @note Callbacks run from this call; blocks may be split anywhere
+ */
+void UART_Match_Feed(UART_MatcherTypeDef *matcher, const uint8_t *data, size_t len);
+
+/**
+ * @brief Consume everything in the RX ring and feed it to the matcher
+ * @param matcher Matcher
+ * @return Number of bytes consumed
+ * @note Reads the ring in place through the span API; call from the main loop
+ */
+uint16_t UART_Match_Process(UART_MatcherTypeDef *matcher);
+
+#endif /* INC_UART_MATCH_H_ */
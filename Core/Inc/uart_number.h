@@ -0,0 +1,92 @@
+/*
+ * uart_number.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_NUMBER_H_
+#define INC_UART_NUMBER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Numeric field parsing for NMEA sentences, AT responses and shell
+ * arguments without strtol()/atof(). Digits are classified and converted
+ * four per 32-bit word (eight per two words) with SWAR arithmetic, using
+ * USUB8/SEL for the classification on Cortex-M4. Input is a slice of up
+ * to two parts, so a field that wraps around the end of the RX ring is
+ * parsed in place; results with a fraction are fixed-point with a scale
+ * chosen by the caller.
+ */
+
+/**** Configuration ****/
+#ifndef UART_NUMBER_ENABLE_BENCHMARK
+#define UART_NUMBER_ENABLE_BENCHMARK 0  // 1: build UART_Number_Benchmark() (links strtoul/strtol/strtod)
+#endif
+
+#ifndef UART_NUMBER_MAX_SCALE
+#define UART_NUMBER_MAX_SCALE 9         // Fractional digits a fixed-point result may keep
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t fields;                    // Fields parsed per measurement
+    uint32_t u32_cycles;
+    uint32_t strtoul_cycles;
+    uint32_t i32_cycles;
+    uint32_t strtol_cycles;
+    uint32_t fixed_cycles;              // UART_Number_ParseFixed(), scale 6
+    uint32_t strtod_cycles;             // strtod() followed by scaling to the same fixed point
+} UART_NumberBenchmarkTypeDef;
+
+/**** Convenience Macros ****/
+
+/** Wrap a plain buffer as a single-part slice */
+#define UART_SLICE(buf, n)  { { (const uint8_t *)(buf), NULL }, { (uint16_t)(n), 0U } }
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Parse an unsigned decimal integer
+ * @param slice Input, e.g. from UART_RxPeekSlice()
+ * @param pos Offset of the first digit; advanced past the number on success
+ * @param value Pointer to store the result
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA if there is no digit
+ *         or the value does not fit 32 bits
+ */
+UART_ErrorTypeDef UART_Number_ParseU32(const UART_SliceTypeDef *slice, uint16_t *pos, uint32_t *value);
+
+/**
+ * @brief Parse a signed decimal integer with optional '+' or '-'
+ * @param slice Input
+ * @param pos Offset of the sign or first digit; advanced past the number on success
+ * @param value Pointer to store the result
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Number_ParseI32(const UART_SliceTypeDef *slice, uint16_t *pos, int32_t *value);
+
+/**
+ * @brief Parse a decimal number with optional sign and fraction into fixed point
+ * @param slice Input
+ * @param pos Offset of the sign or first digit; advanced past the number on success
+ * @param scale Fractional digits to keep, 0 .. UART_NUMBER_MAX_SCALE
+ * @param value Pointer to store the number times 10^scale; extra fraction digits are truncated
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA if there is no digit
+ *         or the scaled value does not fit 32 bits
+ * @note "4807.038" with scale 3 gives 4807038; ".5" and "12." are accepted
+ */
+UART_ErrorTypeDef UART_Number_ParseFixed(const UART_SliceTypeDef *slice, uint16_t *pos,
+                                         uint8_t scale, int32_t *value);
+
+/**
+ * @brief Time the SWAR parsers against newlib on the same fields
+ * @param result Pointer to store DWT cycle counts
+ * @note Requires UART_NUMBER_ENABLE_BENCHMARK and UART_Timebase_Init() (DWT)
+ */
+void UART_Number_Benchmark(UART_NumberBenchmarkTypeDef *result);
+
+#endif /* INC_UART_NUMBER_H_ */
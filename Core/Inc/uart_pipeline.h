@@ -0,0 +1,195 @@
+/*
+ * uart_pipeline.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_PIPELINE_H_
+#define INC_UART_PIPELINE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+#include "uart_frame.h"
+
+/*
+ * Staged frame processing. Stages are connected by bounded SPSC queues of
+ * frame descriptors and run one item at a time from the main loop,
+ * highest priority first, so a slow handler delays only its own queue
+ * instead of reception. A stage runs only when its input holds an item
+ * and its output has room; a full output is counted as backpressure on
+ * that stage, which points straight at the bottleneck downstream.
+ *
+ *   UART_PIPELINE_QUEUE_DEFINE(cmd_queue, 4);
+ *   UART_PIPELINE_QUEUE_DEFINE(reply_queue, 4);
+ *
+ *   UART_Pipeline_AddStage(&tx,    "tx",    0, UART_Pipeline_TxStage,    &reply_queue, NULL);
+ *   UART_Pipeline_AddStage(&cmd,   "cmd",   1, HandleCommand,            &cmd_queue,   &reply_queue);
+ *   UART_Pipeline_AddStage(&parse, "parse", 2, UART_Pipeline_ParseStage, NULL,         &cmd_queue);
+ *   UART_Pipeline_AttachFrames(UART_FRAME_TYPE_CMD_REQ);
+ *
+ *   while (1) { UART_Pipeline_Run(); ... }
+ *
+ * Downstream stages get the higher priority so the pipeline drains
+ * before it takes in more work.
+ */
+
+/**** Configuration ****/
+#ifndef UART_PIPELINE_BUFFERS
+#define UART_PIPELINE_BUFFERS 8U                // Payload buffers shared by all queues, at most 32
+#endif
+
+#ifndef UART_PIPELINE_BUFFER_SIZE
+#define UART_PIPELINE_BUFFER_SIZE UART_FRAME_MAX_PAYLOAD
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint8_t *buf;               // Pool buffer of UART_PIPELINE_BUFFER_SIZE bytes, or NULL
+    uint16_t len;
+    uint8_t type;               // Frame type
+    uint32_t timestamp;         // UART_TIME_CYCLES() when the item entered the pipeline
+} UART_PipelineDescTypeDef;
+
+typedef struct {
+    UART_PipelineDescTypeDef *slots;
+    uint8_t capacity;           // Power of two, at most 128
+    volatile uint8_t head;      // Free-running, written by the producer only
+    volatile uint8_t tail;      // Free-running, written by the consumer only
+    uint8_t high_water;
+} UART_PipelineQueueTypeDef;
+
+typedef enum {
+    UART_PIPELINE_IDLE = 0,     // Source had nothing to do
+    UART_PIPELINE_CONSUMED,     // Input finished, nothing emitted
+    UART_PIPELINE_FORWARD,      // Input finished, out filled and published
+    UART_PIPELINE_RETRY         // Input kept, e.g. TX ring too full
+} UART_PipelineResultTypeDef;
+
+/**
+ * @brief Stage function
+ * @param in Item at the head of the input queue, NULL for a source stage
+ * @param out Free slot of the output queue, NULL for a sink stage
+ * @return What happened to in and out
+ * @note Ownership of in->buf ends with CONSUMED or FORWARD; it is released
+ *       unless the stage passed the same buffer on in out->buf
+ */
+typedef UART_PipelineResultTypeDef (*UART_PipelineStageFnTypeDef)(UART_PipelineDescTypeDef *in,
+                                                                  UART_PipelineDescTypeDef *out);
+
+typedef struct {
+    uint32_t runs;              // Items processed
+    uint32_t retries;
+    uint32_t blocked;           // Scheduling passes skipped because the output queue was full
+    uint32_t cycles_total;      // Service time, DWT cycles
+    uint32_t cycles_max;
+    uint32_t latency_max;       // Pipeline entry to leaving this stage, DWT cycles
+    uint8_t depth;              // Input queue items now
+    uint8_t high_water;         // Input queue items at most
+    uint8_t capacity;
+} UART_PipelineStageStatsTypeDef;
+
+typedef struct UART_PipelineStage {
+    struct UART_PipelineStage *next;
+    const char *name;
+    UART_PipelineStageFnTypeDef fn;
+    UART_PipelineQueueTypeDef *in;      // NULL: source stage
+    UART_PipelineQueueTypeDef *out;     // NULL: sink stage
+    uint8_t priority;                   // 0 runs first
+    UART_PipelineStageStatsTypeDef stats;
+} UART_PipelineStageTypeDef;
+
+typedef struct {
+    uint32_t ingress_frames;
+    uint32_t ingress_drops;     // Frame too large for a buffer, or arrived outside the parse stage
+    uint32_t parse_stalls;      // Parse stage runs skipped with RX data waiting and the pool empty
+    uint8_t buffers_free;
+    uint8_t buffers_min_free;
+} UART_PipelineStatsTypeDef;
+
+/**** Convenience Macros ****/
+
+/** Define a queue with static slot storage */
+#define UART_PIPELINE_QUEUE_DEFINE(name, depth)                                         \
+    _Static_assert((depth) > 0 && (depth) <= 128 && ((depth) & ((depth) - 1)) == 0,     \
+                   #name " depth must be a power of two up to 128");                    \
+    static UART_PipelineDescTypeDef name##_slots[depth];                                \
+    static UART_PipelineQueueTypeDef name = { name##_slots, (depth), 0, 0, 0 }
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Forget all stages and return every buffer to the pool
+ */
+void UART_Pipeline_Init(void);
+
+/**
+ * @brief Add a stage to the schedule
+ * @param stage Stage object owned by the caller
+ * @param name Name for diagnostics
+ * @param priority 0 runs first; equal priorities run in the order added
+ * @param fn Stage function
+ * @param in Input queue, NULL for a source stage
+ * @param out Output queue, NULL for a sink stage
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ */
+UART_ErrorTypeDef UART_Pipeline_AddStage(UART_PipelineStageTypeDef *stage, const char *name, uint8_t priority,
+                                         UART_PipelineStageFnTypeDef fn,
+                                         UART_PipelineQueueTypeDef *in, UART_PipelineQueueTypeDef *out);
+
+/**
+ * @brief Run the highest-priority stage that has work, once
+ * @return true if a stage did work, false if the pipeline is idle
+ * @note Call from the main loop; one item per call keeps the loop responsive
+ */
+bool UART_Pipeline_Run(void);
+
+/**
+ * @brief Route a frame type into UART_Pipeline_ParseStage()
+ * @param type Frame type
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Pipeline_AttachFrames(uint8_t type);
+
+/**
+ * @brief Take a payload buffer from the pool
+ * @return Buffer of UART_PIPELINE_BUFFER_SIZE bytes, NULL if the pool is empty
+ */
+uint8_t *UART_Pipeline_AllocBuffer(void);
+
+/**
+ * @brief Return a payload buffer to the pool
+ * @param buf Buffer from UART_Pipeline_AllocBuffer(), NULL is ignored
+ */
+void UART_Pipeline_FreeBuffer(uint8_t *buf);
+
+/**
+ * @brief Source stage: parse RX bytes into one frame descriptor
+ * @note Frames of attached types are copied into a pool buffer and forwarded;
+ *       other types go to their frame handlers as before. While the pool is
+ *       empty nothing is parsed, so RX data waits in the ring instead of being dropped
+ */
+UART_PipelineResultTypeDef UART_Pipeline_ParseStage(UART_PipelineDescTypeDef *in, UART_PipelineDescTypeDef *out);
+
+/**
+ * @brief Sink stage: send the descriptor as a frame
+ * @note Retries while the TX ring cannot take the whole frame, so it never blocks
+ */
+UART_PipelineResultTypeDef UART_Pipeline_TxStage(UART_PipelineDescTypeDef *in, UART_PipelineDescTypeDef *out);
+
+/**
+ * @brief Get a stage's metrics
+ * @param stage Stage
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Pipeline_GetStageStats(const UART_PipelineStageTypeDef *stage, UART_PipelineStageStatsTypeDef *out);
+
+/**
+ * @brief Get ingress and buffer pool statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Pipeline_GetStats(UART_PipelineStatsTypeDef *out);
+
+#endif /* INC_UART_PIPELINE_H_ */
@@ -0,0 +1,89 @@
+/*
+ * uart_poll.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_POLL_H_
+#define INC_UART_POLL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Readiness set shared by all UART ports. Each port's ISR marks itself
+ * readable (RX count >= threshold) or writable (TX free >= threshold) in
+ * one bitmask, so a super-loop waits on every port with a single call and
+ * only visits the ports that are actually ready.
+ */
+
+/**** Configuration ****/
+#ifndef UART_POLL_RX_THRESHOLD
+#define UART_POLL_RX_THRESHOLD 1U
+#endif
+
+#ifndef UART_POLL_TX_THRESHOLD
+#define UART_POLL_TX_THRESHOLD (UART_BUFFER_SIZE / 4U)
+#endif
+
+#define UART_POLL_MAX_PORTS 16U
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_PORT_USART2 = 0,   // The ring-buffer driver instance (huart2)
+    UART_PORT_COUNT
+} UART_PortTypeDef;
+
+/**** Convenience Macros ****/
+#define UART_POLL_READABLE(port)  (1UL << (port))
+#define UART_POLL_WRITABLE(port)  (1UL << (UART_POLL_MAX_PORTS + (port)))
+#define UART_POLL_FOREVER         UINT64_MAX
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Wait until any of the requested events is ready
+ * @param mask Events of interest (UART_POLL_READABLE / UART_POLL_WRITABLE bits)
+ * @param deadline_us Absolute deadline on the UART_Time_Us() clock, or UART_POLL_FOREVER
+ * @return Ready events within mask, 0 if the deadline passed first
+ * @note Sleeps in WFI between interrupts; a TIM2 compare (UART_Time_ArmWakeup()) ends the
+ *       sleep at the deadline
+ */
+uint32_t UART_PollSet(uint32_t mask, uint64_t deadline_us);
+
+/**
+ * @brief Mark events ready
+ * @param events Event bits
+ * @note Called by port ISRs, safe from any context
+ */
+void UART_Poll_SetReady(uint32_t events);
+
+/**
+ * @brief Mark events not ready
+ * @param events Event bits
+ * @note Safe from any context
+ */
+void UART_Poll_ClearReady(uint32_t events);
+
+/**
+ * @brief Snapshot of the ready set without waiting
+ * @return Ready event bits
+ */
+uint32_t UART_Poll_Ready(void);
+
+/**
+ * @brief Pop the lowest event bit from a ready mask
+ * @param events Ready mask, the returned bit is cleared
+ * @return Bit index (port for readable, UART_POLL_MAX_PORTS + port for writable)
+ * @note Iterating a PollSet result this way costs O(ready events)
+ */
+static inline uint32_t UART_Poll_TakeNext(uint32_t *events)
+{
+    uint32_t bit = (uint32_t)__builtin_ctz(*events);
+    *events &= *events - 1U;
+    return bit;
+}
+
+#endif /* INC_UART_POLL_H_ */
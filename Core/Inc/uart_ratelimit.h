@@ -0,0 +1,106 @@
+/*
+ * uart_ratelimit.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_RATELIMIT_H_
+#define INC_UART_RATELIMIT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Token-bucket limits for non-critical TX producers (logging, debug dumps).
+ * Each producer earns rate_bps bytes per second up to a burst of burst_bytes.
+ * A write that finds too few tokens is dropped, or with DEFER parked in the
+ * producer's own backlog and trickled out by UART_RateLimit_Process().
+ * Limited producers also leave UART_RATELIMIT_TX_HEADROOM bytes of the TX
+ * ring untouched, so critical traffic through UART_WriteChar() never waits
+ * behind them.
+ */
+
+/**** Configuration ****/
+#ifndef UART_RATELIMIT_TX_HEADROOM
+#define UART_RATELIMIT_TX_HEADROOM (UART_BUFFER_SIZE / 4U)
+#endif
+
+/**** Type Definitions ****/
+typedef enum {
+    UART_RATE_POLICY_DROP = 0,      // Over-limit writes are discarded whole
+    UART_RATE_POLICY_DEFER          // Over-limit writes wait in the producer backlog
+} UART_RatePolicyTypeDef;
+
+typedef struct {
+    uint32_t bytes_sent;            // Bytes handed to the TX ring
+    uint32_t bytes_dropped;
+    uint32_t writes_dropped;
+    uint32_t bytes_deferred;        // Bytes that went through the backlog
+    uint16_t backlog_peak;
+} UART_RateLimitStatsTypeDef;
+
+typedef struct UART_RateLimiter {
+    struct UART_RateLimiter *next;
+    uint32_t rate_bps;              // Bytes per second
+    uint32_t burst_bytes;           // Bucket depth
+    uint64_t tokens;                // Bytes scaled by 1e6, so refills keep sub-byte credit
+    uint64_t last_refill_us;
+    UART_RatePolicyTypeDef policy;
+    uint8_t *backlog;               // DEFER storage owned by the caller
+    uint16_t backlog_size;
+    uint16_t backlog_head;
+    uint16_t backlog_count;
+    UART_RateLimitStatsTypeDef stats;
+} UART_RateLimiterTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Set up a producer and register it for UART_RateLimit_Process()
+ * @param limiter Producer state owned by the caller
+ * @param rate_bps Sustained rate in bytes per second
+ * @param burst_bytes Bucket depth, also the largest single write that can pass
+ * @param policy What to do with over-limit writes
+ * @param backlog Backlog storage for UART_RATE_POLICY_DEFER, NULL for DROP
+ * @param backlog_size Size of backlog in bytes
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ * @note The bucket starts full
+ */
+UART_ErrorTypeDef UART_RateLimit_Init(UART_RateLimiterTypeDef *limiter, uint32_t rate_bps, uint32_t burst_bytes,
+                                      UART_RatePolicyTypeDef policy, uint8_t *backlog, uint16_t backlog_size);
+
+/**
+ * @brief Write a message on behalf of a producer
+ * @param limiter Producer
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS if sent or deferred, UART_ERROR_RATE_LIMITED if dropped
+ * @note Messages are never split between send and drop; call from thread context only
+ */
+UART_ErrorTypeDef UART_RateLimit_Write(UART_RateLimiterTypeDef *limiter, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Write a null-terminated string on behalf of a producer
+ * @param limiter Producer
+ * @param str String to send
+ * @return UART_SUCCESS if sent or deferred, UART_ERROR_RATE_LIMITED if dropped
+ */
+UART_ErrorTypeDef UART_RateLimit_SendString(UART_RateLimiterTypeDef *limiter, const char *str);
+
+/**
+ * @brief Move deferred bytes into the TX ring as tokens and ring space allow
+ * @note Call this from the main loop
+ */
+void UART_RateLimit_Process(void);
+
+/**
+ * @brief Get a producer's counters
+ * @param limiter Producer
+ * @param stats Destination for a copy of the counters
+ */
+void UART_RateLimit_GetStats(const UART_RateLimiterTypeDef *limiter, UART_RateLimitStatsTypeDef *stats);
+
+#endif /* INC_UART_RATELIMIT_H_ */
@@ -18,6 +18,78 @@
 #define UART_BUFFER_SIZE 1024
 #endif
 
+#ifndef UART_USE_US_TIMEBASE
+#define UART_USE_US_TIMEBASE 0  // 1: driver timeouts use the microsecond timebase
+#endif
+
+#ifndef UART_ENABLE_SCHED_TX
+#define UART_ENABLE_SCHED_TX 0  // 1: time-triggered frames (uart_sched_tx.h) bypass the TX ring
+#endif
+
+#ifndef UART_ELASTIC_RINGS
+#define UART_ELASTIC_RINGS 0    // 1: RX/TX grow and shrink from a shared segment pool (uart_ring_pool.h)
+#endif
+
+#ifndef UART_ENABLE_POLL
+#define UART_ENABLE_POLL 0      // 1: ISR publishes readable/writable state to uart_poll.h
+#endif
+
+#ifndef UART_ENABLE_THRESHOLDS
+#define UART_ENABLE_THRESHOLDS 0 // 1: ISR calls back when RX/TX cross a configured fill level
+#endif
+
+#ifndef UART_ENABLE_CLOCK_GOVERNOR
+#define UART_ENABLE_CLOCK_GOVERNOR 0 // 1: byte counters for uart_clock_gov.h, main() starts the governor
+#endif
+
+#ifndef UART_ENABLE_HALF_DUPLEX
+#define UART_ENABLE_HALF_DUPLEX 0 // 1: single-wire mode (uart_half_duplex.h), ISR drops our own echo
+#endif
+
+#ifndef UART_USE_FREERTOS
+#define UART_USE_FREERTOS 0     // 1: blocking calls sleep on task notifications (uart_rtos.h)
+#endif
+
+#ifndef UART_ENABLE_TIMESTAMPS
+#define UART_ENABLE_TIMESTAMPS 0 // 1: ISR-level RX marker and TX position timestamps
+#endif
+
+#ifndef UART_FAST_BOOT
+#define UART_FAST_BOOT 0        // 1: main() brings USART2 up with LL writes before HAL_Init() (uart_boot.h)
+#endif
+
+#ifndef UART_BOOT_PROFILE
+#define UART_BOOT_PROFILE 0     // 1: record reset-to-first-TX/RX-ready times (uart_boot.h)
+#endif
+
+#ifndef UART_ENABLE_TICKLESS_IDLE
+#define UART_ENABLE_TICKLESS_IDLE 0 // 1: idle and blocking waits sleep with SysTick stopped, LPTIM1 wakes (uart_idle.h)
+#endif
+
+#ifndef UART_ENABLE_ISR_PROFILE
+#define UART_ENABLE_ISR_PROFILE 0 // 1: ISR records DWT cycles per path (RX, TX, error) and its deepest entry stack
+#endif
+
+#ifndef UART_ENABLE_STACK_MONITOR
+#define UART_ENABLE_STACK_MONITOR 0 // 1: main() paints the stack for the high-water mark (uart_stack.h)
+#endif
+
+#ifndef UART_ENABLE_BENCHMARK
+#define UART_ENABLE_BENCHMARK 0 // 1: main() runs the sink/source/echo benchmark (uart_bench.h) instead of the echo loop
+#endif
+
+#ifndef UART_ENABLE_ISR_BENCHMARK
+#define UART_ENABLE_ISR_BENCHMARK 0 // 1: build UART_BenchmarkIsr(), per-path ISR cycles of this build's feature set
+#endif
+
+#ifndef UART_TIMESTAMP_MARKER
+#define UART_TIMESTAMP_MARKER 0x7E  // RX bytes with this value get timestamped
+#endif
+
+#ifndef UART_RX_TIMESTAMP_DEPTH
+#define UART_RX_TIMESTAMP_DEPTH 8   // Power of two
+#endif
+
 /**** Type Definitions ****/
 typedef enum {
     UART_SUCCESS = 0,
@@ -25,7 +97,10 @@ typedef enum {
     UART_ERROR_BUFFER_FULL = -2,
     UART_ERROR_BUFFER_EMPTY = -3,
     UART_ERROR_INVALID_PARAM = -4,
-    UART_ERROR_NOT_FOUND = -5
+    UART_ERROR_NOT_FOUND = -5,
+    UART_ERROR_BUSY = -6,
+    UART_ERROR_RATE_LIMITED = -7,
+    UART_ERROR_INVALID_DATA = -8
 } UART_ErrorTypeDef;
 
 typedef struct {
@@ -34,6 +109,54 @@ typedef struct {
     volatile uint16_t tail;
 } RingBuffer_TypeDef;
 
+typedef enum {
+    UART_RX_EVENT_THRESHOLD = 0,    // RX holds at least the configured byte count
+    UART_RX_EVENT_IDLE              // Line went idle with a partial batch buffered
+} UART_RxEventTypeDef;
+
+typedef struct {
+    uint32_t rx_threshold_events;
+    uint32_t rx_idle_events;
+    uint32_t tx_threshold_events;
+} UART_ThresholdStatsTypeDef;
+
+typedef enum {
+    UART_ISR_PATH_RX = 0,           // RXNE, and the receiver-timeout event with thresholds
+    UART_ISR_PATH_TX,               // TXE: next byte or TX interrupt shut off
+    UART_ISR_PATH_ERROR,            // Overrun, framing, noise or parity flag cleared
+    UART_ISR_PATH_COUNT
+} UART_IsrPathTypeDef;
+
+typedef struct {
+    uint32_t count;
+    uint32_t cycles_max;            // DWT cycles, worst single pass
+    uint64_t cycles_total;
+} UART_IsrPathStatsTypeDef;
+
+typedef struct {
+    UART_IsrPathStatsTypeDef path[UART_ISR_PATH_COUNT];
+    uint32_t handler_cycles_max;    // Whole UART_ISR_Handler() call, all paths it took
+    uint32_t entry_sp_min;          // Lowest MSP seen on entry (deepest nesting)
+    uint32_t overrun_errors;        // Counted without UART_ENABLE_ISR_PROFILE too
+    uint32_t framing_errors;
+    uint32_t noise_errors;
+    uint32_t parity_errors;
+} UART_IsrProfileTypeDef;
+
+typedef struct {
+    uint32_t features;              // UART_ISR_FEATURES of the build that was measured
+    uint32_t idle_cycles;           // No flag pending: entry, flag reads and exit
+    uint32_t rx_cycles;             // One byte stored in RX, mean of several passes
+    uint32_t tx_cycles;             // One byte taken from TX and sent, mean
+    uint32_t tx_empty_cycles;       // TX ring empty, TX interrupt shut off
+    uint32_t error_cycles;          // Overrun cleared and counted
+} UART_IsrBenchmarkTypeDef;
+
+typedef struct {
+    const uint8_t *part[2];     // Ring data in order; part[1] is the wrapped-around remainder
+    uint16_t len[2];
+} UART_SliceTypeDef;
+
 /**** Function Prototypes ****/
 
 /**
@@ -42,6 +165,14 @@ typedef struct {
  */
 UART_ErrorTypeDef UART_RingBuff_Init(void);
 
+/**
+ * @brief Select the USART kernel clock and reprogram BRR, keeping every other USART setting
+ * @param clock_source RCC_USART2CLKSOURCE_x, __HAL_RCC_GET_USART2_SOURCE() to keep the current one
+ * @param baud New baud rate
+ * @note Call with TX idle; the receiver is off for a few cycles and a byte arriving then is lost
+ */
+void UART_SetBaudRate(uint32_t clock_source, uint32_t baud);
+
 /**
  * @brief Read a single character from RX buffer
  * @param c Pointer to store the character
@@ -69,6 +200,83 @@ UART_ErrorTypeDef UART_SendString(const char *str);
  */
 uint16_t UART_Available(void);
 
+/**
+ * @brief Check whether the RX buffer holds any data
+ * @return true if at least one byte can be read
+ * @note Matches the UART_Idle_Sleep() wake condition signature
+ */
+bool UART_RxPending(void);
+
+/**
+ * @brief Check free space in TX buffer
+ * @return Number of bytes that can be written without waiting
+ */
+uint16_t UART_TxFree(void);
+
+/**
+ * @brief Get the number of bytes moved by the ISR since initialization
+ * @param rx_bytes Pointer to store the received byte count, may be NULL
+ * @param tx_bytes Pointer to store the transmitted byte count, may be NULL
+ * @note Requires UART_ENABLE_CLOCK_GOVERNOR, reports 0 otherwise; counters wrap
+ */
+void UART_GetByteCounts(uint32_t *rx_bytes, uint32_t *tx_bytes);
+
+/**
+ * @brief Get the contiguous free span at the TX write position
+ * @param span Pointer to store the span start
+ * @return Bytes that can be written to the span, 0 if TX is full
+ * @note Zero-copy write: fill the span, then publish it with UART_TxCommit()
+ */
+uint16_t UART_TxReserve(uint8_t **span);
+
+/**
+ * @brief Publish bytes written into a span from UART_TxReserve() and start sending
+ * @param len Bytes written, at most the reserved length
+ */
+void UART_TxCommit(uint16_t len);
+
+/**
+ * @brief Get the contiguous run of received data at the RX read position
+ * @param span Pointer to store the span start
+ * @return Bytes readable from the span, 0 if RX is empty
+ * @note Zero-copy read: parse the span, then release it with UART_RxConsume()
+ */
+uint16_t UART_RxPeekSpan(const uint8_t **span);
+
+/**
+ * @brief Get all received data at the RX read position, in up to two parts
+ * @param slice Pointer to store the parts
+ * @return Bytes readable from the slice, 0 if RX is empty
+ * @note With UART_ELASTIC_RINGS the slice ends at the current segment boundary
+ */
+uint16_t UART_RxPeekSlice(UART_SliceTypeDef *slice);
+
+/**
+ * @brief Release bytes at the RX read position
+ * @param len Bytes consumed, at most the peeked length
+ */
+void UART_RxConsume(uint16_t len);
+
+/**
+ * @brief Copy received data out of the RX buffer
+ * @param data Destination
+ * @param len Largest number of bytes to read
+ * @return Bytes read, 0 if RX is empty; never waits
+ */
+uint16_t UART_ReadBlock(uint8_t *data, uint16_t len);
+
+/**
+ * @brief Copy data into the TX buffer and start sending
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return Bytes queued, fewer than len if TX filled up; never waits
+ * @note Does not mark a message boundary, the block may be part of a larger message
+ *       (UART_Frame_Send() writes its payload this way). With UART_ENABLE_SCHED_TX, call
+ *       UART_TxMarkBoundary() once a whole message is queued so a scheduled frame is not
+ *       placed inside it
+ */
+uint16_t UART_WriteBlock(const uint8_t *data, uint16_t len);
+
 /**
  * @brief Peek at next character without removing it from buffer
  * @param c Pointer to store the character
@@ -111,6 +319,122 @@ UART_ErrorTypeDef UART_CopyUntil(const char *end_str, char *buffer, size_t buffe
 UART_ErrorTypeDef UART_ExtractBetween(const char *start_str, const char *end_str,
                                   const char *source, char *dest, size_t dest_size);
 
+/**
+ * @brief Get the receive time of the marker byte last returned by UART_ReadChar()
+ * @param timestamp_us Pointer to store the UART_TIME_US32() value latched by the ISR
+ * @return UART_SUCCESS on success, UART_ERROR_NOT_FOUND if no valid timestamp
+ * @note Requires UART_ENABLE_TIMESTAMPS; valid until the next marker byte is read
+ */
+UART_ErrorTypeDef UART_GetRxMarkerTimestamp(uint32_t *timestamp_us);
+
+/**
+ * @brief Timestamp the next byte written to the TX buffer when the ISR sends it
+ * @note Requires UART_ENABLE_TIMESTAMPS; one request outstanding at a time
+ */
+void UART_RequestTxTimestamp(void);
+
+/**
+ * @brief Get the send time of the byte selected by UART_RequestTxTimestamp()
+ * @param timestamp_us Pointer to store the UART_TIME_US32() value latched by the ISR
+ * @return UART_SUCCESS on success, UART_ERROR_NOT_FOUND if not sent yet
+ */
+UART_ErrorTypeDef UART_GetTxTimestamp(uint32_t *timestamp_us);
+
+/**
+ * @brief Mark the end of a complete message in the TX buffer
+ * @note Requires UART_ENABLE_SCHED_TX. UART_Frame_Send()/UART_Frame_Commit() and
+ *       UART_SendString() mark their own messages; other writers should call this after
+ *       each message. Without a mark ahead of ring TX, a hold stops after whatever is
+ *       queued at that moment, which may split a message still being written
+ */
+void UART_TxMarkBoundary(void);
+
+/**
+ * @brief Stop sending from the TX buffer at the next message boundary
+ * @note Requires UART_ENABLE_SCHED_TX; used by the scheduled-TX module ahead of a slot
+ */
+void UART_TxHold(void);
+
+/**
+ * @brief Resume sending from the TX buffer after UART_TxHold()
+ */
+void UART_TxRelease(void);
+
+/**
+ * @brief Hand the line to the scheduled frame once the held TX buffer is idle
+ * @return true if the line was already idle, false if the start waits for ring TX or TC
+ * @note The first byte is sent from the TC interrupt through the common per-byte path
+ */
+bool UART_TxStartScheduled(void);
+
+/**
+ * @brief Configure the RX notification
+ * @param bytes Notify once at least this many bytes are buffered, 0 to disable
+ * @param idle_us Notify when the line has been idle this long with data buffered, 0 to disable
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if out of range
+ * @note Requires UART_ENABLE_THRESHOLDS. Fires UART_RxThresholdCallback() once, then re-arms
+ *       when reads bring RX back below the threshold. bytes is limited to the ring
+ *       capacity: UART_BUFFER_SIZE - 1, or max segments x UART_POOL_SEGMENT_SIZE with
+ *       UART_ELASTIC_RINGS.
+ */
+UART_ErrorTypeDef UART_SetRxThreshold(uint16_t bytes, uint32_t idle_us);
+
+/**
+ * @brief Configure the TX notification
+ * @param free_bytes Notify once at least this many bytes are free, 0 to disable
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if out of range
+ * @note Requires UART_ENABLE_THRESHOLDS. Fires UART_TxThresholdCallback() once, then re-arms
+ *       when writes bring free space back below the threshold. Limited to the ring
+ *       capacity, as for UART_SetRxThreshold().
+ */
+UART_ErrorTypeDef UART_SetTxThreshold(uint16_t free_bytes);
+
+/**
+ * @brief Get threshold notification counters
+ * @param stats Destination for a snapshot of the counters
+ */
+void UART_GetThresholdStats(UART_ThresholdStatsTypeDef *stats);
+
+/**
+ * @brief Get the ISR cycle profile and line error counters
+ * @param profile Destination for a snapshot
+ * @note Cycle figures require UART_ENABLE_ISR_PROFILE and a running DWT
+ *       (UART_Timebase_Init()); they read 0 otherwise
+ */
+void UART_GetIsrProfile(UART_IsrProfileTypeDef *profile);
+
+/**
+ * @brief Restart the ISR cycle profile, e.g. before a load test
+ * @note Line error counters are kept
+ */
+void UART_ResetIsrProfile(void);
+
+/**
+ * @brief Time each ISR path of this build on a RAM image of the USART registers
+ * @param result Pointer to store DWT cycle counts and the feature set
+ * @return UART_SUCCESS on success, UART_ERROR_BUSY if a ring holds data or TX is running
+ * @note Requires UART_ENABLE_ISR_BENCHMARK and UART_Timebase_Init() (DWT). Runs only
+ *       with both rings empty and leaves driver state as it found it. Feature hooks run
+ *       with their notifications parked (RTOS waiters, threshold callbacks, echo
+ *       tracking), so each is timed on its idle path
+ */
+UART_ErrorTypeDef UART_BenchmarkIsr(UART_IsrBenchmarkTypeDef *result);
+
+/**
+ * @brief RX notification, called from the UART ISR
+ * @param event What triggered the notification
+ * @param available Bytes buffered in RX
+ * @note Weak default does nothing, override in the application
+ */
+void UART_RxThresholdCallback(UART_RxEventTypeDef event, uint16_t available);
+
+/**
+ * @brief TX notification, called from the UART ISR
+ * @param free_bytes Bytes free in TX
+ * @note Weak default does nothing, override in the application
+ */
+void UART_TxThresholdCallback(uint16_t free_bytes);
+
 /**
  * @brief UART interrupt service routine handler
  * @note Call this function from your UART interrupt handler
@@ -121,4 +445,28 @@ void UART_ISR_Handler(UART_HandleTypeDef *huart);
 /**** Convenience Macros ****/
 #define UART_DEFAULT_TIMEOUT 500
 
+// Features compiled into UART_ISR_Handler(); the ISR holds only their hooks
+#define UART_ISR_FEATURE_ELASTIC_RINGS  (1UL << 0)
+#define UART_ISR_FEATURE_BYTE_COUNTS    (1UL << 1)  // UART_ENABLE_CLOCK_GOVERNOR
+#define UART_ISR_FEATURE_HALF_DUPLEX    (1UL << 2)
+#define UART_ISR_FEATURE_TIMESTAMPS     (1UL << 3)
+#define UART_ISR_FEATURE_POLL           (1UL << 4)
+#define UART_ISR_FEATURE_THRESHOLDS     (1UL << 5)
+#define UART_ISR_FEATURE_SCHED_TX       (1UL << 6)
+#define UART_ISR_FEATURE_RTOS           (1UL << 7)
+#define UART_ISR_FEATURE_BOOT_PROFILE   (1UL << 8)
+#define UART_ISR_FEATURE_PROFILE        (1UL << 9)  // UART_ENABLE_ISR_PROFILE
+
+#define UART_ISR_FEATURES ( \
+    (UART_ELASTIC_RINGS          ? UART_ISR_FEATURE_ELASTIC_RINGS : 0UL) | \
+    (UART_ENABLE_CLOCK_GOVERNOR  ? UART_ISR_FEATURE_BYTE_COUNTS   : 0UL) | \
+    (UART_ENABLE_HALF_DUPLEX     ? UART_ISR_FEATURE_HALF_DUPLEX   : 0UL) | \
+    (UART_ENABLE_TIMESTAMPS      ? UART_ISR_FEATURE_TIMESTAMPS    : 0UL) | \
+    (UART_ENABLE_POLL            ? UART_ISR_FEATURE_POLL          : 0UL) | \
+    (UART_ENABLE_THRESHOLDS      ? UART_ISR_FEATURE_THRESHOLDS    : 0UL) | \
+    (UART_ENABLE_SCHED_TX        ? UART_ISR_FEATURE_SCHED_TX      : 0UL) | \
+    (UART_USE_FREERTOS           ? UART_ISR_FEATURE_RTOS          : 0UL) | \
+    (UART_BOOT_PROFILE           ? UART_ISR_FEATURE_BOOT_PROFILE  : 0UL) | \
+    (UART_ENABLE_ISR_PROFILE     ? UART_ISR_FEATURE_PROFILE       : 0UL))
+
 #endif /* INC_UART_RING_BUFFER_H_ */
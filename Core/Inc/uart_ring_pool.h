@@ -0,0 +1,183 @@
+/*
+ * uart_ring_pool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_RING_POOL_H_
+#define INC_UART_RING_POOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/*
+ * Elastic rings (UART_ELASTIC_RINGS = 1): RX and TX are chains of fixed-size
+ * segments drawn from one shared pool. A ring grows when its writer runs off
+ * the end of its last segment and shrinks when its reader leaves a segment.
+ * Each ring may hold at most max_segments, and min_segments are kept in
+ * reserve for it so a burst on the other ring cannot starve it.
+ */
+
+/**** Configuration ****/
+#ifndef UART_POOL_SEGMENT_SIZE
+#define UART_POOL_SEGMENT_SIZE 64
+#endif
+
+#ifndef UART_POOL_SEGMENTS
+#define UART_POOL_SEGMENTS ((2 * UART_BUFFER_SIZE) / UART_POOL_SEGMENT_SIZE)  // Same RAM as two fixed rings
+#endif
+
+#ifndef UART_POOL_RX_MIN_SEGMENTS
+#define UART_POOL_RX_MIN_SEGMENTS 4
+#endif
+
+#ifndef UART_POOL_RX_MAX_SEGMENTS
+#define UART_POOL_RX_MAX_SEGMENTS (UART_POOL_SEGMENTS - UART_POOL_TX_MIN_SEGMENTS)
+#endif
+
+#ifndef UART_POOL_TX_MIN_SEGMENTS
+#define UART_POOL_TX_MIN_SEGMENTS 2
+#endif
+
+#ifndef UART_POOL_TX_MAX_SEGMENTS
+#define UART_POOL_TX_MAX_SEGMENTS (UART_POOL_SEGMENTS - UART_POOL_RX_MIN_SEGMENTS)
+#endif
+
+#define UART_POOL_NO_SEGMENT 0xFFU
+
+#if UART_POOL_SEGMENTS >= UART_POOL_NO_SEGMENT
+#error "UART_POOL_SEGMENTS must be below 255"
+#endif
+
+#if UART_POOL_SEGMENT_SIZE > 255
+#error "UART_POOL_SEGMENT_SIZE must fit the 8-bit segment offsets"
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    volatile uint32_t written;      // Bytes ever written (writer side only)
+    volatile uint32_t read;         // Bytes ever read (reader side only)
+    volatile uint8_t head_seg;      // Segment being written
+    uint8_t head_off;
+    volatile uint8_t tail_seg;      // Segment being read
+    uint8_t tail_off;
+    volatile uint8_t segments;      // Segments currently linked into this ring
+    uint8_t peak_segments;
+    uint8_t min_segments;
+    uint8_t max_segments;
+} UART_ElasticRingTypeDef;
+
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t alloc_failures;        // Ring at max or only reserved segments left
+    uint32_t alloc_cycles_total;    // DWT cycles spent in segment allocation
+    uint32_t alloc_cycles_max;
+    uint32_t free_cycles_total;
+    uint32_t free_cycles_max;
+    uint8_t free_segments;
+    uint8_t min_free_segments;      // Low-water mark of the pool
+} UART_PoolStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Return every segment to the pool
+ * @note Call before initializing any elastic ring
+ */
+void UART_Pool_Init(void);
+
+/**
+ * @brief Attach a ring to the pool with one initial segment
+ * @param ring Ring to initialize
+ * @param min_segments Segments held in reserve for this ring
+ * @param max_segments Upper bound on segments linked into this ring
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if the limits do not fit the pool
+ */
+UART_ErrorTypeDef UART_ElasticRing_Init(UART_ElasticRingTypeDef *ring, uint8_t min_segments, uint8_t max_segments);
+
+/**
+ * @brief Append a byte, growing the ring by one segment if needed
+ * @param ring Ring
+ * @param c Byte to store
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_FULL if no segment can be taken
+ */
+UART_ErrorTypeDef UART_ElasticRing_Put(UART_ElasticRingTypeDef *ring, uint8_t c);
+
+/**
+ * @brief Remove the oldest byte, releasing segments the reader has left
+ * @param ring Ring
+ * @param c Pointer to store the byte
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if no data
+ */
+UART_ErrorTypeDef UART_ElasticRing_Get(UART_ElasticRingTypeDef *ring, uint8_t *c);
+
+/**
+ * @brief Read the oldest byte without removing it
+ * @param ring Ring
+ * @param c Pointer to store the byte
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if no data
+ */
+UART_ErrorTypeDef UART_ElasticRing_Peek(const UART_ElasticRingTypeDef *ring, uint8_t *c);
+
+/**
+ * @brief Get the contiguous free span at the write position, growing the ring if needed
+ * @param ring Ring
+ * @param span Pointer to store the span start
+ * @return Bytes that can be written to the span, 0 if no segment can be taken
+ */
+uint16_t UART_ElasticRing_Reserve(UART_ElasticRingTypeDef *ring, uint8_t **span);
+
+/**
+ * @brief Publish bytes written into a reserved span
+ * @param ring Ring
+ * @param len Bytes written, at most the reserved length
+ */
+void UART_ElasticRing_Commit(UART_ElasticRingTypeDef *ring, uint16_t len);
+
+/**
+ * @brief Get the contiguous run of data at the read position
+ * @param ring Ring
+ * @param span Pointer to store the span start
+ * @return Bytes readable from the span (at most one segment), 0 if empty
+ */
+uint16_t UART_ElasticRing_PeekSpan(UART_ElasticRingTypeDef *ring, const uint8_t **span);
+
+/**
+ * @brief Release bytes at the read position
+ * @param ring Ring
+ * @param len Bytes consumed, at most the peeked length
+ */
+void UART_ElasticRing_Consume(UART_ElasticRingTypeDef *ring, uint16_t len);
+
+/**
+ * @brief Number of bytes stored
+ * @param ring Ring
+ * @return Byte count
+ */
+uint32_t UART_ElasticRing_Count(const UART_ElasticRingTypeDef *ring);
+
+/**
+ * @brief Number of bytes that can be stored now
+ * @param ring Ring
+ * @return Room left in the write segment plus the segments the ring may still take from the pool
+ * @note Counts only free segments not held in reserve for other rings, up to max_segments
+ */
+uint32_t UART_ElasticRing_Free(const UART_ElasticRingTypeDef *ring);
+
+/**
+ * @brief Drop all stored bytes and shrink the ring back to one segment
+ * @param ring Ring
+ * @note Caller must keep the ring's ISR side from running (interrupts masked)
+ */
+void UART_ElasticRing_Flush(UART_ElasticRingTypeDef *ring);
+
+/**
+ * @brief Get pool statistics
+ * @param stats Destination for a snapshot of the statistics
+ */
+void UART_Pool_GetStats(UART_PoolStatsTypeDef *stats);
+
+#endif /* INC_UART_RING_POOL_H_ */
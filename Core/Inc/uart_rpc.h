@@ -0,0 +1,106 @@
+/*
+ * uart_rpc.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_RPC_H_
+#define INC_UART_RPC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+#include "uart_frame.h"
+#include "uart_rpc_table.h"
+
+/*
+ * Procedure calls over frames, declared once in uart_rpc_table.h.
+ *
+ *   RPC_REQ  { call_id, proc_id, TLV args... }
+ *   RPC_RESP { call_id, proc_id, status, TLV results... }
+ *   TLV      { tag, len, value[len] }
+ *
+ * Integers are little endian in the fewest bytes that hold them (0 is
+ * sent with len 0, I32 is sign-extended). BYTES arguments are decoded as
+ * views into the RX frame buffer, valid for the duration of the call, and
+ * results are encoded straight into the TX buffer. Unknown argument tags
+ * are skipped, so a newer host can talk to older firmware.
+ */
+
+/**** Type Definitions ****/
+typedef struct {
+    const uint8_t *data;
+    uint8_t len;
+} UART_RpcBytesTypeDef;
+
+typedef enum {
+    UART_RPC_TYPE_U8 = 0,
+    UART_RPC_TYPE_U16,
+    UART_RPC_TYPE_U32,
+    UART_RPC_TYPE_I32,
+    UART_RPC_TYPE_BYTES
+} UART_RpcTypeTypeDef;
+
+typedef struct {
+    uint8_t tag;
+    uint8_t type;               // UART_RpcTypeTypeDef
+    uint16_t offset;            // Field offset in the generated struct
+} UART_RpcFieldTypeDef;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t failed_calls;      // Non-success status, including decode errors
+    uint32_t rx_bytes;          // Request payload bytes
+    uint32_t tx_bytes;          // Response payload bytes
+    uint32_t cycles;            // Decode + call + encode, summed (DWT cycles)
+} UART_RpcStatsTypeDef;
+
+/**** Generated Types ****/
+#define UART_RPC_CTYPE_U8       uint8_t
+#define UART_RPC_CTYPE_U16      uint16_t
+#define UART_RPC_CTYPE_U32      uint32_t
+#define UART_RPC_CTYPE_I32      int32_t
+#define UART_RPC_CTYPE_BYTES    UART_RpcBytesTypeDef
+
+#define UART_RPC_FIELD_MEMBER(S, tag, type, name) UART_RPC_CTYPE_##type name;
+
+/*
+ * present has bit (1 << tag) set for each argument the host sent, and
+ * for each result that will be encoded (all, unless the procedure clears
+ * bits to omit optional results).
+ */
+#define UART_RPC_DECLARE(id, name, args, results)                       \
+    typedef struct {                                                    \
+        uint32_t present;                                               \
+        args(UART_RPC_FIELD_MEMBER, _)                                  \
+    } UART_Rpc##name##ArgsTypeDef;                                      \
+    typedef struct {                                                    \
+        uint32_t present;                                               \
+        results(UART_RPC_FIELD_MEMBER, _)                               \
+    } UART_Rpc##name##ResultsTypeDef;                                   \
+    UART_ErrorTypeDef UART_Rpc_##name(const UART_Rpc##name##ArgsTypeDef *args, \
+                                      UART_Rpc##name##ResultsTypeDef *results);
+
+UART_RPC_PROCEDURES(UART_RPC_DECLARE)
+
+/**** Convenience Macros ****/
+
+/** Check whether an argument (or result) with the given tag is present */
+#define UART_RPC_HAS(fields, tag)   (((fields)->present & (1UL << (tag))) != 0)
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Register the request frame handler
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rpc_Init(void);
+
+/**
+ * @brief Get call counts, payload bytes and cycles
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Rpc_GetStats(UART_RpcStatsTypeDef *out);
+
+#endif /* INC_UART_RPC_H_ */
@@ -0,0 +1,55 @@
+/*
+ * uart_rpc_table.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_RPC_TABLE_H_
+#define INC_UART_RPC_TABLE_H_
+
+/*
+ * RPC procedure table, the single place procedures are declared.
+ *
+ *   X(id, Name, ARGS, RESULTS)
+ *
+ * ARGS and RESULTS name field lists of the form
+ *
+ *   #define LIST(F, S)  F(S, tag, TYPE, field) ...
+ *
+ * with tag 0..31 unique within the list and TYPE one of U8, U16, U32,
+ * I32, BYTES. uart_rpc.h turns each entry into UART_Rpc<Name>ArgsTypeDef,
+ * UART_Rpc<Name>ResultsTypeDef and the prototype of UART_Rpc_<Name>(),
+ * which the application implements. Tags and ids are the wire contract:
+ * append, do not renumber.
+ */
+
+#define UART_RPC_PROCEDURES(X) \
+    X(0x01, Ping,          UART_RPC_PING_ARGS,   UART_RPC_PING_RESULTS) \
+    X(0x02, GetFrameStats, UART_RPC_NO_FIELDS,   UART_RPC_FRAME_STATS_RESULTS) \
+    X(0x03, GetRpcStats,   UART_RPC_NO_FIELDS,   UART_RPC_RPC_STATS_RESULTS)
+
+#define UART_RPC_NO_FIELDS(F, S)
+
+#define UART_RPC_PING_ARGS(F, S) \
+    F(S, 0, BYTES, data)
+
+#define UART_RPC_PING_RESULTS(F, S) \
+    F(S, 0, BYTES, data) \
+    F(S, 1, U32,   tick_ms)
+
+#define UART_RPC_FRAME_STATS_RESULTS(F, S) \
+    F(S, 0, U32, rx_frames) \
+    F(S, 1, U32, rx_checksum_errors) \
+    F(S, 2, U32, rx_oversize) \
+    F(S, 3, U32, rx_unhandled) \
+    F(S, 4, U32, tx_frames)
+
+#define UART_RPC_RPC_STATS_RESULTS(F, S) \
+    F(S, 0, U32, calls) \
+    F(S, 1, U32, failed_calls) \
+    F(S, 2, U32, rx_bytes) \
+    F(S, 3, U32, tx_bytes) \
+    F(S, 4, U32, cycles)
+
+#endif /* INC_UART_RPC_TABLE_H_ */
@@ -0,0 +1,169 @@
+/*
+ * uart_rtos.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_RTOS_H_
+#define INC_UART_RTOS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+#if UART_USE_FREERTOS
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * FreeRTOS port of the ring driver with stream-buffer semantics. One
+ * reader task and one writer task may block at a time; they sleep on a
+ * direct-to-task notification that the UART ISR sends only once the
+ * reader's trigger level or delimiter, or the writer's free-space level,
+ * is reached, so a task is not woken per byte. Calls take an absolute
+ * tick deadline, so a sequence of calls shares one time budget.
+ *
+ * The USART interrupt must be at or below configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * to call FromISR APIs; UART_Rtos_Init() moves it there, and TIM2 one level
+ * below it.
+ */
+
+/**** Configuration ****/
+#ifndef UART_RTOS_NOTIFY_RX
+#define UART_RTOS_NOTIFY_RX (1UL << 0)  // Notification bit for the reader
+#endif
+
+#ifndef UART_RTOS_NOTIFY_TX
+#define UART_RTOS_NOTIFY_TX (1UL << 1)  // Notification bit for the writer
+#endif
+
+#ifndef UART_RTOS_TX_WAKE_SPACE
+#define UART_RTOS_TX_WAKE_SPACE 64U     // Free TX bytes that wake a blocked writer
+#endif
+
+#ifndef UART_RTOS_TIMESTAMP
+#define UART_RTOS_TIMESTAMP() UART_TIME_CYCLES()    // Wake latency clock; override on other ports
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t rx_wakes;
+    uint32_t tx_wakes;
+    uint32_t timeouts;
+    uint32_t last_wake_latency;     // ISR notify to task running, UART_RTOS_TIMESTAMP() units
+    uint32_t min_wake_latency;
+    uint32_t max_wake_latency;
+    uint64_t total_wake_latency;    // Divide by rx_wakes + tx_wakes for the mean
+} UART_RtosStatsTypeDef;
+
+/**** Convenience Macros ****/
+#define UART_RTOS_NO_DELIMITER  (-1)
+#define UART_RTOS_FOREVER       portMAX_DELAY
+#define UART_RTOS_DEADLINE_MS(ms) (xTaskGetTickCount() + pdMS_TO_TICKS(ms))
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Prepare the port and move the USART interrupt to a FreeRTOS-safe priority
+ * @note Call after UART_RingBuff_Init(), before tasks use the driver
+ */
+void UART_Rtos_Init(void);
+
+/**
+ * @brief Set the reader trigger level
+ * @param bytes Bytes UART_Rtos_Read() waits for before returning, at least 1
+ */
+void UART_Rtos_SetRxTriggerLevel(uint16_t bytes);
+
+/**
+ * @brief Receive bytes, blocking until the trigger level is reached
+ * @param data Destination
+ * @param len Capacity of data
+ * @param received Pointer to store the number of bytes read
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS once min(len, trigger level) bytes were read,
+ *         UART_ERROR_TIMEOUT at the deadline (whatever had arrived is returned),
+ *         UART_ERROR_BUSY if another task is already blocked reading
+ */
+UART_ErrorTypeDef UART_Rtos_Read(uint8_t *data, uint16_t len, uint16_t *received, TickType_t deadline);
+
+/**
+ * @brief Receive bytes up to and including a delimiter
+ * @param data Destination
+ * @param size Capacity of data
+ * @param delimiter Byte that ends the record, e.g. '\n'
+ * @param received Pointer to store the number of bytes read
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS if the delimiter was read, UART_ERROR_BUFFER_FULL if size bytes
+ *         came without it, UART_ERROR_TIMEOUT or UART_ERROR_BUSY otherwise
+ * @note The task wakes once per record, not per byte
+ */
+UART_ErrorTypeDef UART_Rtos_ReadUntil(uint8_t *data, uint16_t size, uint8_t delimiter,
+                                      uint16_t *received, TickType_t deadline);
+
+/**
+ * @brief Queue bytes for transmission, blocking while the TX ring is full
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @param sent Pointer to store the number of bytes queued, may be NULL
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS if all bytes were queued, UART_ERROR_TIMEOUT or UART_ERROR_BUSY otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_Write(const uint8_t *data, uint16_t len, uint16_t *sent, TickType_t deadline);
+
+/**
+ * @brief Block until RX holds at least level bytes or a delimiter arrives
+ * @param seen RX byte count the caller has already examined
+ * @param level Byte count that ends the wait
+ * @param delimiter Byte that ends the wait, or UART_RTOS_NO_DELIMITER
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS when woken or when RX changed since seen, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_WaitRx(uint16_t seen, uint16_t level, int16_t delimiter, TickType_t deadline);
+
+/**
+ * @brief Block until the TX ring has at least space free bytes
+ * @param space Free bytes that end the wait
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS when the space is available, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_WaitTx(uint16_t space, TickType_t deadline);
+
+/**
+ * @brief Check whether the caller may block
+ * @return true in a task with the scheduler running, false otherwise
+ */
+bool UART_Rtos_CanBlock(void);
+
+/**
+ * @brief Get wake and latency statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Rtos_GetStats(UART_RtosStatsTypeDef *out);
+
+/**
+ * @brief Park the blocked reader and writer so the ISR hooks pass them by, or put them back
+ * @param hold true to park, false to restore
+ * @note Call with interrupts masked and restore before unmasking; UART_BenchmarkIsr()
+ *       uses it so its own bytes wake no task
+ */
+void UART_Rtos_HoldWakeups(bool hold);
+
+/**
+ * @brief Wake the reader if its level or delimiter was reached
+ * @param c Byte just stored in RX
+ * @note Called from UART_ISR_Handler()
+ */
+void UART_Rtos_RxHook(uint8_t c);
+
+/**
+ * @brief Wake the writer if enough TX space was freed
+ * @note Called from UART_ISR_Handler()
+ */
+void UART_Rtos_TxHook(void);
+
+#endif /* UART_USE_FREERTOS */
+
+#endif /* INC_UART_RTOS_H_ */
@@ -0,0 +1,92 @@
+/*
+ * uart_sched_tx.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_SCHED_TX_H_
+#define INC_UART_SCHED_TX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/**** Configuration ****/
+#ifndef UART_SCHED_TX_MAX_FRAME
+#define UART_SCHED_TX_MAX_FRAME 256
+#endif
+
+#ifndef UART_SCHED_TX_MIN_LEAD_US
+#define UART_SCHED_TX_MIN_LEAD_US 5     // Earliest start relative to "now"
+#endif
+
+#ifndef UART_SCHED_TX_GUARD_BYTES
+#define UART_SCHED_TX_GUARD_BYTES 262   // Longest ring message to drain before a slot (framed 256-byte payload)
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t frames;            // Frames started
+    uint32_t late_starts;       // Ring TX had not reached its boundary, or TC was not set, at the slot start
+    int32_t last_jitter_us;     // Actual start minus requested start
+    int32_t min_jitter_us;
+    int32_t max_jitter_us;
+    uint32_t abs_jitter_sum_us; // Divide by frames for the mean absolute jitter
+} UART_SchedTxStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Queue a frame to start transmitting at an absolute time
+ * @param data Frame bytes (copied, the caller may reuse the buffer)
+ * @param len Frame length, 1 .. UART_SCHED_TX_MAX_FRAME
+ * @param start_us Start time on the UART_Time_Us() clock
+ * @return UART_SUCCESS on success, UART_ERROR_BUSY if a frame is already queued,
+ *         UART_ERROR_TIMEOUT if start_us is too close or already past
+ * @note UART_SCHED_TX_GUARD_BYTES of line time before start_us, TX ring traffic is held at
+ *       the next message boundary (UART_TxHold()). At start_us the UART ISR sends the first
+ *       byte once TC shows the line idle, then the rest ahead of the TX ring
+ */
+UART_ErrorTypeDef UART_SchedTx_Schedule(const uint8_t *data, uint16_t len, uint64_t start_us);
+
+/**
+ * @brief Cancel a queued frame that has not started yet
+ */
+void UART_SchedTx_Cancel(void);
+
+/**
+ * @brief Check whether a frame is queued or still transmitting
+ * @return true if busy, false otherwise
+ */
+bool UART_SchedTx_IsPending(void);
+
+/**
+ * @brief Get start-time jitter statistics
+ * @param stats Destination for a snapshot of the statistics
+ */
+void UART_SchedTx_GetStats(UART_SchedTxStatsTypeDef *stats);
+
+/**
+ * @brief Start the frame whose slot has been reached
+ * @param c Pointer to store the first byte
+ * @return true if the frame starts with this byte, false if none is due
+ * @note Called from UART_ISR_Handler() on TC, after UART_TxStartScheduled()
+ */
+bool UART_SchedTx_Start(uint8_t *c);
+
+/**
+ * @brief Fetch the next byte of the active frame
+ * @param c Pointer to store the byte
+ * @return true if a byte was returned, false if no frame is being sent
+ * @note Called from UART_ISR_Handler() on TXE; releases the TX ring after the last byte
+ */
+bool UART_SchedTx_NextByte(uint8_t *c);
+
+/**
+ * @brief Compare event handler (CC1: slot start, CC2: guard before the slot)
+ * @note Call this function from TIM2_IRQHandler
+ */
+void UART_SchedTx_IRQHandler(void);
+
+#endif /* INC_UART_SCHED_TX_H_ */
@@ -0,0 +1,56 @@
+/*
+ * uart_stack.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_STACK_H_
+#define INC_UART_STACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Main stack high-water mark. UART_Stack_Paint() fills the unused part of
+ * the _Min_Stack_Size budget (the same limit _sbrk() keeps the heap below)
+ * with a pattern; UART_Stack_GetStats() finds the deepest word that has
+ * been overwritten since. Every exception runs on this stack, so the mark
+ * covers nested USART2/TIM2/SysTick handlers on top of the deepest
+ * blocking call.
+ *
+ * There is no MPU guard: a stack that outgrows the budget runs into the
+ * heap and .bss. overflowed reports that the last word of the budget was
+ * reached, after the fact.
+ */
+
+/**** Configuration ****/
+#ifndef UART_STACK_PAINT_PATTERN
+#define UART_STACK_PAINT_PATTERN 0xA5A5A5A5UL
+#endif
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t size;              // Budget in bytes, _Min_Stack_Size
+    uint32_t used_max;          // Deepest use since UART_Stack_Paint(), bytes
+    uint32_t used_now;          // Depth of the caller, bytes
+    bool painted;
+    bool overflowed;            // Budget exhausted; used_max is then a lower bound
+} UART_StackStatsTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Fill the unused stack budget with the paint pattern
+ * @note Call first thing in main(); masks interrupts while painting
+ */
+void UART_Stack_Paint(void);
+
+/**
+ * @brief Measure the stack high-water mark
+ * @param out Destination for the statistics
+ * @note Scans up to _Min_Stack_Size bytes; call from the main loop, not an ISR
+ */
+void UART_Stack_GetStats(UART_StackStatsTypeDef *out);
+
+#endif /* INC_UART_STACK_H_ */
@@ -0,0 +1,88 @@
+/*
+ * uart_timebase.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_TIMEBASE_H_
+#define INC_UART_TIMEBASE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_ring_buffer.h"
+
+/**** Configuration ****/
+#define UART_TIMEBASE_TIM TIM2      // Only 32-bit timer on the STM32L432
+
+#ifndef UART_TIMEBASE_IRQ_PRIORITY
+#define UART_TIMEBASE_IRQ_PRIORITY 2   // Below USART2 (0), compare work must not hold off RX
+#endif
+
+#define UART_TIMEBASE_WAKEUP_MAX_US 0x40000000UL    // Longest single wake-up compare, well inside the 32-bit wrap
+
+/**** Convenience Macros ****/
+
+/**
+ * @brief Raw 32-bit microsecond counter, wraps every ~71 minutes
+ * @note Single register read, use for short intervals inside ISRs
+ */
+#define UART_TIME_US32()    (UART_TIMEBASE_TIM->CNT)
+
+/**
+ * @brief Core cycle counter (DWT CYCCNT) for cycle-accurate measurements
+ */
+#define UART_TIME_CYCLES()  (DWT->CYCCNT)
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Start the microsecond timebase and the DWT cycle counter
+ * @return UART_SUCCESS on success, error code otherwise
+ * @note Call after SystemClock_Config(); the prescaler is derived from PCLK1. CYCCNT is
+ *       only cleared if nothing has started it yet
+ */
+UART_ErrorTypeDef UART_Timebase_Init(void);
+
+/**
+ * @brief Read the 64-bit monotonic microsecond clock
+ * @return Microseconds since UART_Timebase_Init()
+ * @note Safe from any context, including ISRs running above the timer IRQ
+ */
+uint64_t UART_Time_Us(void);
+
+/**
+ * @brief Check whether a microsecond deadline has passed
+ * @param deadline_us Absolute deadline from UART_Time_Us()
+ * @return true if the deadline has been reached, false otherwise
+ */
+bool UART_Time_DeadlineExpired(uint64_t deadline_us);
+
+/**
+ * @brief Arm a one-shot TIM2 compare that ends WFI at a deadline
+ * @param deadline_us Absolute deadline from UART_Time_Us()
+ * @return true if armed, false if the deadline has already passed
+ * @note Uses channel 3; a deadline beyond UART_TIMEBASE_WAKEUP_MAX_US fires early, re-arm
+ *       after waking. Call with interrupts masked right before WFI
+ */
+bool UART_Time_ArmWakeup(uint64_t deadline_us);
+
+/**
+ * @brief Disarm the compare set by UART_Time_ArmWakeup()
+ */
+void UART_Time_DisarmWakeup(void);
+
+/**
+ * @brief Re-derive the prescaler after a PCLK1 frequency change
+ * @note Call right after the clock switch with interrupts masked; the count carries over,
+ *       so UART_Time_Us() stays monotonic and only the switch itself is mis-timed
+ */
+void UART_Timebase_Rescale(void);
+
+/**
+ * @brief Timebase timer interrupt handler
+ * @note Call this function from TIM2_IRQHandler
+ */
+void UART_Timebase_IRQHandler(void);
+
+#endif /* INC_UART_TIMEBASE_H_ */
@@ -0,0 +1,85 @@
+/*
+ * uart_timer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_TIMER_H_
+#define INC_UART_TIMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "uart_ring_buffer.h"
+
+/**** Configuration ****/
+#ifndef UART_TIMER_WHEEL_BITS
+#define UART_TIMER_WHEEL_BITS 6     // Slots per level = 2^bits
+#endif
+
+#ifndef UART_TIMER_WHEEL_LEVELS
+#define UART_TIMER_WHEEL_LEVELS 4   // Range = 2^(bits * levels) ticks
+#endif
+
+/**** Type Definitions ****/
+typedef void (*UART_TimerCallbackTypeDef)(void *context);
+
+typedef struct UART_Timer {
+    struct UART_Timer *next;
+    struct UART_Timer **pprev;      // NULL when the timer is not armed
+    uint32_t expires;               // Absolute expiry in HAL ticks
+    UART_TimerCallbackTypeDef callback;
+    void *context;
+} UART_TimerTypeDef;
+
+/**** Function Prototypes ****/
+
+/**
+ * @brief Initialize the timer wheel
+ * @note Timers armed before this call are forgotten
+ */
+void UART_Timer_Init(void);
+
+/**
+ * @brief Arm (or re-arm) a timer relative to the current tick
+ * @param timer Timer object owned by the caller
+ * @param ticks Delay in HAL ticks (0 is treated as 1)
+ * @param callback Function called from UART_Timer_Process() on expiry
+ * @param context Opaque pointer passed to the callback
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ * @note O(1), safe to call from interrupt context
+ */
+UART_ErrorTypeDef UART_Timer_Start(UART_TimerTypeDef *timer, uint32_t ticks,
+                                   UART_TimerCallbackTypeDef callback, void *context);
+
+/**
+ * @brief Cancel a timer
+ * @param timer Timer to cancel
+ * @note O(1), safe to call from interrupt context and on idle timers
+ */
+void UART_Timer_Stop(UART_TimerTypeDef *timer);
+
+/**
+ * @brief Check whether a timer is armed
+ * @param timer Timer to check
+ * @return true if the timer is pending, false otherwise
+ */
+bool UART_Timer_IsActive(const UART_TimerTypeDef *timer);
+
+/**
+ * @brief Ticks until the wheel next has work for UART_Timer_Process()
+ * @param ticks Pointer to store the delay from the current tick (0: due now)
+ * @return true if any timer is armed, false otherwise
+ * @note Timers beyond the first level are reported at their cascade, so the
+ *       value may be earlier than the expiry but never later. O(levels)
+ */
+bool UART_Timer_NextDeadline(uint32_t *ticks);
+
+/**
+ * @brief Advance the wheel to the current tick and run expired callbacks
+ * @note Call this from the main loop; callbacks run in this (thread) context
+ */
+void UART_Timer_Process(void);
+
+#endif /* INC_UART_TIMER_H_ */
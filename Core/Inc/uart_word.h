@@ -0,0 +1,43 @@
+/*
+ * uart_word.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_UART_WORD_H_
+#define INC_UART_WORD_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Unaligned 32-bit loads and stores for the word-at-a-time paths (copy,
+ * codec, checksum, number parsing). memcpy of a constant 4 bytes compiles
+ * to a single LDR/STR on Cortex-M4, which allows unaligned access while
+ * CCR.UNALIGN_TRP is clear (the reset value), and stays portable on hosts.
+ */
+
+/**
+ * @brief Unaligned little-endian word load (single LDR on Cortex-M4)
+ * @param p Source, any alignment
+ * @return Word at p
+ */
+static inline uint32_t UART_LoadWord(const void *p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+/**
+ * @brief Unaligned little-endian word store (single STR on Cortex-M4)
+ * @param p Destination, any alignment
+ * @param w Word to store
+ */
+static inline void UART_StoreWord(void *p, uint32_t w)
+{
+    memcpy(p, &w, sizeof(w));
+}
+
+#endif /* INC_UART_WORD_H_ */
@@ -22,6 +22,24 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "uart_ring_buffer.h"
+#include "uart_timer.h"
+#include "uart_timebase.h"
+#include "uart_ratelimit.h"
+#if UART_ENABLE_CLOCK_GOVERNOR
+#include "uart_clock_gov.h"
+#endif
+#if UART_FAST_BOOT || UART_BOOT_PROFILE
+#include "uart_boot.h"
+#endif
+#if UART_ENABLE_TICKLESS_IDLE
+#include "uart_idle.h"
+#endif
+#if UART_ENABLE_STACK_MONITOR
+#include "uart_stack.h"
+#endif
+#if UART_ENABLE_BENCHMARK
+#include "uart_bench.h"
+#endif
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -49,6 +67,12 @@
 UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN PV */
+#if UART_FAST_BOOT
+static bool uart_fast_boot_ok;   // false: HSI16 did not start, USART2 comes up through HAL
+#endif
+#if UART_ENABLE_TICKLESS_IDLE || UART_ENABLE_BENCHMARK || UART_ENABLE_CLOCK_GOVERNOR
+static UART_TimerTypeDef blink_timer;
+#endif
 
 /* USER CODE END PV */
 
@@ -57,6 +81,12 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_USART2_UART_Init(void);
 /* USER CODE BEGIN PFP */
+#if UART_ENABLE_TICKLESS_IDLE || UART_ENABLE_BENCHMARK || UART_ENABLE_CLOCK_GOVERNOR
+static void BlinkCallback(void *context);
+#endif
+#if UART_ENABLE_TICKLESS_IDLE
+static bool MainLoopHasWork(void);
+#endif
 
 /* USER CODE END PFP */
 
@@ -73,7 +103,20 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+#if UART_ENABLE_STACK_MONITOR
+  UART_Stack_Paint();
+#endif
+#if UART_BOOT_PROFILE
+  UART_Boot_Mark(UART_BOOT_MARK_MAIN);
+#endif
+#if UART_FAST_BOOT
+  // USART2 answers before HAL_Init() and the LSE/PLL start-up in SystemClock_Config()
+  uart_fast_boot_ok = (UART_Boot_FastInit() == UART_SUCCESS);
+  if (!uart_fast_boot_ok)
+  {
+    huart2.gState = HAL_UART_STATE_RESET;   // Full HAL bring-up, MSP included
+  }
+#endif
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -89,7 +132,9 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+#if UART_BOOT_PROFILE
+  UART_Boot_Mark(UART_BOOT_MARK_CLOCK_READY);
+#endif
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -97,7 +142,34 @@ int main(void)
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
 
+  UART_Timebase_Init();
+#if UART_FAST_BOOT
+  if (!uart_fast_boot_ok)
+  {
+    UART_RingBuff_Init();   // Fast path failed, HAL brought USART2 up above
+  }
+#else
   UART_RingBuff_Init();
+#endif
+  UART_Timer_Init();
+#if UART_ENABLE_CLOCK_GOVERNOR
+  UART_ClockGov_Init();
+  UART_ClockGov_Start();
+#endif
+#if UART_ENABLE_BENCHMARK
+  UART_Frame_Init();
+  UART_Bench_Init();
+#endif
+#if UART_ENABLE_TICKLESS_IDLE
+  UART_Idle_Init();
+#endif
+#if UART_ENABLE_TICKLESS_IDLE || UART_ENABLE_BENCHMARK || UART_ENABLE_CLOCK_GOVERNOR
+  // The LED blinks from the timer wheel so the loop never stops in HAL_Delay()
+  UART_Timer_Start(&blink_timer, 1000, BlinkCallback, NULL);
+#endif
+#if UART_BOOT_PROFILE
+  UART_Boot_Mark(UART_BOOT_MARK_INIT_DONE);
+#endif
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -107,6 +179,13 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+	  UART_Timer_Process();
+	  UART_RateLimit_Process();
+
+#if UART_ENABLE_BENCHMARK
+	  UART_Frame_Poll();
+	  UART_Bench_Process();
+#else
 	  while (UART_Available())
 	  {
 		  uint8_t data;
@@ -115,9 +194,14 @@ int main(void)
 
 		  UART_WriteChar(data);
 	  }
+#endif
 
+#if UART_ENABLE_TICKLESS_IDLE
+	  UART_Idle_Sleep(UART_IDLE_FOREVER, MainLoopHasWork);
+#elif !UART_ENABLE_BENCHMARK && !UART_ENABLE_CLOCK_GOVERNOR
 	  HAL_GPIO_TogglePin(LD3_GPIO_Port, LD3_Pin);
 	  HAL_Delay(1000);
+#endif
   }
   /* USER CODE END 3 */
 }
@@ -191,7 +275,12 @@ static void MX_USART2_UART_Init(void)
 {
 
   /* USER CODE BEGIN USART2_Init 0 */
-
+#if UART_FAST_BOOT
+  if (uart_fast_boot_ok)
+  {
+    return;   // Already running, see UART_Boot_FastInit()
+  }
+#endif
   /* USER CODE END USART2_Init 0 */
 
   /* USER CODE BEGIN USART2_Init 1 */
@@ -260,6 +349,37 @@ PUTCHAR_PROTOTYPE
   return ch;
 }
 
+#if UART_ENABLE_TICKLESS_IDLE || UART_ENABLE_BENCHMARK || UART_ENABLE_CLOCK_GOVERNOR
+/**
+  * @brief  Toggle the LED and re-arm for the next second
+  * @param  context Unused
+  * @retval None
+  */
+static void BlinkCallback(void *context)
+{
+  (void)context;
+  HAL_GPIO_TogglePin(LD3_GPIO_Port, LD3_Pin);
+  UART_Timer_Start(&blink_timer, 1000, BlinkCallback, NULL);
+}
+#endif
+
+#if UART_ENABLE_TICKLESS_IDLE
+/**
+  * @brief  Idle wake condition for the main loop
+  * @retval true if received bytes are waiting, or the benchmark has frames to send
+  */
+static bool MainLoopHasWork(void)
+{
+#if UART_ENABLE_BENCHMARK
+  if (UART_Bench_Busy())
+  {
+    return true;
+  }
+#endif
+  return UART_Available() != 0;
+}
+#endif
+
 /* USER CODE END 4 */
 
 /**
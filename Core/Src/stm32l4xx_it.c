@@ -23,6 +23,11 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "uart_ring_buffer.h"
+#include "uart_timebase.h"
+#include "uart_sched_tx.h"
+#if UART_ENABLE_TICKLESS_IDLE
+#include "uart_idle.h"
+#endif
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -217,4 +222,25 @@ void USART2_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles TIM2 global interrupt (microsecond timebase).
+  */
+void TIM2_IRQHandler(void)
+{
+  UART_Timebase_IRQHandler();
+#if UART_ENABLE_SCHED_TX
+  UART_SchedTx_IRQHandler();
+#endif
+}
+
+#if UART_ENABLE_TICKLESS_IDLE
+/**
+  * @brief This function handles LPTIM1 global interrupt (tickless idle wake-up).
+  */
+void LPTIM1_IRQHandler(void)
+{
+  UART_Idle_IRQHandler();
+}
+#endif
+
 /* USER CODE END 1 */
@@ -89,6 +89,7 @@
   */
 
 #include "stm32l4xx.h"
+#include "uart_ring_buffer.h"  /* UART_BOOT_PROFILE default */
 
 /**
   * @}
@@ -205,6 +206,13 @@ void SystemInit(void)
 #if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
   SCB->CPACR |= ((3UL << 20U)|(3UL << 22U));  /* set CP10 and CP11 Full Access */
 #endif
+
+#if UART_BOOT_PROFILE
+  /* Boot timing (uart_boot.h): count core cycles from the reset vector */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
 
 /**
@@ -0,0 +1,200 @@
+/*
+ * uart_batch.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_batch.h"
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define CMD_HEADER_SIZE     2U      // seq, cmd
+#define BATCH_HEADER_SIZE   3U      // batch_id, flags, count
+#define ENTRY_HEADER_SIZE   2U      // cmd, len / status, len
+#define BATCH_RESP_HEADER   2U      // batch_id, executed
+
+/**** Private Variables ****/
+static const UART_BatchCommandTypeDef *command_table;
+static uint8_t command_count;
+static UART_BatchStatsTypeDef stats;
+static uint8_t response[UART_FRAME_MAX_PAYLOAD];
+
+/**** Private Function Prototypes ****/
+static void HandleCommand(const UART_FrameTypeDef *frame);
+static void HandleBatch(const UART_FrameTypeDef *frame);
+static uint32_t ServiceStart(const UART_FrameTypeDef *frame);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Install the command table and register the request frame handlers
+ * @param table Commands, may live in flash
+ * @param count Number of commands
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Batch_Init(const UART_BatchCommandTypeDef *table, uint8_t count)
+{
+    UART_ErrorTypeDef result;
+
+    if (table == NULL || count == 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    command_table = table;
+    command_count = count;
+    memset(&stats, 0, sizeof(stats));
+
+    result = UART_Frame_RegisterHandler(UART_FRAME_TYPE_CMD_REQ, HandleCommand);
+    if (result != UART_SUCCESS) {
+        return result;
+    }
+    return UART_Frame_RegisterHandler(UART_FRAME_TYPE_BATCH_REQ, HandleBatch);
+}
+
+/**
+ * @brief Run one command locally through the table
+ * @param cmd Command id
+ * @param args Argument bytes
+ * @param len Number of argument bytes
+ * @param reply Reply buffer, UART_BATCH_MAX_REPLY bytes
+ * @param reply_len Pointer to store the reply length
+ * @return Handler status, UART_ERROR_NOT_FOUND for an unknown command
+ */
+UART_ErrorTypeDef UART_Batch_Execute(uint8_t cmd, const uint8_t *args, uint8_t len,
+                                     uint8_t *reply, uint8_t *reply_len)
+{
+    UART_ErrorTypeDef result;
+
+    *reply_len = 0;
+
+    for (uint8_t i = 0; i < command_count; i++) {
+        if (command_table[i].id == cmd) {
+            result = command_table[i].handler(args, len, reply, reply_len);
+            if (*reply_len > UART_BATCH_MAX_REPLY) {
+                *reply_len = UART_BATCH_MAX_REPLY;  // Misbehaving handler; never overrun the frame
+            }
+            return result;
+        }
+    }
+
+    return UART_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief Get per-path command counts and service time
+ * @param out Destination for a snapshot of the statistics
+ * @note single_us / single_commands against batch_us / batch_commands is the
+ *       firmware share of configuration time per command for each path
+ */
+void UART_Batch_GetStats(UART_BatchStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = stats;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Execute a CMD_REQ frame and answer with CMD_RESP
+ * @param frame Received frame
+ */
+static void HandleCommand(const UART_FrameTypeDef *frame)
+{
+    uint32_t start = ServiceStart(frame);
+    uint8_t reply_len;
+    UART_ErrorTypeDef result;
+
+    if (frame->len < CMD_HEADER_SIZE) {
+        return;
+    }
+
+    result = UART_Batch_Execute(frame->payload[1], &frame->payload[CMD_HEADER_SIZE],
+                                (uint8_t)(frame->len - CMD_HEADER_SIZE), &response[2], &reply_len);
+    response[0] = frame->payload[0];
+    response[1] = (uint8_t)(int8_t)result;
+
+    UART_Frame_Send(UART_FRAME_TYPE_CMD_RESP, response, (uint16_t)(2U + reply_len));
+
+    stats.single_commands++;
+    stats.single_us += (uint32_t)(UART_TIME_US32() - start);
+    if (result != UART_SUCCESS) {
+        stats.failed_commands++;
+    }
+}
+
+/**
+ * @brief Execute a BATCH_REQ frame in order and answer with one BATCH_RESP
+ * @param frame Received frame
+ */
+static void HandleBatch(const UART_FrameTypeDef *frame)
+{
+    uint32_t start = ServiceStart(frame);
+    const uint8_t *p = frame->payload;
+    uint16_t in = BATCH_HEADER_SIZE;
+    uint16_t out = BATCH_RESP_HEADER;
+    uint8_t count;
+    uint8_t executed = 0;
+    uint8_t reply_len;
+    uint8_t args_len;
+    UART_ErrorTypeDef result;
+
+    if (frame->len < BATCH_HEADER_SIZE) {
+        return;
+    }
+    count = p[2];
+
+    while (executed < count) {
+        if (in + ENTRY_HEADER_SIZE > frame->len) {
+            break;                                      // Malformed: count exceeds the entries sent
+        }
+        args_len = p[in + 1];
+        if (in + ENTRY_HEADER_SIZE + args_len > frame->len) {
+            break;
+        }
+        if (out + ENTRY_HEADER_SIZE + UART_BATCH_MAX_REPLY > sizeof(response)) {
+            break;                                      // Host resumes from "executed"
+        }
+
+        result = UART_Batch_Execute(p[in], &p[in + ENTRY_HEADER_SIZE], args_len,
+                                    &response[out + ENTRY_HEADER_SIZE], &reply_len);
+        response[out] = (uint8_t)(int8_t)result;
+        response[out + 1] = reply_len;
+        out += ENTRY_HEADER_SIZE + reply_len;
+        in += ENTRY_HEADER_SIZE + args_len;
+        executed++;
+
+        if (result != UART_SUCCESS) {
+            stats.failed_commands++;
+            if (p[1] & UART_BATCH_FLAG_STOP_ON_ERROR) {
+                break;
+            }
+        }
+    }
+
+    response[0] = p[0];
+    response[1] = executed;
+    UART_Frame_Send(UART_FRAME_TYPE_BATCH_RESP, response, out);
+
+    stats.batch_frames++;
+    stats.batch_commands += executed;
+    stats.batch_us += (uint32_t)(UART_TIME_US32() - start);
+    if (executed < count) {
+        stats.truncated_batches++;
+    }
+}
+
+/**
+ * @brief Start of service time for a request frame
+ * @param frame Received frame
+ * @return SOF timestamp when the ISR latched one, current time otherwise
+ */
+static uint32_t ServiceStart(const UART_FrameTypeDef *frame)
+{
+    return frame->rx_timestamp_valid ? frame->rx_timestamp_us : UART_TIME_US32();
+}
@@ -0,0 +1,363 @@
+/*
+ * uart_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_bench.h"
+#include "uart_timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/**** Configuration Section ****/
+#define CTRL_START_SIZE     8U      // op, mode, count, len
+#define CTRL_BAUD_SIZE      5U      // op, baud
+#define REPORT_SIZE         44U
+#define ISR_REPORT_SIZE     24U
+#define FRAME_OVERHEAD      (UART_FRAME_HEADER_SIZE + UART_FRAME_TRAILER_SIZE)
+#define MIN_BAUD            1200U
+#define MIN_OVERSAMPLING    16U     // BRR of at least 16 at the kernel clock, as for OVER8 = 0
+
+/**** External Dependencies ****/
+extern UART_HandleTypeDef huart2;
+
+/**** Private Variables ****/
+static UART_BenchStatsTypeDef stats;
+static uint32_t next_rx_seq;
+static uint32_t source_seq;
+static uint32_t source_count;
+static uint16_t source_len;
+static uint32_t pending_baud;       // Applied by UART_Bench_Process() once TX is idle
+static bool pending_isr;            // UART_BenchmarkIsr() needs TX idle and both rings empty
+
+/**** Private Function Prototypes ****/
+static void HandleCtrl(const UART_FrameTypeDef *frame);
+static void HandleData(const UART_FrameTypeDef *frame);
+static void SendReport(void);
+static bool TxIdle(void);
+#if UART_ENABLE_ISR_BENCHMARK
+static bool SendIsrReport(void);
+#endif
+static void PutU16(uint8_t *p, uint16_t v);
+static void PutU32(uint8_t *p, uint32_t v);
+static uint16_t GetU16(const uint8_t *p);
+static uint32_t GetU32(const uint8_t *p);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Register the benchmark frame handlers and enter IDLE
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Bench_Init(void)
+{
+    UART_ErrorTypeDef status;
+
+    memset(&stats, 0, sizeof(stats));
+    source_count = 0;
+    pending_baud = 0;
+    pending_isr = false;
+
+    status = UART_Frame_RegisterHandler(UART_FRAME_TYPE_BENCH_CTRL, HandleCtrl);
+    if (status != UART_SUCCESS) {
+        return status;
+    }
+    return UART_Frame_RegisterHandler(UART_FRAME_TYPE_BENCH_DATA, HandleData);
+}
+
+/**
+ * @brief Generate SOURCE traffic and apply a pending baud change
+ */
+void UART_Bench_Process(void)
+{
+    if (pending_baud != 0U) {
+        // The REPORT acknowledging the change must leave at the old rate
+        if (!TxIdle()) {
+            return;
+        }
+        UART_SetBaudRate(__HAL_RCC_GET_USART2_SOURCE(), pending_baud);
+        pending_baud = 0;
+        return;
+    }
+
+#if UART_ENABLE_ISR_BENCHMARK
+    if (pending_isr) {
+        // Retried until the rings have drained, e.g. the tail of the request frame
+        if (TxIdle() && SendIsrReport()) {
+            pending_isr = false;
+        }
+        return;
+    }
+#endif
+
+    if (stats.mode != UART_BENCH_MODE_SOURCE) {
+        return;
+    }
+
+    // Only whole frames, so the main loop never waits on the TX ring
+    while (source_seq < source_count && UART_TxFree() >= source_len + FRAME_OVERHEAD) {
+        uint8_t *out = UART_Frame_Reserve(source_len);
+        if (out == NULL) {
+            return;
+        }
+
+        PutU32(&out[0], source_seq);
+        PutU32(&out[4], 0);
+        PutU32(&out[8], 0);
+        for (uint16_t i = UART_BENCH_DATA_HEADER; i < source_len; i++) {
+            out[i] = (uint8_t)(source_seq + i);
+        }
+        PutU32(&out[12], UART_TIME_US32());
+
+        if (UART_Frame_Commit(UART_FRAME_TYPE_BENCH_DATA, source_len) != UART_SUCCESS) {
+            return;
+        }
+        stats.tx_frames++;
+        stats.tx_bytes += source_len + FRAME_OVERHEAD;
+        source_seq++;
+    }
+
+    if (source_seq >= source_count) {
+        stats.mode = UART_BENCH_MODE_IDLE;
+    }
+}
+
+/**
+ * @brief Check whether the benchmark has work without new RX bytes
+ * @return true while SOURCE frames or a baud change are pending
+ */
+bool UART_Bench_Busy(void)
+{
+    return pending_baud != 0U || pending_isr || stats.mode == UART_BENCH_MODE_SOURCE;
+}
+
+/**
+ * @brief Get the counters of the current run
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Bench_GetStats(UART_BenchStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = stats;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Start, stop or reconfigure a run and answer with a REPORT
+ * @param frame Received BENCH_CTRL frame
+ */
+static void HandleCtrl(const UART_FrameTypeDef *frame)
+{
+    const uint8_t *p = frame->payload;
+
+    if (frame->len < 1U) {
+        return;
+    }
+
+    switch (p[0]) {
+    case UART_BENCH_OP_START:
+        if (frame->len < CTRL_START_SIZE || p[1] > UART_BENCH_MODE_ECHO) {
+            return;
+        }
+        memset(&stats, 0, sizeof(stats));
+        stats.mode = (UART_BenchModeTypeDef)p[1];
+        next_rx_seq = 0;
+        source_seq = 0;
+        source_count = GetU32(&p[2]);
+        source_len = GetU16(&p[6]);
+        if (source_len < UART_BENCH_DATA_HEADER) {
+            source_len = UART_BENCH_DATA_HEADER;
+        } else if (source_len > UART_FRAME_MAX_PAYLOAD) {
+            source_len = UART_FRAME_MAX_PAYLOAD;
+        }
+        break;
+
+    case UART_BENCH_OP_STOP:
+        stats.mode = UART_BENCH_MODE_IDLE;
+        break;
+
+    case UART_BENCH_OP_SET_BAUD: {
+        if (frame->len < CTRL_BAUD_SIZE) {
+            return;
+        }
+        uint32_t baud = GetU32(&p[1]);
+        if (baud < MIN_BAUD || baud > HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_USART2) / MIN_OVERSAMPLING) {
+            return;
+        }
+        stats.mode = UART_BENCH_MODE_IDLE;
+        pending_baud = baud;
+        break;
+    }
+
+#if UART_ENABLE_ISR_BENCHMARK
+    case UART_BENCH_OP_ISR:
+        // Runs from UART_Bench_Process() and answers there, not with a REPORT
+        stats.mode = UART_BENCH_MODE_IDLE;
+        pending_isr = true;
+        return;
+#endif
+
+    default:
+        return;
+    }
+
+    SendReport();
+}
+
+/**
+ * @brief Count a DATA frame and, in ECHO mode, send it back stamped
+ * @param frame Received BENCH_DATA frame
+ */
+static void HandleData(const UART_FrameTypeDef *frame)
+{
+    uint32_t rx_us = frame->rx_timestamp_valid ? frame->rx_timestamp_us : UART_TIME_US32();
+    uint32_t seq;
+
+    if (frame->len < UART_BENCH_DATA_HEADER ||
+        (stats.mode != UART_BENCH_MODE_SINK && stats.mode != UART_BENCH_MODE_ECHO)) {
+        return;
+    }
+
+    seq = GetU32(frame->payload);
+    if (stats.rx_frames == 0U) {
+        stats.first_rx_us = rx_us;
+    }
+    stats.last_rx_us = rx_us;
+    stats.rx_frames++;
+    stats.rx_bytes += frame->len + FRAME_OVERHEAD;
+
+    // A late or repeated seq is not counted twice; a gap is loss
+    if ((int32_t)(seq - next_rx_seq) >= 0) {
+        stats.lost += seq - next_rx_seq;
+        next_rx_seq = seq + 1U;
+    }
+
+    if (stats.mode != UART_BENCH_MODE_ECHO) {
+        return;
+    }
+
+    uint8_t *out = UART_Frame_Reserve(frame->len);
+    if (out == NULL) {
+        return;
+    }
+    memcpy(out, frame->payload, frame->len);
+    PutU32(&out[8], rx_us);
+    PutU32(&out[12], UART_TIME_US32());
+    if (UART_Frame_Commit(UART_FRAME_TYPE_BENCH_DATA, frame->len) == UART_SUCCESS) {
+        stats.tx_frames++;
+        stats.tx_bytes += frame->len + FRAME_OVERHEAD;
+    }
+}
+
+/**
+ * @brief Send the counters of the current run as a BENCH_REPORT frame
+ */
+static void SendReport(void)
+{
+    UART_FrameStatsTypeDef frame_stats;
+    UART_IsrProfileTypeDef isr;
+    uint8_t out[REPORT_SIZE];
+
+    UART_Frame_GetStats(&frame_stats);
+    UART_GetIsrProfile(&isr);
+
+    out[0] = (uint8_t)stats.mode;
+    out[1] = 0;
+    PutU16(&out[2], UART_BUFFER_SIZE);
+    PutU32(&out[4], huart2.Init.BaudRate);
+    PutU32(&out[8], stats.rx_frames);
+    PutU32(&out[12], stats.rx_bytes);
+    PutU32(&out[16], stats.tx_frames);
+    PutU32(&out[20], stats.tx_bytes);
+    PutU32(&out[24], stats.lost);
+    PutU32(&out[28], stats.first_rx_us);
+    PutU32(&out[32], stats.last_rx_us);
+    PutU32(&out[36], frame_stats.rx_checksum_errors);
+    PutU32(&out[40], isr.overrun_errors);
+
+    (void)UART_Frame_Send(UART_FRAME_TYPE_BENCH_REPORT, out, sizeof(out));
+}
+
+#if UART_ENABLE_ISR_BENCHMARK
+/**
+ * @brief Run UART_BenchmarkIsr() and send the result as a BENCH_ISR frame
+ * @return true if sent, false if the driver was busy and nothing ran
+ */
+static bool SendIsrReport(void)
+{
+    UART_IsrBenchmarkTypeDef isr;
+    uint8_t out[ISR_REPORT_SIZE];
+
+    if (UART_BenchmarkIsr(&isr) != UART_SUCCESS) {
+        return false;
+    }
+
+    PutU32(&out[0], isr.features);
+    PutU32(&out[4], isr.idle_cycles);
+    PutU32(&out[8], isr.rx_cycles);
+    PutU32(&out[12], isr.tx_cycles);
+    PutU32(&out[16], isr.tx_empty_cycles);
+    PutU32(&out[20], isr.error_cycles);
+
+    (void)UART_Frame_Send(UART_FRAME_TYPE_BENCH_ISR, out, sizeof(out));
+    return true;
+}
+#endif
+
+/**
+ * @brief Check that the TX ring is empty and the last stop bit has left
+ */
+static bool TxIdle(void)
+{
+    return !READ_BIT(huart2.Instance->CR1, USART_CR1_TXEIE) && READ_BIT(huart2.Instance->ISR, USART_ISR_TC);
+}
+
+/**
+ * @brief Store a 16-bit value little endian
+ * @param p Destination, two bytes
+ * @param v Value
+ */
+static void PutU16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/**
+ * @brief Store a 32-bit value little endian
+ * @param p Destination, four bytes
+ * @param v Value
+ */
+static void PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief Load a 16-bit little-endian value
+ * @param p Source, two bytes
+ * @return Value
+ */
+static uint16_t GetU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief Load a 32-bit little-endian value
+ * @param p Source, four bytes
+ * @return Value
+ */
+static uint32_t GetU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
@@ -0,0 +1,188 @@
+/*
+ * uart_boot.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_boot.h"
+#include "main.h"
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_rcc.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define UART_BAUD_RATE      115200U     // Must match MX_USART2_UART_Init()
+#define USART_KERNEL_HZ     16000000UL  // HSI16
+#define RESET_CORE_HZ       4000000UL   // MSI range 6 out of reset
+#define HSI_READY_TIMEOUT   1000U       // Loop iterations, HSI starts in a few us
+
+/**** External Dependencies ****/
+extern UART_HandleTypeDef huart2;
+
+/**** Private Variables ****/
+#if UART_BOOT_PROFILE
+static volatile uint32_t marks_valid;
+static uint32_t mark_cycles[UART_BOOT_MARK_COUNT];
+static uint32_t mark_hz[UART_BOOT_MARK_COUNT];
+#endif
+
+/**** Public Functions ****/
+
+#if UART_FAST_BOOT
+/**
+ * @brief Bring USART2 up with LL register writes and arm the rings
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if HSI16 did not start
+ */
+UART_ErrorTypeDef UART_Boot_FastInit(void)
+{
+    uint32_t timeout = HSI_READY_TIMEOUT;
+
+    // HSI16 kernel clock: the baud rate holds while SystemClock_Config() switches SYSCLK
+    LL_RCC_HSI_Enable();
+    while (!LL_RCC_HSI_IsReady()) {
+        if (--timeout == 0) {
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+    LL_RCC_SetUSARTClockSource(LL_RCC_USART2_CLKSOURCE_HSI);
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USART2);
+    LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_GPIOA);
+
+    // Same pin setup as HAL_UART_MspInit(); mode last so the pin switches with its AF ready
+    LL_GPIO_SetAFPin_0_7(VCP_TX_GPIO_Port, VCP_TX_Pin, LL_GPIO_AF_7);
+    LL_GPIO_SetAFPin_8_15(VCP_RX_GPIO_Port, VCP_RX_Pin, LL_GPIO_AF_3);
+    LL_GPIO_SetPinSpeed(VCP_TX_GPIO_Port, VCP_TX_Pin, LL_GPIO_SPEED_FREQ_VERY_HIGH);
+    LL_GPIO_SetPinSpeed(VCP_RX_GPIO_Port, VCP_RX_Pin, LL_GPIO_SPEED_FREQ_VERY_HIGH);
+    LL_GPIO_SetPinPull(VCP_RX_GPIO_Port, VCP_RX_Pin, LL_GPIO_PULL_NO);   // PA15 resets with JTDI pull-up
+    LL_GPIO_SetPinMode(VCP_TX_GPIO_Port, VCP_TX_Pin, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinMode(VCP_RX_GPIO_Port, VCP_RX_Pin, LL_GPIO_MODE_ALTERNATE);
+
+    // 8N1, oversampling by 16 and no flow control are the register reset values
+    USART2->BRR = (USART_KERNEL_HZ + UART_BAUD_RATE / 2U) / UART_BAUD_RATE;
+    USART2->CR1 = USART_CR1_TE | USART_CR1_RE | USART_CR1_UE;
+
+    // The handle the rest of the driver (and HAL calls such as HAL_HalfDuplex_Init) expects
+    huart2.Instance = USART2;
+    huart2.Init.BaudRate = UART_BAUD_RATE;
+    huart2.Init.WordLength = UART_WORDLENGTH_8B;
+    huart2.Init.StopBits = UART_STOPBITS_1;
+    huart2.Init.Parity = UART_PARITY_NONE;
+    huart2.Init.Mode = UART_MODE_TX_RX;
+    huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    huart2.Init.OverSampling = UART_OVERSAMPLING_16;
+    huart2.Init.OneBitSampling = UART_ONE_BIT_SAMPLE_DISABLE;
+    huart2.AdvancedInit.AdvFeatureInit = UART_ADVFEATURE_NO_INIT;
+    huart2.gState = HAL_UART_STATE_READY;
+    huart2.RxState = HAL_UART_STATE_READY;
+
+    NVIC_SetPriority(USART2_IRQn, 0);
+    NVIC_EnableIRQ(USART2_IRQn);
+
+    return UART_RingBuff_Init();
+}
+#endif /* UART_FAST_BOOT */
+
+/**
+ * @brief Record a boot milestone, first occurrence only
+ * @param mark Milestone
+ */
+void UART_Boot_Mark(UART_BootMarkTypeDef mark)
+{
+#if UART_BOOT_PROFILE
+    uint32_t bit = 1UL << mark;
+
+    if (mark >= UART_BOOT_MARK_COUNT || (marks_valid & bit) != 0U) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if ((marks_valid & bit) == 0U) {
+        mark_cycles[mark] = DWT->CYCCNT;
+        mark_hz[mark] = SystemCoreClock;
+        marks_valid |= bit;
+    }
+    __set_PRIMASK(primask);
+#else
+    (void)mark;
+#endif
+}
+
+/**
+ * @brief Milestones recorded so far
+ * @return Bit (1 << mark) per recorded mark
+ */
+uint32_t UART_Boot_GetMarks(void)
+{
+#if UART_BOOT_PROFILE
+    return marks_valid;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Forget milestones recorded since a UART_Boot_GetMarks() snapshot
+ * @param keep Snapshot from UART_Boot_GetMarks()
+ */
+void UART_Boot_RestoreMarks(uint32_t keep)
+{
+#if UART_BOOT_PROFILE
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    marks_valid &= keep;
+    __set_PRIMASK(primask);
+#else
+    (void)keep;
+#endif
+}
+
+/**
+ * @brief Convert the recorded milestones to microseconds since reset
+ * @param out Destination for the report
+ * @note Each interval is converted at the core clock in effect at its start,
+ *       so the interval spanning SystemClock_Config() is counted at 4 MHz
+ */
+void UART_Boot_GetReport(UART_BootReportTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+
+#if UART_BOOT_PROFILE
+    uint8_t order[UART_BOOT_MARK_COUNT];
+    uint8_t count = 0;
+    uint32_t valid = marks_valid;
+
+    // Insertion sort by cycle count; the marks do not occur in enum order
+    for (uint8_t m = 0; m < UART_BOOT_MARK_COUNT; m++) {
+        if ((valid & (1UL << m)) == 0U) {
+            continue;
+        }
+        uint8_t i = count++;
+        while (i > 0U && mark_cycles[order[i - 1U]] > mark_cycles[m]) {
+            order[i] = order[i - 1U];
+            i--;
+        }
+        order[i] = m;
+    }
+
+    uint64_t us = 0;
+    uint32_t prev_cycles = 0;
+    uint32_t prev_hz = RESET_CORE_HZ;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t m = order[i];
+        us += ((uint64_t)(mark_cycles[m] - prev_cycles) * 1000000ULL) / prev_hz;
+        out->us[m] = (uint32_t)us;
+        prev_cycles = mark_cycles[m];
+        prev_hz = mark_hz[m];
+    }
+    out->valid = valid;
+#endif
+}
@@ -0,0 +1,610 @@
+/*
+ * uart_cbor.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_cbor.h"
+#include <string.h>
+
+#if UART_CBOR_ENABLE_BENCHMARK
+#include <stdio.h>
+#include "uart_timebase.h"
+#endif
+
+/**** Configuration Section ****/
+#define MAJOR_UINT      0U
+#define MAJOR_NINT      1U
+#define MAJOR_BYTES     2U
+#define MAJOR_TEXT      3U
+#define MAJOR_ARRAY     4U
+#define MAJOR_MAP       5U
+#define MAJOR_TAG       6U
+#define MAJOR_SIMPLE    7U
+
+#define AI_UINT8        24U     // Additional info: argument follows in 1/2/4/8 bytes
+#define AI_UINT16       25U
+#define AI_UINT32       26U
+#define AI_UINT64       27U
+
+#define SIMPLE_FALSE    20U
+#define SIMPLE_TRUE     21U
+#define SIMPLE_NULL     22U
+#define SIMPLE_UNDEF    23U
+
+/**** Type Definitions ****/
+#if UART_CBOR_ENABLE_BENCHMARK
+typedef struct {
+    uint32_t seq;
+    uint32_t tick;
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;
+    uint32_t errors;
+    int32_t temp_centi;
+    uint16_t vbat_mv[3];
+} TelemetryRecordTypeDef;
+#endif
+
+/**** Private Variables ****/
+#if UART_CBOR_ENABLE_BENCHMARK
+static const TelemetryRecordTypeDef bench_records[] = {
+    { 1U,      1000U,     12U,      340U,      0U,  2315,  { 3300U, 3312U, 3298U } },
+    { 2U,      2000U,     512U,     4096U,     0U,  2318,  { 3301U, 3310U, 3297U } },
+    { 17U,     60000U,    65535U,   70000U,    1U,  -512,  { 3280U, 3295U, 3276U } },
+    { 250U,    3600000U,  1048576U, 2097152U,  3U,  0,     { 3100U, 3120U, 3090U } },
+};
+#define BENCH_RECORDS (sizeof(bench_records) / sizeof(bench_records[0]))
+#endif
+
+/**** Private Function Prototypes ****/
+static UART_ErrorTypeDef Put(UART_CborEncoderTypeDef *enc, const uint8_t *data, uint16_t len);
+static UART_ErrorTypeDef EncodeHead(UART_CborEncoderTypeDef *enc, uint8_t major, uint32_t value);
+static inline uint32_t SliceLength(const UART_SliceTypeDef *slice);
+static inline uint8_t ByteAt(const UART_SliceTypeDef *slice, uint32_t pos);
+static void SubSlice(const UART_SliceTypeDef *slice, uint32_t pos, uint32_t len, UART_SliceTypeDef *out);
+static float HalfToFloat(uint16_t half);
+#if UART_CBOR_ENABLE_BENCHMARK
+static UART_ErrorTypeDef EncodeRecord(UART_CborEncoderTypeDef *enc, const TelemetryRecordTypeDef *record);
+#endif
+
+/**** Public Functions ****/
+
+/**
+ * @brief Start encoding
+ * @param enc Encoder
+ * @param buf Destination, NULL to only compute the size
+ * @param size Capacity of buf
+ */
+void UART_Cbor_EncoderInit(UART_CborEncoderTypeDef *enc, uint8_t *buf, uint16_t size)
+{
+    enc->buf = buf;
+    enc->size = (buf != NULL) ? size : 0U;
+    enc->len = 0;
+}
+
+/**
+ * @brief Encode an unsigned integer in the shortest form
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeUint(UART_CborEncoderTypeDef *enc, uint32_t value)
+{
+    return EncodeHead(enc, MAJOR_UINT, value);
+}
+
+/**
+ * @brief Encode a signed integer in the shortest form
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeInt(UART_CborEncoderTypeDef *enc, int32_t value)
+{
+    if (value < 0) {
+        return EncodeHead(enc, MAJOR_NINT, ~(uint32_t)value);    // -1 - value
+    }
+    return EncodeHead(enc, MAJOR_UINT, (uint32_t)value);
+}
+
+/**
+ * @brief Encode a single-precision float
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeFloat(UART_CborEncoderTypeDef *enc, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint8_t item[5] = {
+        (uint8_t)((MAJOR_SIMPLE << 5) | AI_UINT32),
+        (uint8_t)(bits >> 24), (uint8_t)(bits >> 16), (uint8_t)(bits >> 8), (uint8_t)bits
+    };
+    return Put(enc, item, sizeof(item));
+}
+
+/**
+ * @brief Encode true or false
+ * @param enc Encoder
+ * @param value Value
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeBool(UART_CborEncoderTypeDef *enc, bool value)
+{
+    return EncodeHead(enc, MAJOR_SIMPLE, value ? SIMPLE_TRUE : SIMPLE_FALSE);
+}
+
+/**
+ * @brief Encode null
+ * @param enc Encoder
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeNull(UART_CborEncoderTypeDef *enc)
+{
+    return EncodeHead(enc, MAJOR_SIMPLE, SIMPLE_NULL);
+}
+
+/**
+ * @brief Encode a byte string
+ * @param enc Encoder
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeBytes(UART_CborEncoderTypeDef *enc, const uint8_t *data, uint16_t len)
+{
+    UART_ErrorTypeDef result = EncodeHead(enc, MAJOR_BYTES, len);
+    UART_ErrorTypeDef payload = Put(enc, data, len);
+    return (result != UART_SUCCESS) ? result : payload;
+}
+
+/**
+ * @brief Encode a NUL-terminated UTF-8 text string
+ * @param enc Encoder
+ * @param text String
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeText(UART_CborEncoderTypeDef *enc, const char *text)
+{
+    uint16_t len = (uint16_t)strlen(text);
+    UART_ErrorTypeDef result = EncodeHead(enc, MAJOR_TEXT, len);
+    UART_ErrorTypeDef payload = Put(enc, (const uint8_t *)text, len);
+    return (result != UART_SUCCESS) ? result : payload;
+}
+
+/**
+ * @brief Encode an array header
+ * @param enc Encoder
+ * @param count Number of elements
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeArray(UART_CborEncoderTypeDef *enc, uint32_t count)
+{
+    return EncodeHead(enc, MAJOR_ARRAY, count);
+}
+
+/**
+ * @brief Encode a map header
+ * @param enc Encoder
+ * @param count Number of pairs
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL once the buffer has overflowed
+ */
+UART_ErrorTypeDef UART_Cbor_EncodeMap(UART_CborEncoderTypeDef *enc, uint32_t count)
+{
+    return EncodeHead(enc, MAJOR_MAP, count);
+}
+
+/**
+ * @brief Start decoding a slice
+ * @param dec Decoder
+ * @param slice Input
+ */
+void UART_Cbor_DecoderInit(UART_CborDecoderTypeDef *dec, const UART_SliceTypeDef *slice)
+{
+    dec->slice = *slice;
+    dec->pos = 0;
+}
+
+/**
+ * @brief Decode the next item
+ * @param dec Decoder
+ * @param item Pointer to store the item
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if incomplete,
+ *         UART_ERROR_INVALID_DATA if malformed or unsupported
+ */
+UART_ErrorTypeDef UART_Cbor_Next(UART_CborDecoderTypeDef *dec, UART_CborItemTypeDef *item)
+{
+    const UART_SliceTypeDef *slice = &dec->slice;
+    uint32_t pos = dec->pos;
+    uint32_t avail = SliceLength(slice) - pos;
+    uint32_t extra;
+    uint64_t arg;
+
+    if (avail == 0U) {
+        return UART_ERROR_BUFFER_EMPTY;
+    }
+
+    uint8_t initial = ByteAt(slice, pos++);
+    uint8_t major = initial >> 5;
+    uint8_t ai = initial & 0x1FU;
+
+    if (ai < AI_UINT8) {
+        extra = 0;
+        arg = ai;
+    } else if (ai <= AI_UINT64) {
+        extra = 1U << (ai - AI_UINT8);
+        arg = 0;
+    } else {
+        return UART_ERROR_INVALID_DATA;     // Reserved or indefinite length
+    }
+
+    if (avail - 1U < extra) {
+        return UART_ERROR_BUFFER_EMPTY;
+    }
+    for (uint32_t i = 0; i < extra; i++) {
+        arg = (arg << 8) | ByteAt(slice, pos++);   // Big endian
+    }
+    avail -= 1U + extra;
+
+    memset(&item->data, 0, sizeof(item->data));
+    item->u = arg;
+
+    switch (major) {
+    case MAJOR_UINT:
+        item->type = UART_CBOR_UINT;
+        break;
+
+    case MAJOR_NINT:
+        if (arg > (uint64_t)INT64_MAX) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        item->type = UART_CBOR_NINT;
+        item->i = -1 - (int64_t)arg;
+        break;
+
+    case MAJOR_BYTES:
+    case MAJOR_TEXT:
+        if (arg > UINT16_MAX) {
+            return UART_ERROR_INVALID_DATA;     // Longer than any slice
+        }
+        if (arg > avail) {
+            return UART_ERROR_BUFFER_EMPTY;
+        }
+        item->type = (major == MAJOR_BYTES) ? UART_CBOR_BYTES : UART_CBOR_TEXT;
+        SubSlice(slice, pos, (uint32_t)arg, &item->data);
+        pos += (uint32_t)arg;
+        break;
+
+    case MAJOR_ARRAY:
+        item->type = UART_CBOR_ARRAY;
+        break;
+
+    case MAJOR_MAP:
+        item->type = UART_CBOR_MAP;
+        break;
+
+    case MAJOR_TAG:
+        item->type = UART_CBOR_TAG;
+        break;
+
+    default:
+        if (ai == AI_UINT16) {
+            item->type = UART_CBOR_FLOAT;
+            item->f = HalfToFloat((uint16_t)arg);
+        } else if (ai == AI_UINT32) {
+            uint32_t bits = (uint32_t)arg;
+            item->type = UART_CBOR_FLOAT;
+            memcpy(&item->f, &bits, sizeof(bits));
+        } else if (ai == AI_UINT64) {
+            double d;
+            memcpy(&d, &arg, sizeof(d));
+            item->type = UART_CBOR_FLOAT;
+            item->f = (float)d;
+        } else if (ai == AI_UINT8 && arg < 32U) {
+            return UART_ERROR_INVALID_DATA;     // Two-byte form of a one-byte simple value
+        } else if (arg == SIMPLE_FALSE || arg == SIMPLE_TRUE) {
+            item->type = UART_CBOR_BOOL;
+            item->b = (arg == SIMPLE_TRUE);
+        } else if (arg == SIMPLE_NULL) {
+            item->type = UART_CBOR_NULL;
+        } else if (arg == SIMPLE_UNDEF) {
+            item->type = UART_CBOR_UNDEFINED;
+        } else {
+            return UART_ERROR_INVALID_DATA;     // Unassigned simple value
+        }
+        break;
+    }
+
+    dec->pos = (uint16_t)pos;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Skip the next item including everything nested in it
+ * @param dec Decoder
+ * @return As UART_Cbor_Next(); on error dec is unchanged
+ */
+UART_ErrorTypeDef UART_Cbor_Skip(UART_CborDecoderTypeDef *dec)
+{
+    uint16_t start = dec->pos;
+    uint32_t pending = 1;
+    UART_CborItemTypeDef item;
+    UART_ErrorTypeDef result;
+
+    while (pending > 0U) {
+        if ((result = UART_Cbor_Next(dec, &item)) != UART_SUCCESS) {
+            dec->pos = start;
+            return result;
+        }
+        pending--;
+
+        if (item.type == UART_CBOR_ARRAY || item.type == UART_CBOR_MAP) {
+            uint32_t per = (item.type == UART_CBOR_MAP) ? 2U : 1U;
+            // Each item takes at least a byte and dec->pos is 16 bits, so more can never complete
+            if (item.u > (UINT16_MAX - pending) / per) {
+                dec->pos = start;
+                return UART_ERROR_INVALID_DATA;
+            }
+            pending += per * (uint32_t)item.u;
+        } else if (item.type == UART_CBOR_TAG) {
+            pending++;
+        }
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Copy the payload of a BYTES or TEXT item
+ * @param item Decoded item
+ * @param dst Destination
+ * @param size Capacity of dst
+ * @return Bytes copied
+ */
+uint16_t UART_Cbor_Copy(const UART_CborItemTypeDef *item, uint8_t *dst, uint16_t size)
+{
+    uint16_t copied = 0;
+
+    for (uint32_t i = 0; i < 2U && copied < size; i++) {
+        uint16_t n = item->data.len[i];
+        if (n > size - copied) {
+            n = (uint16_t)(size - copied);
+        }
+        if (n > 0U) {
+            memcpy(&dst[copied], item->data.part[i], n);
+            copied = (uint16_t)(copied + n);
+        }
+    }
+
+    return copied;
+}
+
+/**
+ * @brief Compare a TEXT item with a NUL-terminated string
+ * @param item Decoded item
+ * @param text String
+ * @return true if equal, false otherwise
+ */
+bool UART_Cbor_TextEquals(const UART_CborItemTypeDef *item, const char *text)
+{
+    uint32_t len0 = item->data.len[0];
+
+    if (item->type != UART_CBOR_TEXT || strlen(text) != len0 + item->data.len[1]) {
+        return false;
+    }
+
+    return (len0 == 0U || memcmp(item->data.part[0], text, len0) == 0) &&
+           (item->data.len[1] == 0U || memcmp(item->data.part[1], &text[len0], item->data.len[1]) == 0);
+}
+
+#if UART_CBOR_ENABLE_BENCHMARK
+/**
+ * @brief Encode the same telemetry record as CBOR and as snprintf() JSON
+ * @param result Pointer to store sizes and DWT cycle counts
+ */
+void UART_Cbor_Benchmark(UART_CborBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    static uint8_t cbor[96];
+    static char json[160];
+    UART_CborEncoderTypeDef enc;
+    volatile uint32_t sink = 0;
+    uint32_t start;
+    uint32_t primask = __get_PRIMASK();
+
+    result->records = BENCH_RECORDS;
+
+    // Interrupts masked so the UART ISR does not land inside a measurement
+    __disable_irq();
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        UART_Cbor_EncoderInit(&enc, NULL, 0);       // Size pass, as for a reserved frame
+        EncodeRecord(&enc, &bench_records[i]);
+        UART_Cbor_EncoderInit(&enc, cbor, sizeof(cbor));
+        if (EncodeRecord(&enc, &bench_records[i]) != UART_SUCCESS) {
+            enc.len = 0;
+            break;
+        }
+        sink += enc.len;
+    }
+    result->cbor_cycles = UART_TIME_CYCLES() - start;
+    result->cbor_bytes = enc.len;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        const TelemetryRecordTypeDef *r = &bench_records[i];
+        int n = snprintf(json, sizeof(json),
+                         "{\"seq\":%lu,\"tick\":%lu,\"rx\":%lu,\"tx\":%lu,\"err\":%lu,"
+                         "\"temp_c\":%ld,\"vbat_mv\":[%u,%u,%u]}",
+                         (unsigned long)r->seq, (unsigned long)r->tick,
+                         (unsigned long)r->rx_bytes, (unsigned long)r->tx_bytes,
+                         (unsigned long)r->errors, (long)r->temp_centi,
+                         r->vbat_mv[0], r->vbat_mv[1], r->vbat_mv[2]);
+        sink += (uint32_t)n;
+        result->json_bytes = (uint32_t)n;
+    }
+    result->json_cycles = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+    (void)sink;
+}
+#endif /* UART_CBOR_ENABLE_BENCHMARK */
+
+/**** Private Functions ****/
+
+/**
+ * @brief Append bytes, or only count them when sizing
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL if they do not fit
+ */
+static UART_ErrorTypeDef Put(UART_CborEncoderTypeDef *enc, const uint8_t *data, uint16_t len)
+{
+    uint16_t at = enc->len;
+
+    enc->len = (uint16_t)(at + len);
+    if (enc->buf == NULL || len == 0U) {
+        return UART_SUCCESS;
+    }
+    if (at > enc->size || len > enc->size - at) {
+        return UART_ERROR_BUFFER_FULL;
+    }
+
+    memcpy(&enc->buf[at], data, len);
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Encode an initial byte with its argument in the shortest form
+ */
+static UART_ErrorTypeDef EncodeHead(UART_CborEncoderTypeDef *enc, uint8_t major, uint32_t value)
+{
+    uint8_t head[5];
+    uint16_t len;
+
+    if (value < AI_UINT8) {
+        head[0] = (uint8_t)((major << 5) | value);
+        len = 1;
+    } else if (value <= UINT8_MAX) {
+        head[0] = (uint8_t)((major << 5) | AI_UINT8);
+        head[1] = (uint8_t)value;
+        len = 2;
+    } else if (value <= UINT16_MAX) {
+        head[0] = (uint8_t)((major << 5) | AI_UINT16);
+        head[1] = (uint8_t)(value >> 8);
+        head[2] = (uint8_t)value;
+        len = 3;
+    } else {
+        head[0] = (uint8_t)((major << 5) | AI_UINT32);
+        head[1] = (uint8_t)(value >> 24);
+        head[2] = (uint8_t)(value >> 16);
+        head[3] = (uint8_t)(value >> 8);
+        head[4] = (uint8_t)value;
+        len = 5;
+    }
+
+    return Put(enc, head, len);
+}
+
+/**
+ * @brief Total bytes in both parts of a slice
+ */
+static inline uint32_t SliceLength(const UART_SliceTypeDef *slice)
+{
+    return (uint32_t)slice->len[0] + slice->len[1];
+}
+
+/**
+ * @brief Read one byte of a slice
+ */
+static inline uint8_t ByteAt(const UART_SliceTypeDef *slice, uint32_t pos)
+{
+    if (pos < slice->len[0]) {
+        return slice->part[0][pos];
+    }
+    return slice->part[1][pos - slice->len[0]];
+}
+
+/**
+ * @brief Describe a range of a slice as a slice of its own
+ */
+static void SubSlice(const UART_SliceTypeDef *slice, uint32_t pos, uint32_t len, UART_SliceTypeDef *out)
+{
+    if (pos < slice->len[0]) {
+        uint32_t first = slice->len[0] - pos;
+        if (first > len) {
+            first = len;
+        }
+        out->part[0] = &slice->part[0][pos];
+        out->len[0] = (uint16_t)first;
+        out->part[1] = (len > first) ? slice->part[1] : NULL;
+        out->len[1] = (uint16_t)(len - first);
+    } else {
+        out->part[0] = &slice->part[1][pos - slice->len[0]];
+        out->len[0] = (uint16_t)len;
+        out->part[1] = NULL;
+        out->len[1] = 0;
+    }
+}
+
+/**
+ * @brief Widen an IEEE 754 half-precision value
+ */
+static float HalfToFloat(uint16_t half)
+{
+    uint32_t sign = (uint32_t)(half & 0x8000U) << 16;
+    uint32_t exponent = (half >> 10) & 0x1FU;
+    uint32_t mantissa = half & 0x3FFU;
+    uint32_t bits;
+    float f;
+
+    if (exponent == 0U) {
+        f = (float)mantissa * 5.9604645e-8f;    // Subnormal: mantissa * 2^-24
+        return sign ? -f : f;
+    }
+
+    if (exponent == 0x1FU) {
+        bits = sign | 0x7F800000U | (mantissa << 13);   // Inf or NaN
+    } else {
+        bits = sign | ((exponent + 112U) << 23) | (mantissa << 13);
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+#if UART_CBOR_ENABLE_BENCHMARK
+/**
+ * @brief Encode one telemetry record with the same keys as the JSON form
+ * @return UART_SUCCESS, or UART_ERROR_BUFFER_FULL if the record did not fit
+ */
+static UART_ErrorTypeDef EncodeRecord(UART_CborEncoderTypeDef *enc, const TelemetryRecordTypeDef *record)
+{
+    UART_Cbor_EncodeMap(enc, 7);
+    UART_Cbor_EncodeText(enc, "seq");
+    UART_Cbor_EncodeUint(enc, record->seq);
+    UART_Cbor_EncodeText(enc, "tick");
+    UART_Cbor_EncodeUint(enc, record->tick);
+    UART_Cbor_EncodeText(enc, "rx");
+    UART_Cbor_EncodeUint(enc, record->rx_bytes);
+    UART_Cbor_EncodeText(enc, "tx");
+    UART_Cbor_EncodeUint(enc, record->tx_bytes);
+    UART_Cbor_EncodeText(enc, "err");
+    UART_Cbor_EncodeUint(enc, record->errors);
+    UART_Cbor_EncodeText(enc, "temp_c");
+    UART_Cbor_EncodeInt(enc, record->temp_centi);
+    UART_Cbor_EncodeText(enc, "vbat_mv");
+    UART_Cbor_EncodeArray(enc, 3);
+    for (uint32_t i = 0; i < 3U; i++) {
+        UART_Cbor_EncodeUint(enc, record->vbat_mv[i]);
+    }
+
+    // Overflow is sticky, so the length tells for every call above
+    return (enc->buf != NULL && enc->len > enc->size) ? UART_ERROR_BUFFER_FULL : UART_SUCCESS;
+}
+#endif
@@ -0,0 +1,347 @@
+/*
+ * uart_checksum.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_checksum.h"
+#include "uart_word.h"
+#include <string.h>
+#if UART_CHECKSUM_ENABLE_BENCHMARK
+#include "uart_timebase.h"
+#endif
+
+/**** Configuration Section ****/
+#define ADLER_MOD        65521U
+#define BYTE_BLOCK       5552U      // Bytes per reduction that keep 32-bit sums exact (zlib NMAX)
+#define FLETCHER32_BLOCK 716U       // 358 16-bit words per reduction
+#define BENCH_BYTES      256U
+
+/**** Private Variables ****/
+#if UART_CHECKSUM_ENABLE_BENCHMARK
+static uint8_t bench_data[BENCH_BYTES];
+#endif
+
+/**** Private Function Prototypes ****/
+static void WeightedSums(uint32_t *pa, uint32_t *pb, const uint8_t *p, size_t len);
+static void UpdateModular(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len, uint32_t mod);
+static void UpdateFletcher32(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len);
+static void UpdateXor(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len);
+static void UpdateSum(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Start a checksum
+ * @param ctx Accumulator
+ * @param algo Algorithm
+ */
+void UART_Checksum_Init(UART_ChecksumTypeDef *ctx, UART_ChecksumAlgoTypeDef algo)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->algo = algo;
+    if (algo == UART_CHECKSUM_ADLER32) {
+        ctx->a = 1;
+    }
+}
+
+/**
+ * @brief Add a block of bytes
+ * @param ctx Accumulator
+ * @param data Bytes, any alignment
+ * @param len Number of bytes
+ */
+void UART_Checksum_Update(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len)
+{
+    if (data == NULL || len == 0) {
+        return;
+    }
+
+    switch (ctx->algo) {
+    case UART_CHECKSUM_FLETCHER16:
+        UpdateModular(ctx, data, len, 255U);
+        break;
+    case UART_CHECKSUM_FLETCHER32:
+        UpdateFletcher32(ctx, data, len);
+        break;
+    case UART_CHECKSUM_ADLER32:
+        UpdateModular(ctx, data, len, ADLER_MOD);
+        break;
+    case UART_CHECKSUM_XOR8:
+        UpdateXor(ctx, data, len);
+        break;
+    case UART_CHECKSUM_SUM8:
+        UpdateSum(ctx, data, len);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Get the checksum of everything added so far
+ * @param ctx Accumulator
+ * @return Checksum in the low UART_CHECKSUM_SIZE(algo) bytes
+ */
+uint32_t UART_Checksum_Value(const UART_ChecksumTypeDef *ctx)
+{
+    uint32_t a = ctx->a;
+    uint32_t b = ctx->b;
+
+    switch (ctx->algo) {
+    case UART_CHECKSUM_FLETCHER16:
+        return (b << 8) | a;
+    case UART_CHECKSUM_FLETCHER32:
+        if (ctx->has_odd_byte) {
+            // A trailing odd byte counts as a word with a zero high byte
+            a = (a + ctx->odd_byte) % 65535U;
+            b = (b + a) % 65535U;
+        }
+        return (b << 16) | a;
+    case UART_CHECKSUM_ADLER32:
+        return (b << 16) | a;
+    case UART_CHECKSUM_XOR8:
+        a ^= a >> 16;
+        a ^= a >> 8;
+        return a & 0xFFU;
+    case UART_CHECKSUM_SUM8:
+        return a & 0xFFU;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Checksum a single buffer
+ * @param algo Algorithm
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return Checksum
+ */
+uint32_t UART_Checksum_Compute(UART_ChecksumAlgoTypeDef algo, const uint8_t *data, size_t len)
+{
+    UART_ChecksumTypeDef ctx;
+
+    UART_Checksum_Init(&ctx, algo);
+    UART_Checksum_Update(&ctx, data, len);
+    return UART_Checksum_Value(&ctx);
+}
+
+#if UART_CHECKSUM_ENABLE_BENCHMARK
+/**
+ * @brief Byte-at-a-time Fletcher-16 with a modulo per byte, as the framing layer used to do
+ */
+static uint32_t Fletcher16Bytewise(const uint8_t *data, size_t len)
+{
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        sum1 = (sum1 + data[i]) % 255U;
+        sum2 = (sum2 + sum1) % 255U;
+    }
+
+    return (sum2 << 8) | sum1;
+}
+
+/**
+ * @brief Measure every algorithm over the same buffer
+ * @param result Pointer to store DWT cycle counts
+ */
+void UART_Checksum_Benchmark(UART_ChecksumBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    volatile uint32_t sink;
+    uint32_t start;
+    uint32_t primask = __get_PRIMASK();
+
+    for (uint32_t i = 0; i < BENCH_BYTES; i++) {
+        bench_data[i] = (uint8_t)(i * 37U + 11U);
+    }
+    result->bytes = BENCH_BYTES;
+
+    // Interrupts masked so the UART ISR does not land inside a measurement
+    __disable_irq();
+
+    for (uint32_t algo = 0; algo < UART_CHECKSUM_COUNT; algo++) {
+        start = UART_TIME_CYCLES();
+        sink = UART_Checksum_Compute((UART_ChecksumAlgoTypeDef)algo, bench_data, BENCH_BYTES);
+        result->cycles[algo] = UART_TIME_CYCLES() - start;
+        result->centicycles_per_byte[algo] = (result->cycles[algo] * 100U) / BENCH_BYTES;
+    }
+
+    start = UART_TIME_CYCLES();
+    sink = Fletcher16Bytewise(bench_data, BENCH_BYTES);
+    result->fletcher16_bytewise_cycles = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+    (void)sink;
+}
+#endif /* UART_CHECKSUM_ENABLE_BENCHMARK */
+
+/**** Private Functions ****/
+
+/**
+ * @brief Running byte sum and sum of running sums, without reduction
+ * @param pa Byte sum, updated
+ * @param pb Sum of running byte sums, updated
+ * @param p Bytes
+ * @param len Number of bytes, at most BYTE_BLOCK
+ */
+static void WeightedSums(uint32_t *pa, uint32_t *pb, const uint8_t *p, size_t len)
+{
+    uint32_t a = *pa;
+    uint32_t b = *pb;
+    size_t i = 0;
+
+    // Four bytes x0..x3 add x0+x1+x2+x3 to a and 4a + 4x0+3x1+2x2+x3 to b
+    for (; i + 4U <= len; i += 4U) {
+        uint32_t w = UART_LoadWord(&p[i]);
+#if defined(__ARM_FEATURE_SIMD32)
+        uint32_t weighted = __SMLAD(__UXTB16(w >> 8), 0x00010003U, __SMUAD(__UXTB16(w), 0x00020004U));
+        b += 4U * a + weighted;
+        a = __USADA8(w, 0U, a);
+#else
+        uint32_t x0 = w & 0xFFU;
+        uint32_t x1 = (w >> 8) & 0xFFU;
+        uint32_t x2 = (w >> 16) & 0xFFU;
+        uint32_t x3 = w >> 24;
+        b += 4U * a + 4U * x0 + 3U * x1 + 2U * x2 + x3;
+        a += x0 + x1 + x2 + x3;
+#endif
+    }
+
+    for (; i < len; i++) {
+        a += p[i];
+        b += a;
+    }
+
+    *pa = a;
+    *pb = b;
+}
+
+/**
+ * @brief Fletcher-16 / Adler-32 update, one modulo per block instead of per byte
+ * @param ctx Accumulator
+ * @param data Bytes
+ * @param len Number of bytes
+ * @param mod 255 or 65521
+ */
+static void UpdateModular(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len, uint32_t mod)
+{
+    while (len > 0) {
+        size_t n = (len < BYTE_BLOCK) ? len : BYTE_BLOCK;
+
+        WeightedSums(&ctx->a, &ctx->b, data, n);
+        ctx->a %= mod;
+        ctx->b %= mod;
+
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * @brief Fletcher-32 update over little-endian 16-bit words
+ * @param ctx Accumulator
+ * @param data Bytes
+ * @param len Number of bytes
+ */
+static void UpdateFletcher32(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len)
+{
+    uint32_t a = ctx->a;
+    uint32_t b = ctx->b;
+
+    if (ctx->has_odd_byte) {
+        a += ctx->odd_byte | ((uint32_t)*data << 8);
+        b += a;
+        ctx->has_odd_byte = false;
+        data++;
+        len--;
+        a %= 65535U;
+        b %= 65535U;
+    }
+
+    while (len >= 2U) {
+        size_t n = (len < FLETCHER32_BLOCK) ? (len & ~(size_t)1U) : FLETCHER32_BLOCK;
+        size_t i = 0;
+
+        // Two words h0, h1 add h0+h1 to a and 2a + 2h0+h1 to b
+        for (; i + 4U <= n; i += 4U) {
+            uint32_t w = UART_LoadWord(&data[i]);
+            uint32_t h0 = w & 0xFFFFU;
+            uint32_t h1 = w >> 16;
+            b += 2U * a + 2U * h0 + h1;
+            a += h0 + h1;
+        }
+        if (i < n) {
+            a += data[i] | ((uint32_t)data[i + 1U] << 8);
+            b += a;
+        }
+
+        a %= 65535U;
+        b %= 65535U;
+        data += n;
+        len -= n;
+    }
+
+    if (len != 0) {
+        ctx->odd_byte = *data;
+        ctx->has_odd_byte = true;
+    }
+
+    ctx->a = a;
+    ctx->b = b;
+}
+
+/**
+ * @brief XOR update; lanes are folded together only in Value()
+ * @param ctx Accumulator
+ * @param data Bytes
+ * @param len Number of bytes
+ */
+static void UpdateXor(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len)
+{
+    uint32_t x = ctx->a;
+    size_t i = 0;
+
+    for (; i + 4U <= len; i += 4U) {
+        x ^= UART_LoadWord(&data[i]);
+    }
+    for (; i < len; i++) {
+        x ^= data[i];
+    }
+
+    ctx->a = x;
+}
+
+/**
+ * @brief Byte sum update
+ * @param ctx Accumulator
+ * @param data Bytes
+ * @param len Number of bytes
+ */
+static void UpdateSum(UART_ChecksumTypeDef *ctx, const uint8_t *data, size_t len)
+{
+    uint32_t s = ctx->a;
+    size_t i = 0;
+
+    for (; i + 4U <= len; i += 4U) {
+        uint32_t w = UART_LoadWord(&data[i]);
+#if defined(__ARM_FEATURE_SIMD32)
+        s = __USADA8(w, 0U, s);     // |x - 0| summed over four lanes
+#else
+        s += (w & 0xFFU) + ((w >> 8) & 0xFFU) + ((w >> 16) & 0xFFU) + (w >> 24);
+#endif
+    }
+    for (; i < len; i++) {
+        s += data[i];
+    }
+
+    ctx->a = s;
+}
@@ -0,0 +1,394 @@
+/*
+ * uart_clock_gov.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_clock_gov.h"
+#include "uart_timebase.h"
+#include "uart_timer.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define HSI_READY_TIMEOUT   1000U       // Loop iterations, HSI starts in a few us
+#define SWITCH_TIMEOUT      10000U      // Loop iterations waiting for SWS / latency / TC
+
+extern UART_HandleTypeDef huart2;
+
+/**** Type Definitions ****/
+typedef struct {
+    uint32_t hz;
+    uint32_t sw;                // RCC_CFGR_SW value
+    uint32_t sws;               // RCC_CFGR_SWS value once switched
+    uint32_t voltage;           // PWR_REGULATOR_VOLTAGE_SCALEx
+    uint32_t latency;           // FLASH_LATENCY_x for hz at this voltage
+} ProfileTypeDef;
+
+/**** Private Variables ****/
+static const ProfileTypeDef profiles[UART_CLOCK_PROFILE_COUNT] = {
+    [UART_CLOCK_PROFILE_LOW]  = { 4000000UL,  RCC_CFGR_SW_MSI, RCC_CFGR_SWS_MSI, PWR_REGULATOR_VOLTAGE_SCALE2, FLASH_LATENCY_0 },
+    [UART_CLOCK_PROFILE_MID]  = { 16000000UL, RCC_CFGR_SW_HSI, RCC_CFGR_SWS_HSI, PWR_REGULATOR_VOLTAGE_SCALE2, FLASH_LATENCY_2 },
+    [UART_CLOCK_PROFILE_HIGH] = { 80000000UL, RCC_CFGR_SW_PLL, RCC_CFGR_SWS_PLL, PWR_REGULATOR_VOLTAGE_SCALE1, FLASH_LATENCY_4 },
+};
+
+static UART_ClockGovStatsTypeDef gov_stats;
+static UART_ClockProfileTypeDef current_profile = UART_CLOCK_PROFILE_HIGH;
+static bool initialized;
+static bool running;
+static UART_TimerTypeDef sample_timer;
+static uint32_t last_rx_count;
+static uint32_t last_tx_count;
+static uint64_t last_sample_us;         // Rates are per measured interval, the wheel may run late
+static uint32_t quiet_samples;          // Consecutive samples asking for a lower profile
+static uint64_t profile_entry_us;
+
+/**** Private Function Prototypes ****/
+static UART_ErrorTypeDef MoveUsartToHsi(void);
+static UART_ErrorTypeDef ApplyProfile(UART_ClockProfileTypeDef target);
+static UART_ErrorTypeDef EnablePll(void);
+static void SetFlashLatency(uint32_t latency);
+static uint32_t SwitchSysclk(const ProfileTypeDef *p);
+static UART_ClockProfileTypeDef DemandedProfile(void);
+static void SampleCallback(void *context);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Move USART2 to HSI16 and enter the MID profile
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockGov_Init(void)
+{
+    UART_ErrorTypeDef status;
+
+    memset(&gov_stats, 0, sizeof(gov_stats));
+    running = false;
+    quiet_samples = 0;
+
+    status = MoveUsartToHsi();
+    if (status != UART_SUCCESS) {
+        return status;
+    }
+
+    // Boot clock is the 32 MHz PLL, which no profile uses as is
+    current_profile = UART_CLOCK_PROFILE_HIGH;
+    profile_entry_us = UART_Time_Us();
+    initialized = true;
+
+    status = ApplyProfile(UART_CLOCK_PROFILE_MID);
+
+    // Boot time is not residency of any profile, and the first step is not a governor decision
+    memset(&gov_stats, 0, sizeof(gov_stats));
+    gov_stats.profile = current_profile;
+    profile_entry_us = UART_Time_Us();
+
+    return status;
+}
+
+/**
+ * @brief Start periodic load sampling on the timer wheel
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockGov_Start(void)
+{
+    if (!initialized) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    UART_GetByteCounts(&last_rx_count, &last_tx_count);
+    last_sample_us = UART_Time_Us();
+    quiet_samples = 0;
+    running = true;
+
+    return UART_Timer_Start(&sample_timer, UART_CLOCK_GOV_SAMPLE_MS, SampleCallback, NULL);
+}
+
+/**
+ * @brief Stop load sampling and stay on the current profile
+ */
+void UART_ClockGov_Stop(void)
+{
+    running = false;
+    UART_Timer_Stop(&sample_timer);
+}
+
+/**
+ * @brief Switch to a profile now
+ * @param profile Target profile
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockGov_SetProfile(UART_ClockProfileTypeDef profile)
+{
+    if (!initialized || profile >= UART_CLOCK_PROFILE_COUNT) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    quiet_samples = 0;
+    return ApplyProfile(profile);
+}
+
+/**
+ * @brief Get the active profile
+ * @return Profile
+ */
+UART_ClockProfileTypeDef UART_ClockGov_GetProfile(void)
+{
+    return current_profile;
+}
+
+/**
+ * @brief Get transition counters, costs and per-profile residency
+ * @param stats Destination for a snapshot of the statistics
+ */
+void UART_ClockGov_GetStats(UART_ClockGovStatsTypeDef *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    *stats = gov_stats;
+    stats->profile = current_profile;
+    if (initialized) {
+        stats->residency_us[current_profile] += UART_Time_Us() - profile_entry_us;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Clock USART2 from HSI16 so the baud rate survives SYSCLK changes
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if HSI did not start
+ * @note The receiver is off for a few microseconds; call before traffic starts
+ */
+static UART_ErrorTypeDef MoveUsartToHsi(void)
+{
+    USART_TypeDef *usart = huart2.Instance;
+    uint32_t timeout = HSI_READY_TIMEOUT;
+
+    SET_BIT(RCC->CR, RCC_CR_HSION);
+    while (!READ_BIT(RCC->CR, RCC_CR_HSIRDY)) {
+        if (--timeout == 0) {
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Let a byte in flight finish; the ISR cannot queue another while masked
+    timeout = SWITCH_TIMEOUT;
+    while (!READ_BIT(usart->ISR, USART_ISR_TC) && --timeout != 0) {
+    }
+
+    UART_SetBaudRate(RCC_USART2CLKSOURCE_HSI, huart2.Init.BaudRate);
+
+    __set_PRIMASK(primask);
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Move SYSCLK to a profile
+ * @param target Profile to enter
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if an oscillator or the regulator failed
+ * @note Regulator and PLL waits run with interrupts enabled; only SwitchSysclk() masks them
+ */
+static UART_ErrorTypeDef ApplyProfile(UART_ClockProfileTypeDef target)
+{
+    const ProfileTypeDef *from = &profiles[current_profile];
+    const ProfileTypeDef *to = &profiles[target];
+
+    if (target == current_profile && (RCC->CFGR & RCC_CFGR_SWS) == to->sws) {
+        return UART_SUCCESS;
+    }
+
+    uint64_t start_us = UART_Time_Us();
+
+    // Up: voltage first, then the oscillator, then wait states, then the switch
+    if (to->voltage == PWR_REGULATOR_VOLTAGE_SCALE1 && from->voltage != PWR_REGULATOR_VOLTAGE_SCALE1) {
+        if (HAL_PWREx_ControlVoltageScaling(to->voltage) != HAL_OK) {
+            gov_stats.failures++;
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+
+    if (to->sw == RCC_CFGR_SW_PLL && (RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL) {
+        if (EnablePll() != UART_SUCCESS) {
+            gov_stats.failures++;
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+
+    if (to->latency > __HAL_FLASH_GET_LATENCY()) {
+        SetFlashLatency(to->latency);
+    }
+
+    uint32_t masked_cycles = SwitchSysclk(to);
+    if (masked_cycles > gov_stats.max_masked_cycles) {
+        gov_stats.max_masked_cycles = masked_cycles;
+    }
+
+    // Down: wait states and voltage follow the lower clock
+    if (to->latency < __HAL_FLASH_GET_LATENCY()) {
+        SetFlashLatency(to->latency);
+    }
+
+    if (to->voltage == PWR_REGULATOR_VOLTAGE_SCALE2 && HAL_PWREx_GetVoltageRange() != PWR_REGULATOR_VOLTAGE_SCALE2) {
+        (void)HAL_PWREx_ControlVoltageScaling(to->voltage);
+    }
+
+    if (to->sw != RCC_CFGR_SW_PLL) {
+        __HAL_RCC_PLL_DISABLE();
+    }
+
+    uint64_t now_us = UART_Time_Us();
+    uint32_t cost_us = (uint32_t)(now_us - start_us);
+
+    gov_stats.residency_us[current_profile] += now_us - profile_entry_us;
+    profile_entry_us = now_us;
+
+    gov_stats.transitions++;
+    if (target > current_profile) {
+        gov_stats.transitions_up++;
+    } else {
+        gov_stats.transitions_down++;
+    }
+    gov_stats.last_transition_us = cost_us;
+    gov_stats.total_transition_us += cost_us;
+    if (cost_us > gov_stats.max_transition_us) {
+        gov_stats.max_transition_us = cost_us;
+    }
+
+    current_profile = target;
+    gov_stats.profile = target;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Lock the PLL at 80 MHz from MSI 4 MHz
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT otherwise
+ */
+static UART_ErrorTypeDef EnablePll(void)
+{
+    RCC_OscInitTypeDef osc = {0};
+
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_MSI;
+    osc.PLL.PLLM = 1;
+    osc.PLL.PLLN = 40;
+    osc.PLL.PLLP = RCC_PLLP_DIV7;
+    osc.PLL.PLLQ = RCC_PLLQ_DIV2;
+    osc.PLL.PLLR = RCC_PLLR_DIV2;
+
+    return (HAL_RCC_OscConfig(&osc) == HAL_OK) ? UART_SUCCESS : UART_ERROR_TIMEOUT;
+}
+
+/**
+ * @brief Program flash wait states and wait until they take effect
+ * @param latency FLASH_LATENCY_x
+ */
+static void SetFlashLatency(uint32_t latency)
+{
+    uint32_t timeout = SWITCH_TIMEOUT;
+
+    __HAL_FLASH_SET_LATENCY(latency);
+    while (__HAL_FLASH_GET_LATENCY() != latency && --timeout != 0) {
+    }
+}
+
+/**
+ * @brief Switch SYSCLK and re-derive everything clocked from it
+ * @param p Target profile
+ * @return Core cycles spent with interrupts masked
+ * @note The USART runs from HSI16, so reception continues through the switch
+ */
+static uint32_t SwitchSysclk(const ProfileTypeDef *p)
+{
+    uint32_t timeout = SWITCH_TIMEOUT;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t start = UART_TIME_CYCLES();
+
+    MODIFY_REG(RCC->CFGR, RCC_CFGR_SW, p->sw);
+    while ((RCC->CFGR & RCC_CFGR_SWS) != p->sws && --timeout != 0) {
+    }
+
+    // TIM2 and SysTick are re-derived before any interrupt can read them
+    SystemCoreClock = p->hz;
+    UART_Timebase_Rescale();
+    (void)HAL_InitTick(uwTickPrio);
+
+    uint32_t cycles = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+
+    return cycles;
+}
+
+/**
+ * @brief Map the load since the last sample to a profile
+ * @return Profile the current load calls for
+ */
+static UART_ClockProfileTypeDef DemandedProfile(void)
+{
+    uint32_t rx_count;
+    uint32_t tx_count;
+
+    UART_GetByteCounts(&rx_count, &tx_count);
+    uint64_t now_us = UART_Time_Us();
+
+    uint32_t bytes = (rx_count - last_rx_count) + (tx_count - last_tx_count);
+    uint64_t elapsed_us = now_us - last_sample_us;
+    uint32_t rate = (elapsed_us != 0U) ? (uint32_t)(((uint64_t)bytes * 1000000U) / elapsed_us) : 0U;
+    uint16_t rx_backlog = UART_Available();
+
+    last_rx_count = rx_count;
+    last_tx_count = tx_count;
+    last_sample_us = now_us;
+
+    // An RX backlog means the consumer is falling behind; TX drains at line rate anyway
+    if (rate >= UART_CLOCK_GOV_HIGH_RATE || rx_backlog >= UART_CLOCK_GOV_HIGH_FILL) {
+        return UART_CLOCK_PROFILE_HIGH;
+    }
+    if (rate >= UART_CLOCK_GOV_MID_RATE || rx_backlog > 0) {
+        return UART_CLOCK_PROFILE_MID;
+    }
+
+    return UART_CLOCK_PROFILE_LOW;
+}
+
+/**
+ * @brief Timer wheel callback: sample load and move between profiles
+ * @param context Unused
+ */
+static void SampleCallback(void *context)
+{
+    (void)context;
+
+    if (!running) {
+        return;
+    }
+
+    UART_ClockProfileTypeDef demand = DemandedProfile();
+
+    if (demand > current_profile) {
+        // Up at once, straight to the demanded profile
+        quiet_samples = 0;
+        (void)ApplyProfile(demand);
+    } else if (demand < current_profile) {
+        // Down one step at a time, only after a sustained quiet period
+        if (++quiet_samples >= UART_CLOCK_GOV_DOWN_SAMPLES) {
+            quiet_samples = 0;
+            (void)ApplyProfile((UART_ClockProfileTypeDef)(current_profile - 1));
+        }
+    } else {
+        quiet_samples = 0;
+    }
+
+    (void)UART_Timer_Start(&sample_timer, UART_CLOCK_GOV_SAMPLE_MS, SampleCallback, NULL);
+}
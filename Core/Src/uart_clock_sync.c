@@ -0,0 +1,308 @@
+/*
+ * uart_clock_sync.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_clock_sync.h"
+#include "uart_frame.h"
+#include "uart_timebase.h"
+#include "uart_timer.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define REQ_PAYLOAD_SIZE   4U
+#define RESP_PAYLOAD_SIZE  20U
+#define OFFSET_GAIN_DIV    4       // Offset correction = error / 4
+#define DRIFT_GAIN_DIV     16      // Drift correction = rate error / 16
+
+/**** Private Variables ****/
+static UART_ClockSyncStatusTypeDef status;
+static uint64_t estimate_time_us;       // Board time the estimate refers to
+static uint32_t delay_window[UART_CLOCK_SYNC_DELAY_WINDOW];
+static uint32_t delay_count;
+static uint32_t request_seq;
+static uint64_t request_time_us;
+static bool request_outstanding;
+static UART_TimerTypeDef request_timer;
+static uint32_t request_period_ms;
+
+/**** Private Function Prototypes ****/
+static void HandleResponse(const UART_FrameTypeDef *frame);
+static void ProcessSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+static int64_t PredictOffset(uint64_t local_us);
+static uint32_t MinDelay(void);
+static uint64_t ExtendTimestamp(uint32_t ts32, uint64_t now64);
+static void RequestTimerCallback(void *context);
+static void PutU32(uint8_t *p, uint32_t v);
+static uint32_t GetU32(const uint8_t *p);
+static uint64_t GetU64(const uint8_t *p);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Reset the estimator and register the response frame handler
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_Init(void)
+{
+    memset(&status, 0, sizeof(status));
+    delay_count = 0;
+    request_outstanding = false;
+
+    return UART_Frame_RegisterHandler(UART_FRAME_TYPE_TIME_SYNC_RESP, HandleResponse);
+}
+
+/**
+ * @brief Start periodic synchronization requests
+ * @param period_ms Request period in HAL ticks
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_Start(uint32_t period_ms)
+{
+    if (period_ms == 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    request_period_ms = period_ms;
+    return UART_Timer_Start(&request_timer, 1, RequestTimerCallback, NULL);
+}
+
+/**
+ * @brief Stop periodic synchronization requests
+ */
+void UART_ClockSync_Stop(void)
+{
+    UART_Timer_Stop(&request_timer);
+}
+
+/**
+ * @brief Send a single synchronization request now
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_ClockSync_SendRequest(void)
+{
+    uint8_t payload[REQ_PAYLOAD_SIZE];
+
+    if (request_outstanding) {
+        status.timeouts++;
+    }
+
+    request_seq++;
+    PutU32(payload, request_seq);
+
+    request_time_us = UART_Time_Us();
+    request_outstanding = true;
+
+    // T1 is the ISR send time of the SOF byte written next
+    UART_RequestTxTimestamp();
+    return UART_Frame_Send(UART_FRAME_TYPE_TIME_SYNC_REQ, payload, sizeof(payload));
+}
+
+/**
+ * @brief Convert a board timestamp into host time
+ * @param local_us Timestamp on the UART_Time_Us() clock
+ * @return Estimated host time in microseconds
+ */
+uint64_t UART_ClockSync_ToHost(uint64_t local_us)
+{
+    if (!status.synchronized) {
+        return local_us;
+    }
+
+    int64_t offset_ns = PredictOffset(local_us);
+    return (uint64_t)((int64_t)local_us + (offset_ns + ((offset_ns < 0) ? -500 : 500)) / 1000);
+}
+
+/**
+ * @brief Current host time estimate, for stamping outgoing frames
+ * @return Estimated host time in microseconds
+ */
+uint64_t UART_ClockSync_HostTimeUs(void)
+{
+    return UART_ClockSync_ToHost(UART_Time_Us());
+}
+
+/**
+ * @brief Get the estimator state
+ * @param out Destination for a snapshot of the state
+ */
+void UART_ClockSync_GetStatus(UART_ClockSyncStatusTypeDef *out)
+{
+    if (out != NULL) {
+        *out = status;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief TIME_SYNC_RESP frame handler
+ * @param frame Received frame
+ */
+static void HandleResponse(const UART_FrameTypeDef *frame)
+{
+    uint32_t t1_32;
+
+    if (frame->len != RESP_PAYLOAD_SIZE || !request_outstanding ||
+        GetU32(frame->payload) != request_seq) {
+        status.rejected++;
+        return;
+    }
+    request_outstanding = false;
+
+    if (!frame->rx_timestamp_valid || UART_GetTxTimestamp(&t1_32) != UART_SUCCESS) {
+        status.rejected++;
+        return;
+    }
+
+    uint64_t now = UART_Time_Us();
+    uint64_t t1 = ExtendTimestamp(t1_32, now);
+    uint64_t t4 = ExtendTimestamp(frame->rx_timestamp_us, now);
+
+    if (t1 < request_time_us || t4 < t1) {
+        status.rejected++;      // Stale TX timestamp from an earlier request
+        return;
+    }
+
+    ProcessSample(t1, GetU64(&frame->payload[4]), GetU64(&frame->payload[12]), t4);
+}
+
+/**
+ * @brief Feed one four-timestamp exchange into the offset/drift filter
+ * @param t1 Board send time
+ * @param t2 Host receive time
+ * @param t3 Host send time
+ * @param t4 Board receive time
+ */
+static void ProcessSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4)
+{
+    int64_t delay_us = (int64_t)(t4 - t1) - ((int64_t)t3 - (int64_t)t2);
+    if (delay_us < 0 || delay_us > (int64_t)UINT32_MAX) {
+        status.rejected++;
+        return;
+    }
+
+    // Popcorn filter: skip exchanges delayed by queuing on either side
+    delay_window[delay_count % UART_CLOCK_SYNC_DELAY_WINDOW] = (uint32_t)delay_us;
+    delay_count++;
+    status.last_delay_us = (uint32_t)delay_us;
+    if ((uint64_t)delay_us > 2ULL * MinDelay() + UART_CLOCK_SYNC_DELAY_SLACK_US) {
+        status.rejected++;
+        return;
+    }
+
+    int64_t measured_ns = (((int64_t)t2 - (int64_t)t1) + ((int64_t)t3 - (int64_t)t4)) * 500;
+    uint64_t local_mid = t1 + (t4 - t1) / 2U;
+
+    status.samples++;
+
+    if (!status.synchronized) {
+        status.offset_ns = measured_ns;
+        status.drift_ppb = 0;
+        status.last_error_ns = 0;
+        estimate_time_us = local_mid;
+        status.synchronized = true;
+        return;
+    }
+
+    int64_t dt_us = (int64_t)(local_mid - estimate_time_us);
+    int64_t predicted_ns = PredictOffset(local_mid);
+    int64_t error_ns = measured_ns - predicted_ns;
+
+    status.offset_ns = predicted_ns + error_ns / OFFSET_GAIN_DIV;
+    if (dt_us > 0) {
+        int64_t drift = status.drift_ppb + (error_ns * 1000000 / dt_us) / DRIFT_GAIN_DIV;
+        if (drift > UART_CLOCK_SYNC_MAX_DRIFT_PPB) {
+            drift = UART_CLOCK_SYNC_MAX_DRIFT_PPB;
+        } else if (drift < -UART_CLOCK_SYNC_MAX_DRIFT_PPB) {
+            drift = -UART_CLOCK_SYNC_MAX_DRIFT_PPB;
+        }
+        status.drift_ppb = (int32_t)drift;
+    }
+
+    status.last_error_ns = (error_ns > INT32_MAX) ? INT32_MAX :
+                           (error_ns < INT32_MIN) ? INT32_MIN : (int32_t)error_ns;
+    estimate_time_us = local_mid;
+}
+
+/**
+ * @brief Offset predicted by the current estimate at a board time
+ * @param local_us Board time
+ * @return Host minus board in nanoseconds
+ */
+static int64_t PredictOffset(uint64_t local_us)
+{
+    int64_t dt_us = (int64_t)(local_us - estimate_time_us);
+    return status.offset_ns + ((int64_t)status.drift_ppb * dt_us) / 1000000;
+}
+
+/**
+ * @brief Smallest round-trip delay in the window
+ * @return Delay in microseconds
+ */
+static uint32_t MinDelay(void)
+{
+    uint32_t count = (delay_count < UART_CLOCK_SYNC_DELAY_WINDOW) ? delay_count : UART_CLOCK_SYNC_DELAY_WINDOW;
+    uint32_t min_delay = UINT32_MAX;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (delay_window[i] < min_delay) {
+            min_delay = delay_window[i];
+        }
+    }
+
+    return min_delay;
+}
+
+/**
+ * @brief Widen a past 32-bit ISR timestamp to the 64-bit clock
+ * @param ts32 UART_TIME_US32() value, no older than ~71 minutes
+ * @param now64 Current UART_Time_Us() value
+ * @return 64-bit timestamp
+ */
+static uint64_t ExtendTimestamp(uint32_t ts32, uint64_t now64)
+{
+    return now64 - (uint32_t)((uint32_t)now64 - ts32);
+}
+
+/**
+ * @brief Periodic request timer callback
+ * @param context Unused
+ */
+static void RequestTimerCallback(void *context)
+{
+    (void)context;
+
+    UART_ClockSync_SendRequest();
+    UART_Timer_Start(&request_timer, request_period_ms, RequestTimerCallback, NULL);
+}
+
+/**
+ * @brief Store a little-endian 32-bit value
+ */
+static void PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief Load a little-endian 32-bit value
+ */
+static uint32_t GetU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Load a little-endian 64-bit value
+ */
+static uint64_t GetU64(const uint8_t *p)
+{
+    return (uint64_t)GetU32(p) | ((uint64_t)GetU32(p + 4) << 32);
+}
@@ -0,0 +1,660 @@
+/*
+ * uart_codec.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_codec.h"
+#include "uart_word.h"
+#include <string.h>
+#if UART_CODEC_ENABLE_BENCHMARK
+#include <stdio.h>
+#include "uart_timebase.h"
+#endif
+#if UART_ENABLE_TICKLESS_IDLE
+#include "uart_idle.h"
+#endif
+
+/**** Configuration Section ****/
+#define ONES          0x01010101U   // Broadcasts a byte constant to all four lanes
+#define BENCH_BYTES   192U          // Multiple of 3 and 4, so every path runs whole words
+
+/**** Type Definitions ****/
+typedef size_t (*EncodeFn)(const uint8_t *src, size_t len, char *dst);
+typedef UART_ErrorTypeDef (*DecodeFn)(const char *src, size_t len, uint8_t *dst, size_t *out_len);
+
+/**** Private Variables ****/
+static const char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#if UART_CODEC_ENABLE_BENCHMARK
+static uint8_t bench_data[BENCH_BYTES];
+static uint8_t bench_out[BENCH_BYTES];
+static char bench_text[UART_BASE64_ENCODED_LEN(BENCH_BYTES) + 1U];
+#endif
+
+/**** Private Function Prototypes ****/
+static inline uint32_t AddBytes(uint32_t a, uint32_t b);
+static inline uint32_t GeMask(uint32_t x, uint8_t k);
+static inline uint32_t RangeMask(uint32_t x, uint8_t lo, uint8_t hi);
+static inline uint32_t HexEncode2(uint32_t v);
+static inline bool HexDecode4(uint32_t c, uint32_t *out);
+static inline uint32_t Base64Encode4(uint32_t s);
+static inline bool Base64Decode4(uint32_t c, uint32_t *out);
+static int HexValue(char c);
+static int Base64Value(char c);
+static UART_ErrorTypeDef StreamEncode(const uint8_t *data, size_t len, size_t in_unit, size_t out_unit, EncodeFn encode);
+static UART_ErrorTypeDef StreamDecode(uint8_t *data, size_t len, size_t in_unit, size_t out_unit,
+                                      DecodeFn decode, uint32_t timeout_ms);
+static UART_ErrorTypeDef ReadCharTimeout(uint8_t *c, uint32_t timeout_ms);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Encode bytes as uppercase hex
+ * @param src Bytes to encode
+ * @param len Number of bytes
+ * @param dst Destination, UART_HEX_ENCODED_LEN(len) characters
+ * @return Characters written
+ */
+size_t UART_Hex_Encode(const uint8_t *src, size_t len, char *dst)
+{
+    size_t i = 0;
+
+    // 4 bytes in, 8 characters out per step
+    for (; i + 4U <= len; i += 4U) {
+        uint32_t u = UART_LoadWord(&src[i]);
+        UART_StoreWord(&dst[2U * i], HexEncode2((u & 0xFFU) | ((u & 0xFF00U) << 8)));
+        UART_StoreWord(&dst[2U * i + 4U], HexEncode2(((u >> 16) & 0xFFU) | ((u >> 8) & 0x00FF0000U)));
+    }
+
+    for (; i < len; i++) {
+        uint32_t w = HexEncode2(src[i]);
+        dst[2U * i] = (char)w;
+        dst[2U * i + 1U] = (char)(w >> 8);
+    }
+
+    return UART_HEX_ENCODED_LEN(len);
+}
+
+/**
+ * @brief Decode hex (either case)
+ * @param src Characters to decode
+ * @param len Number of characters, must be even
+ * @param dst Destination, len / 2 bytes
+ * @param out_len Pointer to store the number of bytes written
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA on a non-hex character
+ */
+UART_ErrorTypeDef UART_Hex_Decode(const char *src, size_t len, uint8_t *dst, size_t *out_len)
+{
+    if ((src == NULL && len != 0) || (dst == NULL && len != 0) || out_len == NULL || (len & 1U) != 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    size_t i = 0;
+    *out_len = 0;
+
+    // 8 characters in, 4 bytes out per step
+    for (; i + 8U <= len; i += 8U) {
+        uint32_t lo, hi;
+        if (!HexDecode4(UART_LoadWord(&src[i]), &lo) || !HexDecode4(UART_LoadWord(&src[i + 4U]), &hi)) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        UART_StoreWord(&dst[i / 2U], lo | (hi << 16));
+    }
+
+    for (; i < len; i += 2U) {
+        int hi = HexValue(src[i]);
+        int lo = HexValue(src[i + 1U]);
+        if (hi < 0 || lo < 0) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        dst[i / 2U] = (uint8_t)((hi << 4) | lo);
+    }
+
+    *out_len = len / 2U;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Encode bytes as padded base64
+ * @param src Bytes to encode
+ * @param len Number of bytes
+ * @param dst Destination, UART_BASE64_ENCODED_LEN(len) characters
+ * @return Characters written
+ */
+size_t UART_Base64_Encode(const uint8_t *src, size_t len, char *dst)
+{
+    size_t i = 0;
+    size_t o = 0;
+
+    // One word load per 3-byte group; the 4th byte belongs to the next group
+    for (; i + 4U <= len; i += 3U, o += 4U) {
+        uint32_t n = __REV(UART_LoadWord(&src[i])) >> 8;
+        uint32_t s = (n >> 18) | (((n >> 12) & 0x3FU) << 8) | (((n >> 6) & 0x3FU) << 16) | ((n & 0x3FU) << 24);
+        UART_StoreWord(&dst[o], Base64Encode4(s));
+    }
+
+    for (; i < len; i += 3U, o += 4U) {
+        size_t rem = len - i;
+        uint32_t n = ((uint32_t)src[i] << 16) |
+                     ((rem > 1U) ? ((uint32_t)src[i + 1U] << 8) : 0U) |
+                     ((rem > 2U) ? (uint32_t)src[i + 2U] : 0U);
+        uint32_t s = (n >> 18) | (((n >> 12) & 0x3FU) << 8) | (((n >> 6) & 0x3FU) << 16) | ((n & 0x3FU) << 24);
+        UART_StoreWord(&dst[o], Base64Encode4(s));
+
+        if (rem < 3U) {
+            dst[o + 3U] = '=';
+            if (rem < 2U) {
+                dst[o + 2U] = '=';
+            }
+        }
+    }
+
+    return o;
+}
+
+/**
+ * @brief Decode padded base64
+ * @param src Characters to decode
+ * @param len Number of characters, must be a multiple of 4
+ * @param dst Destination
+ * @param out_len Pointer to store the number of bytes written
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA on a malformed input
+ */
+UART_ErrorTypeDef UART_Base64_Decode(const char *src, size_t len, uint8_t *dst, size_t *out_len)
+{
+    if ((src == NULL && len != 0) || (dst == NULL && len != 0) || out_len == NULL || (len & 3U) != 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    size_t o = 0;
+    *out_len = 0;
+
+    for (size_t i = 0; i < len; i += 4U) {
+        uint32_t n;
+
+        if (Base64Decode4(UART_LoadWord(&src[i]), &n)) {
+            dst[o++] = (uint8_t)(n >> 16);
+            dst[o++] = (uint8_t)(n >> 8);
+            dst[o++] = (uint8_t)n;
+            continue;
+        }
+
+        // Only the final group may carry padding: "xx==" or "xxx="
+        if (i + 4U != len || src[i + 3U] != '=') {
+            return UART_ERROR_INVALID_DATA;
+        }
+
+        int s0 = Base64Value(src[i]);
+        int s1 = Base64Value(src[i + 1U]);
+        int s2 = (src[i + 2U] == '=') ? 0 : Base64Value(src[i + 2U]);
+        if (s0 < 0 || s1 < 0 || s2 < 0) {
+            return UART_ERROR_INVALID_DATA;
+        }
+
+        n = ((uint32_t)s0 << 18) | ((uint32_t)s1 << 12) | ((uint32_t)s2 << 6);
+        dst[o++] = (uint8_t)(n >> 16);
+        if (src[i + 2U] != '=') {
+            dst[o++] = (uint8_t)(n >> 8);
+        }
+    }
+
+    *out_len = o;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Send bytes hex-encoded through the TX ring
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if TX stayed full
+ */
+UART_ErrorTypeDef UART_Hex_Write(const uint8_t *data, size_t len)
+{
+    return StreamEncode(data, len, 1U, 2U, UART_Hex_Encode);
+}
+
+/**
+ * @brief Receive hex-encoded bytes from the RX ring
+ * @param data Destination
+ * @param len Number of bytes to receive
+ * @param timeout_ms Timeout in milliseconds while waiting for each character
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT or UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Hex_Read(uint8_t *data, size_t len, uint32_t timeout_ms)
+{
+    return StreamDecode(data, len, 2U, 1U, UART_Hex_Decode, timeout_ms);
+}
+
+/**
+ * @brief Send bytes base64-encoded through the TX ring
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if TX stayed full
+ */
+UART_ErrorTypeDef UART_Base64_Write(const uint8_t *data, size_t len)
+{
+    return StreamEncode(data, len, 3U, 4U, UART_Base64_Encode);
+}
+
+/**
+ * @brief Receive base64-encoded bytes from the RX ring
+ * @param data Destination
+ * @param len Number of bytes to receive
+ * @param timeout_ms Timeout in milliseconds while waiting for each character
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT or UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Base64_Read(uint8_t *data, size_t len, uint32_t timeout_ms)
+{
+    return StreamDecode(data, len, 4U, 3U, UART_Base64_Decode, timeout_ms);
+}
+
+#if UART_CODEC_ENABLE_BENCHMARK
+/**
+ * @brief Naive hex encoder, one sprintf per byte
+ */
+static void NaiveHexEncode(const uint8_t *src, size_t len, char *dst)
+{
+    for (size_t i = 0; i < len; i++) {
+        sprintf(&dst[2U * i], "%02X", src[i]);
+    }
+}
+
+/**
+ * @brief Naive hex decoder, one sscanf per byte
+ */
+static void NaiveHexDecode(const char *src, size_t len, uint8_t *dst)
+{
+    for (size_t i = 0; i < len; i += 2U) {
+        sscanf(&src[i], "%2hhx", &dst[i / 2U]);
+    }
+}
+
+/**
+ * @brief Naive base64 encoder, one table lookup per character
+ */
+static void NaiveBase64Encode(const uint8_t *src, size_t len, char *dst)
+{
+    for (size_t i = 0; i + 3U <= len; i += 3U) {
+        uint32_t n = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1U] << 8) | src[i + 2U];
+        *dst++ = base64_alphabet[(n >> 18) & 0x3FU];
+        *dst++ = base64_alphabet[(n >> 12) & 0x3FU];
+        *dst++ = base64_alphabet[(n >> 6) & 0x3FU];
+        *dst++ = base64_alphabet[n & 0x3FU];
+    }
+}
+
+/**
+ * @brief Naive base64 decoder, one alphabet search per character
+ */
+static void NaiveBase64Decode(const char *src, size_t len, uint8_t *dst)
+{
+    for (size_t i = 0; i + 4U <= len; i += 4U) {
+        uint32_t n = 0;
+        for (size_t j = 0; j < 4U; j++) {
+            n = (n << 6) | (uint32_t)(strchr(base64_alphabet, src[i + j]) - base64_alphabet);
+        }
+        *dst++ = (uint8_t)(n >> 16);
+        *dst++ = (uint8_t)(n >> 8);
+        *dst++ = (uint8_t)n;
+    }
+}
+
+/**
+ * @brief Time the word-wise codecs against naive byte-wise versions
+ * @param result Pointer to store DWT cycle counts
+ */
+void UART_Codec_Benchmark(UART_CodecBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    size_t out_len;
+    uint32_t start;
+    uint32_t primask = __get_PRIMASK();
+
+    for (uint32_t i = 0; i < BENCH_BYTES; i++) {
+        bench_data[i] = (uint8_t)(i * 37U + 11U);
+    }
+    result->bytes = BENCH_BYTES;
+
+    // Interrupts masked so the UART ISR does not land inside a measurement
+    __disable_irq();
+
+    start = UART_TIME_CYCLES();
+    NaiveHexEncode(bench_data, BENCH_BYTES, bench_text);
+    result->hex_encode_naive_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    UART_Hex_Encode(bench_data, BENCH_BYTES, bench_text);
+    result->hex_encode_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    NaiveHexDecode(bench_text, UART_HEX_ENCODED_LEN(BENCH_BYTES), bench_out);
+    result->hex_decode_naive_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    UART_Hex_Decode(bench_text, UART_HEX_ENCODED_LEN(BENCH_BYTES), bench_out, &out_len);
+    result->hex_decode_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    NaiveBase64Encode(bench_data, BENCH_BYTES, bench_text);
+    result->base64_encode_naive_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    UART_Base64_Encode(bench_data, BENCH_BYTES, bench_text);
+    result->base64_encode_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    NaiveBase64Decode(bench_text, UART_BASE64_ENCODED_LEN(BENCH_BYTES), bench_out);
+    result->base64_decode_naive_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    UART_Base64_Decode(bench_text, UART_BASE64_ENCODED_LEN(BENCH_BYTES), bench_out, &out_len);
+    result->base64_decode_cycles = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+}
+#endif /* UART_CODEC_ENABLE_BENCHMARK */
+
+/**** Private Functions ****/
+
+/**
+ * @brief Add each byte lane modulo 256, no carry between lanes
+ */
+static inline uint32_t AddBytes(uint32_t a, uint32_t b)
+{
+#if defined(__ARM_FEATURE_SIMD32)
+    return __UADD8(a, b);
+#else
+    return ((a & 0x7F7F7F7FU) + (b & 0x7F7F7F7FU)) ^ ((a ^ b) & 0x80808080U);
+#endif
+}
+
+/**
+ * @brief 0xFF in each byte lane of x that is >= k, 0x00 elsewhere
+ * @note Lanes of x must be below 0x80
+ */
+static inline uint32_t GeMask(uint32_t x, uint8_t k)
+{
+#if defined(__ARM_FEATURE_SIMD32)
+    // USUB8 sets a GE flag per lane without borrow, SEL turns the flags into a mask
+    (void)__USUB8(x, k * ONES);
+    return __SEL(0xFFFFFFFFU, 0U);
+#else
+    return (((x + (0x80U - k) * ONES) & 0x80808080U) >> 7) * 0xFFU;
+#endif
+}
+
+/**
+ * @brief 0xFF in each byte lane of x within [lo, hi], 0x00 elsewhere
+ * @note Lanes of x must be below 0x80
+ */
+static inline uint32_t RangeMask(uint32_t x, uint8_t lo, uint8_t hi)
+{
+    return GeMask(x, lo) & ~GeMask(x, (uint8_t)(hi + 1U));
+}
+
+/**
+ * @brief Encode two bytes as four hex characters
+ * @param v First byte in bits 0-7, second in bits 16-23
+ * @return Characters in memory order
+ */
+static inline uint32_t HexEncode2(uint32_t v)
+{
+    // One nibble per lane, high nibble first
+    uint32_t n = ((v >> 4) & 0x000F000FU) | ((v & 0x000F000FU) << 8);
+    return n + '0' * ONES + (GeMask(n, 10) & (7U * ONES));
+}
+
+/**
+ * @brief Decode four hex characters into two bytes
+ * @param c Characters in memory order
+ * @param out Pointer to store the bytes, first in bits 0-7
+ * @return false if any character is not a hex digit
+ */
+static inline bool HexDecode4(uint32_t c, uint32_t *out)
+{
+    if ((c & 0x80808080U) != 0) {
+        return false;
+    }
+
+    uint32_t l = c | (0x20U * ONES);    // Fold A-F onto a-f, digits already have bit 5 set
+    uint32_t digit = RangeMask(c, '0', '9');
+    uint32_t alpha = RangeMask(l, 'a', 'f');
+    if ((digit | alpha) != 0xFFFFFFFFU) {
+        return false;
+    }
+
+    uint32_t n = l - '0' * ONES - (alpha & (('a' - '0' - 10) * ONES));
+    uint32_t w = ((n & 0x000F000FU) << 4) | ((n >> 8) & 0x000F000FU);
+    *out = (w & 0xFFU) | ((w >> 8) & 0xFF00U);
+    return true;
+}
+
+/**
+ * @brief Map four sextets to base64 characters
+ * @param s Sextets in memory order
+ * @return Characters in memory order
+ */
+static inline uint32_t Base64Encode4(uint32_t s)
+{
+    // Per-lane offset: +65 (A-Z), +71 (a-z), -4 (0-9), -19 ('+'), -16 ('/')
+    uint32_t off = 'A' * ONES;
+    off = AddBytes(off, GeMask(s, 26) & (6U * ONES));
+    off = AddBytes(off, GeMask(s, 52) & (0xB5U * ONES));   // -75
+    off = AddBytes(off, GeMask(s, 62) & (0xF1U * ONES));   // -15
+    off = AddBytes(off, GeMask(s, 63) & (3U * ONES));
+    return AddBytes(s, off);
+}
+
+/**
+ * @brief Decode four base64 characters into three bytes
+ * @param c Characters in memory order
+ * @param out Pointer to store the 24-bit group, first byte in bits 16-23
+ * @return false if any character is outside the alphabet (including padding)
+ */
+static inline bool Base64Decode4(uint32_t c, uint32_t *out)
+{
+    if ((c & 0x80808080U) != 0) {
+        return false;
+    }
+
+    uint32_t upper = RangeMask(c, 'A', 'Z');
+    uint32_t lower = RangeMask(c, 'a', 'z');
+    uint32_t digit = RangeMask(c, '0', '9');
+    uint32_t plus = RangeMask(c, '+', '+');
+    uint32_t slash = RangeMask(c, '/', '/');
+    if ((upper | lower | digit | plus | slash) != 0xFFFFFFFFU) {
+        return false;
+    }
+
+    // The classes are disjoint, so OR-ing the per-lane offsets is exact
+    uint32_t off = (upper & (0xBFU * ONES)) | (lower & (0xB9U * ONES)) | (digit & (0x04U * ONES)) |
+                   (plus & (0x13U * ONES)) | (slash & (0x10U * ONES));
+    uint32_t s = AddBytes(c, off);
+
+    *out = ((s & 0x3FU) << 18) | (((s >> 8) & 0x3FU) << 12) | (((s >> 16) & 0x3FU) << 6) | (s >> 24);
+    return true;
+}
+
+/**
+ * @brief Value of one hex digit
+ * @return 0-15, or -1 if c is not a hex digit
+ */
+static int HexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c = (char)(c | 0x20);
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Value of one base64 character
+ * @return 0-63, or -1 if c is outside the alphabet
+ */
+static int Base64Value(char c)
+{
+    const char *p = (c != '\0') ? strchr(base64_alphabet, c) : NULL;
+    return (p != NULL) ? (int)(p - base64_alphabet) : -1;
+}
+
+/**
+ * @brief Encode into the TX ring one contiguous span at a time
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @param in_unit Input bytes per encoded group
+ * @param out_unit Characters per encoded group
+ * @param encode Buffer encoder
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if TX stayed full
+ */
+static UART_ErrorTypeDef StreamEncode(const uint8_t *data, size_t len, size_t in_unit, size_t out_unit, EncodeFn encode)
+{
+    if (data == NULL && len != 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    while (len > 0) {
+        uint8_t *span;
+        size_t n = (UART_TxReserve(&span) / out_unit) * in_unit;
+
+        if (n > len) {
+            n = len;    // Final group, padded output still fits the span
+        }
+
+        if (n != 0) {
+            UART_TxCommit((uint16_t)encode(data, n, (char *)span));
+        } else {
+            // TX is full or the span stops short at the wrap point: stage one
+            // group and let UART_WriteChar() wait for space and wrap
+            char stage[4];
+            n = (len < in_unit) ? len : in_unit;
+            size_t out = encode(data, n, stage);
+
+            for (size_t i = 0; i < out; i++) {
+                UART_ErrorTypeDef result = UART_WriteChar((uint8_t)stage[i]);
+                if (result != UART_SUCCESS) {
+                    return result;
+                }
+            }
+        }
+
+        data += n;
+        len -= n;
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Decode out of the RX ring one contiguous span at a time
+ * @param data Destination
+ * @param len Bytes to receive
+ * @param in_unit Characters per encoded group
+ * @param out_unit Output bytes per full group
+ * @param decode Buffer decoder
+ * @param timeout_ms Timeout in milliseconds while waiting for each character
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT or UART_ERROR_INVALID_DATA otherwise
+ */
+static UART_ErrorTypeDef StreamDecode(uint8_t *data, size_t len, size_t in_unit, size_t out_unit,
+                                      DecodeFn decode, uint32_t timeout_ms)
+{
+    if (data == NULL && len != 0) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    size_t full_chars = (len / out_unit) * in_unit;
+    size_t partial = len % out_unit;
+    char stage[4];
+    uint8_t tail[4];
+    size_t out;
+    UART_ErrorTypeDef result;
+
+    while (full_chars > 0) {
+        const uint8_t *span;
+        size_t n = (UART_RxPeekSpan(&span) / in_unit) * in_unit;
+
+        if (n > full_chars) {
+            n = full_chars;
+        }
+
+        if (n != 0) {
+            result = decode((const char *)span, n, data, &out);
+            UART_RxConsume((uint16_t)n);
+        } else {
+            // Nothing buffered yet, or one group straddles the wrap point
+            n = in_unit;
+            for (size_t i = 0; i < n; i++) {
+                result = ReadCharTimeout((uint8_t *)&stage[i], timeout_ms);
+                if (result != UART_SUCCESS) {
+                    return result;
+                }
+            }
+            result = decode(stage, n, data, &out);
+        }
+
+        // A padded group before the end would leave a hole in the output
+        if (result == UART_SUCCESS && out != (n / in_unit) * out_unit) {
+            result = UART_ERROR_INVALID_DATA;
+        }
+        if (result != UART_SUCCESS) {
+            return result;
+        }
+
+        data += out;
+        full_chars -= n;
+    }
+
+    if (partial != 0) {
+        // The last group decodes to fewer bytes than a full one, so go through a stage
+        for (size_t i = 0; i < in_unit; i++) {
+            result = ReadCharTimeout((uint8_t *)&stage[i], timeout_ms);
+            if (result != UART_SUCCESS) {
+                return result;
+            }
+        }
+
+        result = decode(stage, in_unit, tail, &out);
+        if (result != UART_SUCCESS) {
+            return result;
+        }
+        if (out != partial) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        memcpy(data, tail, partial);
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Read one character, waiting for it with a timeout
+ * @param c Pointer to store the character
+ * @param timeout_ms Timeout in milliseconds
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT otherwise
+ */
+static UART_ErrorTypeDef ReadCharTimeout(uint8_t *c, uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (UART_ReadChar(c) != UART_SUCCESS) {
+        uint32_t elapsed = HAL_GetTick() - start;
+        if (elapsed >= timeout_ms) {
+            return UART_ERROR_TIMEOUT;
+        }
+#if UART_ENABLE_TICKLESS_IDLE
+        // Inter-character timeout: sleep until the next byte or the deadline
+        UART_Idle_Sleep(timeout_ms - elapsed, UART_RxPending);
+#endif
+    }
+
+    return UART_SUCCESS;
+}
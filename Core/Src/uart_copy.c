@@ -0,0 +1,212 @@
+/*
+ * uart_copy.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_copy.h"
+#include "uart_word.h"
+#include <string.h>
+#if UART_COPY_ENABLE_BENCHMARK
+#include "uart_timebase.h"
+#endif
+
+/**** Configuration Section ****/
+#if defined(__GNUC__) && defined(__thumb2__)
+#define COPY_USE_BURST  1
+#else
+#define COPY_USE_BURST  0
+#endif
+
+#define BURST_BYTES     32U         // Eight registers per LDM/STM
+#define MIN_ALIGN_LEN   16U         // Shorter copies stay byte-wise, the prologue would dominate
+#define BENCH_BYTES     1024U
+#define BENCH_RING_SIZE (BENCH_BYTES + 4U)
+
+/**** Private Variables ****/
+#if UART_COPY_ENABLE_BENCHMARK
+static uint32_t bench_src[(BENCH_RING_SIZE + 3U) / 4U];
+static uint32_t bench_dst[(BENCH_BYTES + 4U) / 4U];
+#endif
+
+/**** Private Function Prototypes ****/
+#if COPY_USE_BURST
+static void CopyBursts(uint8_t **dst, const uint8_t **src, size_t bursts);
+#endif
+
+/**** Public Functions ****/
+
+/**
+ * @brief Copy bytes between non-overlapping buffers
+ * @param dst Destination, any alignment
+ * @param src Source, any alignment
+ * @param len Number of bytes
+ */
+void UART_Copy(void *dst, const void *src, size_t len)
+{
+#if COPY_USE_BURST
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if (len >= MIN_ALIGN_LEN) {
+        // STM and STR need the destination aligned; the source follows as it may
+        size_t head = (size_t)(-(uintptr_t)d & 3U);
+        len -= head;
+        while (head-- != 0U) {
+            *d++ = *s++;
+        }
+
+        if (((uintptr_t)s & 3U) == 0U) {
+            if (len >= BURST_BYTES) {
+                CopyBursts(&d, &s, len / BURST_BYTES);
+                len &= BURST_BYTES - 1U;
+            }
+        } else {
+            for (; len >= 16U; len -= 16U, d += 16, s += 16) {
+                uint32_t w0 = UART_LoadWord(&s[0]);
+                uint32_t w1 = UART_LoadWord(&s[4]);
+                uint32_t w2 = UART_LoadWord(&s[8]);
+                uint32_t w3 = UART_LoadWord(&s[12]);
+                UART_StoreWord(&d[0], w0);
+                UART_StoreWord(&d[4], w1);
+                UART_StoreWord(&d[8], w2);
+                UART_StoreWord(&d[12], w3);
+            }
+        }
+
+        for (; len >= 4U; len -= 4U, d += 4, s += 4) {
+            UART_StoreWord(d, UART_LoadWord(s));
+        }
+    }
+
+    while (len-- != 0U) {
+        *d++ = *s++;
+    }
+#else
+    memcpy(dst, src, len);
+#endif
+}
+
+/**
+ * @brief Copy a span out of a ring, across the wrap if needed
+ * @param dst Destination
+ * @param ring Ring storage
+ * @param size Ring size in bytes
+ * @param pos Read position
+ * @param len Number of bytes
+ * @return Bytes taken from the first segment
+ */
+size_t UART_Copy_FromRing(uint8_t *dst, const uint8_t *ring, size_t size, size_t pos, size_t len)
+{
+    size_t first = size - pos;
+    first = (len < first) ? len : first;
+
+    UART_Copy(dst, &ring[pos], first);
+    UART_Copy(&dst[first], ring, len - first);
+    return first;
+}
+
+/**
+ * @brief Copy bytes into a ring, across the wrap if needed
+ * @param ring Ring storage
+ * @param size Ring size in bytes
+ * @param pos Write position
+ * @param src Source
+ * @param len Number of bytes
+ * @return Bytes stored in the first segment
+ */
+size_t UART_Copy_ToRing(uint8_t *ring, size_t size, size_t pos, const uint8_t *src, size_t len)
+{
+    size_t first = size - pos;
+    first = (len < first) ? len : first;
+
+    UART_Copy(&ring[pos], src, first);
+    UART_Copy(ring, &src[first], len - first);
+    return first;
+}
+
+#if UART_COPY_ENABLE_BENCHMARK
+/**
+ * @brief Measure UART_Copy() and memcpy for every source/destination alignment
+ * @param result Pointer to store DWT cycle counts
+ */
+void UART_Copy_Benchmark(UART_CopyBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    uint8_t *src = (uint8_t *)bench_src;
+    uint8_t *dst = (uint8_t *)bench_dst;
+    uint32_t start;
+    uint32_t primask = __get_PRIMASK();
+
+    for (uint32_t i = 0; i < BENCH_RING_SIZE; i++) {
+        src[i] = (uint8_t)(i * 37U + 11U);
+    }
+    result->bytes = BENCH_BYTES;
+
+    // Interrupts masked so the UART ISR does not land inside a measurement
+    __disable_irq();
+
+    for (uint32_t s = 0; s < 4U; s++) {
+        for (uint32_t d = 0; d < 4U; d++) {
+            start = UART_TIME_CYCLES();
+            UART_Copy(&dst[d], &src[s], BENCH_BYTES);
+            result->cycles_per_kb[s][d] = UART_TIME_CYCLES() - start;
+
+            start = UART_TIME_CYCLES();
+            memcpy(&dst[d], &src[s], BENCH_BYTES);
+            result->memcpy_cycles_per_kb[s][d] = UART_TIME_CYCLES() - start;
+        }
+    }
+
+    // Odd start past the middle: an unaligned first segment, an aligned second one
+    size_t pos = BENCH_RING_SIZE / 2U + 1U;
+    size_t first = BENCH_RING_SIZE - pos;
+
+    start = UART_TIME_CYCLES();
+    UART_Copy_FromRing(dst, src, BENCH_RING_SIZE, pos, BENCH_BYTES);
+    result->ring_wrap_cycles_per_kb = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    memcpy(dst, &src[pos], first);
+    memcpy(&dst[first], src, BENCH_BYTES - first);
+    result->ring_wrap_memcpy_cycles_per_kb = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+}
+#endif /* UART_COPY_ENABLE_BENCHMARK */
+
+/**** Private Functions ****/
+
+#if COPY_USE_BURST
+/**
+ * @brief Move 32-byte blocks with LDM/STM
+ * @param dst Word-aligned destination, advanced past the copied bytes
+ * @param src Word-aligned source, advanced past the copied bytes
+ * @param bursts Number of blocks, at least 1
+ * @note r7 is left alone, it is the frame pointer in unoptimized Thumb builds
+ */
+static void CopyBursts(uint8_t **dst, const uint8_t **src, size_t bursts)
+{
+    uint8_t *d = *dst;
+    const uint8_t *s = *src;
+
+    __asm volatile (
+        "1:                                             \n"
+        "   ldmia   %[s]!, {r3-r6, r8-r10, r12}         \n"
+        "   stmia   %[d]!, {r3-r6, r8-r10, r12}         \n"
+        "   subs    %[n], %[n], #1                      \n"
+        "   bne     1b                                  \n"
+        : [d] "+r" (d), [s] "+r" (s), [n] "+r" (bursts)
+        :
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory"
+    );
+
+    *dst = d;
+    *src = s;
+}
+#endif /* COPY_USE_BURST */
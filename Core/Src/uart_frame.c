@@ -0,0 +1,355 @@
+/*
+ * uart_frame.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_frame.h"
+#include <string.h>
+
+/**** Type Definitions ****/
+typedef enum {
+    PARSE_HUNT = 0,
+    PARSE_LEN_LO,
+    PARSE_LEN_HI,
+    PARSE_TYPE,
+    PARSE_PAYLOAD,
+    PARSE_CHECKSUM
+} ParseStateTypeDef;
+
+typedef struct {
+    uint8_t type;
+    UART_FrameHandlerTypeDef handler;
+} HandlerEntryTypeDef;
+
+/**** Private Variables ****/
+static HandlerEntryTypeDef handlers[UART_FRAME_MAX_HANDLERS];
+static uint8_t rx_payload[UART_FRAME_MAX_PAYLOAD];
+static UART_FrameTypeDef rx_frame;
+static ParseStateTypeDef parse_state = PARSE_HUNT;
+static uint16_t rx_pos;
+static uint32_t rx_checksum;
+static UART_ChecksumTypeDef rx_checksum_ctx;
+static UART_FrameStatsTypeDef stats;
+static bool frame_dispatched;
+static uint8_t *tx_frame;               // Reserved frame inside the TX buffer, NULL when staged
+static uint16_t tx_reserved;
+static uint8_t tx_staging[UART_FRAME_MAX_PAYLOAD];
+
+/**** Private Function Prototypes ****/
+static void ParseByte(uint8_t c);
+static void EndPayload(void);
+static void DispatchFrame(void);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Reset the frame parser and handler table
+ */
+void UART_Frame_Init(void)
+{
+    memset(handlers, 0, sizeof(handlers));
+    memset(&stats, 0, sizeof(stats));
+    parse_state = PARSE_HUNT;
+}
+
+/**
+ * @brief Register the handler for a frame type
+ * @param type Frame type
+ * @param handler Handler function, NULL to remove
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_FULL if the table is full
+ */
+UART_ErrorTypeDef UART_Frame_RegisterHandler(uint8_t type, UART_FrameHandlerTypeDef handler)
+{
+    HandlerEntryTypeDef *free_entry = NULL;
+
+    for (size_t i = 0; i < UART_FRAME_MAX_HANDLERS; i++) {
+        if (handlers[i].handler != NULL && handlers[i].type == type) {
+            handlers[i].handler = handler;
+            return UART_SUCCESS;
+        }
+        if (handlers[i].handler == NULL && free_entry == NULL) {
+            free_entry = &handlers[i];
+        }
+    }
+
+    if (handler == NULL) {
+        return UART_SUCCESS;
+    }
+    if (free_entry == NULL) {
+        return UART_ERROR_BUFFER_FULL;
+    }
+
+    free_entry->type = type;
+    free_entry->handler = handler;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Parse bytes waiting in the RX buffer and dispatch complete frames
+ */
+void UART_Frame_Poll(void)
+{
+    while (UART_Frame_PollOne()) {
+    }
+}
+
+/**
+ * @brief Parse RX bytes until one frame has been dispatched
+ * @return true if a frame was dispatched, false if RX ran dry first
+ */
+bool UART_Frame_PollOne(void)
+{
+    uint8_t c;
+
+    frame_dispatched = false;
+    while (!frame_dispatched) {
+        if (parse_state == PARSE_PAYLOAD) {
+            // Payload needs no per-byte parsing, copy it straight out of the RX ring
+            uint16_t n = UART_ReadBlock(&rx_payload[rx_pos], (uint16_t)(rx_frame.len - rx_pos));
+            if (n == 0) {
+                break;
+            }
+
+            rx_pos = (uint16_t)(rx_pos + n);
+            if (rx_pos == rx_frame.len) {
+                EndPayload();
+            }
+            continue;
+        }
+
+        if (UART_ReadChar(&c) != UART_SUCCESS) {
+            break;
+        }
+        ParseByte(c);
+    }
+
+    return frame_dispatched;
+}
+
+/**
+ * @brief Send one frame through the TX buffer
+ * @param type Frame type
+ * @param payload Payload bytes
+ * @param len Payload length
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Frame_Send(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    if (len > UART_FRAME_MAX_PAYLOAD || (payload == NULL && len != 0)) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t header[UART_FRAME_HEADER_SIZE] = {
+        UART_FRAME_SOF, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8), type
+    };
+    UART_ChecksumTypeDef ctx;
+    UART_Checksum_Init(&ctx, UART_FRAME_CHECKSUM);
+    UART_Checksum_Update(&ctx, &header[1], UART_FRAME_HEADER_SIZE - 1U);
+    UART_Checksum_Update(&ctx, payload, len);
+    uint32_t checksum = UART_Checksum_Value(&ctx);
+
+    UART_ErrorTypeDef result;
+    for (size_t i = 0; i < UART_FRAME_HEADER_SIZE; i++) {
+        if ((result = UART_WriteChar(header[i])) != UART_SUCCESS) {
+            return result;
+        }
+    }
+
+    // Bulk copy what fits, then wait for room byte by byte
+    for (size_t i = UART_WriteBlock(payload, len); i < len; i++) {
+        if ((result = UART_WriteChar(payload[i])) != UART_SUCCESS) {
+            return result;
+        }
+    }
+
+    for (size_t i = 0; i < UART_FRAME_TRAILER_SIZE; i++) {
+        if ((result = UART_WriteChar((uint8_t)(checksum >> (8U * i)))) != UART_SUCCESS) {
+            return result;
+        }
+    }
+
+    UART_TxMarkBoundary();
+    stats.tx_frames++;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Reserve room for a frame payload to be built in place
+ * @param max_len Largest payload the caller may write
+ * @return Payload area inside the TX buffer or the staging buffer, NULL if max_len is too large
+ */
+uint8_t *UART_Frame_Reserve(uint16_t max_len)
+{
+    uint8_t *span;
+
+    if (max_len > UART_FRAME_MAX_PAYLOAD) {
+        return NULL;
+    }
+
+    tx_reserved = max_len;
+    if (UART_TxReserve(&span) >= UART_FRAME_HEADER_SIZE + max_len + UART_FRAME_TRAILER_SIZE) {
+        tx_frame = span;
+        return &span[UART_FRAME_HEADER_SIZE];
+    }
+
+    tx_frame = NULL;
+    return tx_staging;
+}
+
+/**
+ * @brief Complete the header and checksum of a reserved frame and start sending
+ * @param type Frame type
+ * @param len Payload bytes written
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Frame_Commit(uint8_t type, uint16_t len)
+{
+    uint8_t *frame = tx_frame;
+
+    if (len > tx_reserved) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+    tx_reserved = 0;
+
+    if (frame == NULL) {
+        return UART_Frame_Send(type, tx_staging, len);
+    }
+    tx_frame = NULL;
+
+    frame[0] = UART_FRAME_SOF;
+    frame[1] = (uint8_t)(len & 0xFF);
+    frame[2] = (uint8_t)(len >> 8);
+    frame[3] = type;
+
+    UART_ChecksumTypeDef ctx;
+    UART_Checksum_Init(&ctx, UART_FRAME_CHECKSUM);
+    UART_Checksum_Update(&ctx, &frame[1], UART_FRAME_HEADER_SIZE - 1U + len);
+    uint32_t checksum = UART_Checksum_Value(&ctx);
+
+    uint8_t *trailer = &frame[UART_FRAME_HEADER_SIZE + len];
+    for (size_t i = 0; i < UART_FRAME_TRAILER_SIZE; i++) {
+        trailer[i] = (uint8_t)(checksum >> (8U * i));
+    }
+
+    UART_TxCommit((uint16_t)(UART_FRAME_HEADER_SIZE + len + UART_FRAME_TRAILER_SIZE));
+    UART_TxMarkBoundary();
+    stats.tx_frames++;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Get frame statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Frame_GetStats(UART_FrameStatsTypeDef *out)
+{
+    if (out != NULL) {
+        *out = stats;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Advance the frame parser by one byte
+ * @param c Received byte
+ */
+static void ParseByte(uint8_t c)
+{
+    switch (parse_state) {
+    case PARSE_HUNT:
+        if (c == UART_FRAME_SOF) {
+            uint32_t ts = 0;
+            rx_frame.rx_timestamp_valid = (UART_GetRxMarkerTimestamp(&ts) == UART_SUCCESS);
+            rx_frame.rx_timestamp_us = ts;
+            UART_Checksum_Init(&rx_checksum_ctx, UART_FRAME_CHECKSUM);
+            parse_state = PARSE_LEN_LO;
+        }
+        break;
+
+    case PARSE_LEN_LO:
+        rx_frame.len = c;
+        UART_Checksum_Update(&rx_checksum_ctx, &c, 1);
+        parse_state = PARSE_LEN_HI;
+        break;
+
+    case PARSE_LEN_HI:
+        rx_frame.len |= (uint16_t)c << 8;
+        UART_Checksum_Update(&rx_checksum_ctx, &c, 1);
+        if (rx_frame.len > UART_FRAME_MAX_PAYLOAD) {
+            stats.rx_oversize++;
+            parse_state = PARSE_HUNT;
+        } else {
+            parse_state = PARSE_TYPE;
+        }
+        break;
+
+    case PARSE_TYPE:
+        rx_frame.type = c;
+        UART_Checksum_Update(&rx_checksum_ctx, &c, 1);
+        rx_pos = 0;
+        if (rx_frame.len > 0) {
+            parse_state = PARSE_PAYLOAD;
+        } else {
+            EndPayload();
+        }
+        break;
+
+    case PARSE_PAYLOAD:
+        rx_payload[rx_pos++] = c;
+        if (rx_pos == rx_frame.len) {
+            EndPayload();
+        }
+        break;
+
+    case PARSE_CHECKSUM:
+        rx_checksum |= (uint32_t)c << (8U * rx_pos);
+        if (++rx_pos < UART_FRAME_TRAILER_SIZE) {
+            break;
+        }
+        if (rx_checksum == UART_Checksum_Value(&rx_checksum_ctx)) {
+            DispatchFrame();
+        } else {
+            stats.rx_checksum_errors++;
+        }
+        parse_state = PARSE_HUNT;
+        break;
+
+    default:
+        parse_state = PARSE_HUNT;
+        break;
+    }
+}
+
+/**
+ * @brief Checksum the complete payload in one block and expect the trailer
+ */
+static void EndPayload(void)
+{
+    UART_Checksum_Update(&rx_checksum_ctx, rx_payload, rx_frame.len);
+    rx_checksum = 0;
+    rx_pos = 0;
+    parse_state = PARSE_CHECKSUM;
+}
+
+/**
+ * @brief Hand a validated frame to its registered handler
+ */
+static void DispatchFrame(void)
+{
+    stats.rx_frames++;
+    frame_dispatched = true;
+    rx_frame.payload = rx_payload;
+
+    for (size_t i = 0; i < UART_FRAME_MAX_HANDLERS; i++) {
+        if (handlers[i].handler != NULL && handlers[i].type == rx_frame.type) {
+            handlers[i].handler(&rx_frame);
+            return;
+        }
+    }
+
+    stats.rx_unhandled++;
+}
@@ -0,0 +1,296 @@
+/*
+ * uart_half_duplex.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_half_duplex.h"
+#include "uart_timebase.h"
+#include "main.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define UART_INSTANCE &huart2
+#define CHAR_BITS 11U               // Start + 8 data + parity + stop, worst case
+
+#if (UART_HD_ECHO_DEPTH & (UART_HD_ECHO_DEPTH - 1)) != 0
+#error "UART_HD_ECHO_DEPTH must be a power of two"
+#endif
+
+/**** External Dependencies ****/
+extern UART_HandleTypeDef huart2;
+
+/**** Private Variables ****/
+static volatile bool enabled;
+static uint8_t echo[UART_HD_ECHO_DEPTH];
+static volatile uint8_t echo_head;          // Written by ISR (TX)
+static volatile uint8_t echo_tail;          // Written by ISR (RX)
+static volatile uint32_t last_echo_us;      // Stop bit of the last own byte
+static volatile uint32_t first_reply_us;    // First foreign byte after response_armed
+static volatile bool response_armed;
+static bool held_enabled;                   // Saved by UART_HalfDuplex_HoldEcho()
+static uint32_t char_us;
+static UART_HalfDuplexStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static void ResetEcho(void);
+static uint8_t EchoPending(void);
+static bool WaitUntil(bool (*done)(void), uint64_t deadline_us);
+static bool EchoDrained(void);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Switch the driver's USART to single-wire half-duplex on the TX pin
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_HalfDuplex_Init(void)
+{
+    UART_HandleTypeDef *huart = UART_INSTANCE;
+    GPIO_InitTypeDef gpio = {0};
+
+    if (huart->Init.BaudRate == 0U) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    enabled = false;
+    memset(&stats, 0, sizeof(stats));
+    ResetEcho();
+    char_us = (CHAR_BITS * 1000000UL + huart->Init.BaudRate - 1U) / huart->Init.BaudRate;
+
+    // Handle is already initialized, so this only reprograms CR1/CR3 with HDSEL;
+    // interrupt enables set by UART_RingBuff_Init() are kept
+    if (HAL_HalfDuplex_Init(huart) != HAL_OK) {
+        return UART_ERROR_BUSY;
+    }
+
+    // Idle-high shared wire: open-drain with pull-up, receiver listens on the same pin
+    gpio.Pin = VCP_TX_Pin;
+    gpio.Mode = GPIO_MODE_AF_OD;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF7_USART2;
+    HAL_GPIO_Init(VCP_TX_GPIO_Port, &gpio);
+
+    HAL_GPIO_DeInit(VCP_RX_GPIO_Port, VCP_RX_Pin);
+
+    UART_FlushRX();
+    enabled = true;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Send a request and receive a fixed-length response
+ * @param request Request bytes
+ * @param request_len Request length
+ * @param response Destination for the response
+ * @param response_len Expected response length, 0 for send-only
+ * @param turnaround_us Longest allowed gap from the end of the request to the first response byte
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_HalfDuplex_Transact(const uint8_t *request, uint16_t request_len,
+                                           uint8_t *response, uint16_t response_len,
+                                           uint32_t turnaround_us)
+{
+    if (!enabled || request == NULL || request_len == 0U ||
+        (response == NULL && response_len != 0U)) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+    if (EchoPending() != 0U) {
+        return UART_ERROR_BUSY;
+    }
+
+    uint32_t mismatches = stats.echo_mismatches;
+
+    stats.transactions++;
+    UART_FlushRX();
+
+    response_armed = false;
+    for (uint16_t i = 0; i < request_len; i++) {
+        if (UART_WriteChar(request[i]) != UART_SUCCESS) {
+            stats.timeouts++;
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+    response_armed = true;
+
+    // Every request byte must come back off the wire; a lost one means the bus is stuck
+    uint64_t deadline = UART_Time_Us() + (uint64_t)(request_len + 2U) * char_us;
+    if (!WaitUntil(EchoDrained, deadline)) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        ResetEcho();
+        __set_PRIMASK(primask);
+        stats.timeouts++;
+        return UART_ERROR_TIMEOUT;
+    }
+
+    if (stats.echo_mismatches != mismatches) {
+        response_armed = false;
+        stats.collisions++;
+        UART_FlushRX();
+        return UART_ERROR_INVALID_DATA;
+    }
+
+    if (response_len == 0U) {
+        response_armed = false;
+        return UART_SUCCESS;
+    }
+
+    // First byte within the turnaround window, then at most UART_HD_INTERBYTE_CHARS gaps.
+    // Waiting covers the byte's own transmission time on top of the gap.
+    deadline = (uint64_t)UART_Time_Us() + turnaround_us + char_us;
+    for (uint16_t i = 0; i < response_len; i++) {
+        if (!WaitUntil(UART_RxPending, deadline)) {
+            response_armed = false;
+            stats.timeouts++;
+            return UART_ERROR_TIMEOUT;
+        }
+        (void)UART_ReadChar(&response[i]);
+
+        if (i == 0U) {
+            uint32_t turnaround = first_reply_us - last_echo_us - char_us;
+            if ((int32_t)turnaround < 0) {
+                turnaround = 0;
+            }
+            stats.last_turnaround_us = turnaround;
+            if (turnaround > stats.max_turnaround_us) {
+                stats.max_turnaround_us = turnaround;
+            }
+        }
+
+        deadline = UART_Time_Us() + (uint64_t)(UART_HD_INTERBYTE_CHARS + 1U) * char_us;
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Get transaction and echo statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_HalfDuplex_GetStats(UART_HalfDuplexStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Record a byte written to TDR as an expected echo
+ * @param c Byte sent
+ */
+void UART_HalfDuplex_OnTransmit(uint8_t c)
+{
+    if (!enabled) {
+        return;
+    }
+
+    uint8_t head = echo_head;
+    if ((uint8_t)(head - echo_tail) < UART_HD_ECHO_DEPTH) {
+        echo[head & (UART_HD_ECHO_DEPTH - 1U)] = c;
+        echo_head = head + 1U;
+    }
+}
+
+/**
+ * @brief Check a received byte against the expected echo
+ * @param c Byte received
+ * @return true if the byte is our own echo and must be dropped, false otherwise
+ */
+bool UART_HalfDuplex_IsEcho(uint8_t c)
+{
+    if (!enabled) {
+        return false;
+    }
+
+    uint8_t tail = echo_tail;
+    if (tail == echo_head) {
+        if (response_armed) {
+            first_reply_us = UART_TIME_US32();
+            response_armed = false;
+        }
+        return false;
+    }
+
+    // A mismatch is a collision: drop the garbled byte but keep it out of the echo count
+    if (echo[tail & (UART_HD_ECHO_DEPTH - 1U)] == c) {
+        stats.echo_bytes++;
+    } else {
+        stats.echo_mismatches++;
+    }
+    echo_tail = tail + 1U;
+    last_echo_us = UART_TIME_US32();
+
+    return true;
+}
+
+/**
+ * @brief Stop echo tracking so the ISR hooks pass every byte by, or resume it
+ * @param hold true to stop, false to resume
+ */
+void UART_HalfDuplex_HoldEcho(bool hold)
+{
+    if (hold) {
+        held_enabled = enabled;
+        enabled = false;
+    } else {
+        enabled = held_enabled;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Forget all expected echoes
+ * @note Caller masks interrupts once the mode is enabled
+ */
+static void ResetEcho(void)
+{
+    echo_tail = echo_head;
+    response_armed = false;
+}
+
+/**
+ * @brief Get the number of sent bytes not yet read back
+ * @return Pending echo count
+ */
+static uint8_t EchoPending(void)
+{
+    return (uint8_t)(echo_head - echo_tail);
+}
+
+/**
+ * @brief Spin until a condition holds or a deadline passes
+ * @param done Condition to poll
+ * @param deadline_us Absolute deadline from UART_Time_Us()
+ * @return true if the condition held in time, false on timeout
+ */
+static bool WaitUntil(bool (*done)(void), uint64_t deadline_us)
+{
+    while (!done()) {
+        if (UART_Time_DeadlineExpired(deadline_us)) {
+            return done();
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check that the request has fully gone out and been read back
+ * @return true if no echo is pending and the ISR has stopped feeding TDR
+ * @note The ISR clears TXEIE only after the last byte's echo was queued
+ */
+static bool EchoDrained(void)
+{
+    return EchoPending() == 0U && !READ_BIT((UART_INSTANCE)->Instance->CR1, USART_CR1_TXEIE);
+}
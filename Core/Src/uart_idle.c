@@ -0,0 +1,267 @@
+/*
+ * uart_idle.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_idle.h"
+#include "uart_timer.h"
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#if UART_ENABLE_TICKLESS_IDLE && UART_USE_FREERTOS
+#error "UART_ENABLE_TICKLESS_IDLE conflicts with the FreeRTOS tick; use configUSE_TICKLESS_IDLE instead"
+#endif
+
+#if UART_IDLE_LPTIM_PRESCALER == 0 || UART_IDLE_LPTIM_PRESCALER > 128 || \
+    (UART_IDLE_LPTIM_PRESCALER & (UART_IDLE_LPTIM_PRESCALER - 1)) != 0
+#error "UART_IDLE_LPTIM_PRESCALER must be a power of two up to 128"
+#endif
+
+#define LSE_HZ              32768UL
+#define LPTIM_HZ            (LSE_HZ / UART_IDLE_LPTIM_PRESCALER)
+#define LPTIM_PRESC_BITS    ((uint32_t)__builtin_ctz(UART_IDLE_LPTIM_PRESCALER) << LPTIM_CFGR_PRESC_Pos)
+#define SYNC_TIMEOUT        10000U      // Loop iterations, LPTIM register writes take ~3 LSE cycles
+
+#if ((UART_IDLE_MAX_SLEEP_MS * LPTIM_HZ + 999UL) / 1000UL) > 0xFFF0UL
+#error "UART_IDLE_MAX_SLEEP_MS exceeds the LPTIM1 range at this prescaler"
+#endif
+
+/**** Private Variables ****/
+static bool initialized;
+static bool compare_pending;            // CMP written, CMPOK not seen yet
+static uint32_t tick_remainder;         // LPTIM counts x 1000 not yet added to the tick
+static uint32_t window_start;
+static uint32_t window_count;
+static UART_IdleStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static uint16_t ReadCounter(void);
+static bool CompareWritable(void);
+static void AdvanceTick(uint16_t counts);
+static void CountWakeup(bool deadline);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Start LPTIM1 free-running on the LSE
+ * @return UART_SUCCESS on success, UART_ERROR_TIMEOUT if the LSE is not running
+ */
+UART_ErrorTypeDef UART_Idle_Init(void)
+{
+    uint32_t timeout = SYNC_TIMEOUT;
+
+    if (!LL_RCC_LSE_IsReady()) {
+        return UART_ERROR_TIMEOUT;
+    }
+
+    LL_RCC_SetLPTIMClockSource(LL_RCC_LPTIM1_CLKSOURCE_LSE);
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_LPTIM1);
+
+    // CFGR and IER are writable only while the timer is disabled, ARR only while enabled
+    LPTIM1->CR = 0;
+    LPTIM1->CFGR = LPTIM_PRESC_BITS;    // Internal clock, software start, no trigger
+    LPTIM1->IER = LPTIM_IER_CMPMIE;
+    LPTIM1->CR = LPTIM_CR_ENABLE;
+    LPTIM1->ARR = 0xFFFFU;
+    while ((LPTIM1->ISR & LPTIM_ISR_ARROK) == 0U) {
+        if (--timeout == 0) {
+            LPTIM1->CR = 0;
+            return UART_ERROR_TIMEOUT;
+        }
+    }
+    LPTIM1->ICR = LPTIM_ICR_ARROKCF;
+    LPTIM1->CR = LPTIM_CR_ENABLE | LPTIM_CR_CNTSTRT;
+
+    NVIC_SetPriority(LPTIM1_IRQn, UART_IDLE_LPTIM_IRQ_PRIORITY);
+    NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    memset(&stats, 0, sizeof(stats));
+    compare_pending = false;
+    tick_remainder = 0;
+    window_start = HAL_GetTick();
+    window_count = 0;
+    initialized = true;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Sleep until the next deadline or interrupt, with SysTick stopped
+ * @param max_ms Caller's own deadline in ms from now, or UART_IDLE_FOREVER
+ * @param wake Condition that cancels the sleep, or NULL
+ */
+void UART_Idle_Sleep(uint32_t max_ms, UART_IdleConditionTypeDef wake)
+{
+    uint32_t sleep_ms = max_ms;
+    uint32_t ticks;
+
+    // Nobody could run the handler that would make the wait worthwhile
+    if (!initialized || __get_IPSR() != 0U || __get_PRIMASK() != 0U) {
+        return;
+    }
+
+    if (UART_Timer_NextDeadline(&ticks) && ticks < sleep_ms) {
+        sleep_ms = ticks;
+    }
+    if (sleep_ms > UART_IDLE_MAX_SLEEP_MS) {
+        sleep_ms = UART_IDLE_MAX_SLEEP_MS;
+    }
+
+    // Wait for the previous compare write with interrupts still enabled
+    if (sleep_ms >= UART_IDLE_MIN_SLEEP_MS && !CompareWritable()) {
+        sleep_ms = UART_IDLE_MIN_SLEEP_MS - 1U;
+    }
+
+    // Masked from here: an interrupt after the check still ends WFI, it just runs afterwards
+    __disable_irq();
+
+    if (sleep_ms == 0 || (wake != NULL && wake())) {
+        __enable_irq();
+        stats.skipped++;
+        return;
+    }
+
+    if (sleep_ms < UART_IDLE_MIN_SLEEP_MS) {
+        // The next SysTick is the deadline; stopping it would gain nothing
+        __DSB();
+        __WFI();
+        __enable_irq();
+        stats.short_sleeps++;
+        CountWakeup(false);
+        return;
+    }
+
+    uint16_t start = ReadCounter();
+    LPTIM1->ICR = LPTIM_ICR_CMPMCF;
+    NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+    LPTIM1->CMP = (uint16_t)(start + (sleep_ms * LPTIM_HZ + 999U) / 1000U);
+    compare_pending = true;
+
+    HAL_SuspendTick();
+    __DSB();
+    __WFI();
+
+    // Still masked: correct the tick before any handler can look at it
+    uint16_t counts = (uint16_t)(ReadCounter() - start);
+    bool deadline = (LPTIM1->ISR & LPTIM_ISR_CMPM) != 0U;
+    AdvanceTick(counts);
+    HAL_ResumeTick();
+    __enable_irq();
+
+    stats.sleeps++;
+    CountWakeup(deadline);
+}
+
+/**
+ * @brief Get tickless idle statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Idle_GetStats(UART_IdleStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = stats;
+}
+
+/**
+ * @brief LPTIM1 interrupt handler
+ */
+void UART_Idle_IRQHandler(void)
+{
+    // The wake-up itself was the point; UART_Idle_Sleep() has already counted it
+    LPTIM1->ICR = LPTIM_ICR_CMPMCF;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Read the LPTIM1 counter
+ * @return Counter value
+ * @note The counter runs on the LSE; two equal consecutive reads are required
+ */
+static uint16_t ReadCounter(void)
+{
+    uint32_t previous;
+    uint32_t current = LPTIM1->CNT;
+
+    do {
+        previous = current;
+        current = LPTIM1->CNT;
+    } while (current != previous);
+
+    return (uint16_t)current;
+}
+
+/**
+ * @brief Wait until the previous CMP write has reached the LPTIM clock domain
+ * @return true if CMP may be written, false on timeout
+ */
+static bool CompareWritable(void)
+{
+    uint32_t timeout = SYNC_TIMEOUT;
+
+    if (!compare_pending) {
+        return true;
+    }
+
+    while ((LPTIM1->ISR & LPTIM_ISR_CMPOK) == 0U) {
+        if (--timeout == 0) {
+            return false;
+        }
+    }
+    LPTIM1->ICR = LPTIM_ICR_CMPOKCF;
+    compare_pending = false;
+
+    return true;
+}
+
+/**
+ * @brief Add the time spent asleep to the HAL tick
+ * @param counts LPTIM1 counts elapsed
+ * @note Interrupts must be masked; assumes the default 1 kHz HAL tick
+ */
+static void AdvanceTick(uint16_t counts)
+{
+    tick_remainder += (uint32_t)counts * 1000U;
+
+    // Carry the sub-millisecond part so repeated sleeps do not drift
+    uint32_t ms = tick_remainder / LPTIM_HZ;
+    tick_remainder -= ms * LPTIM_HZ;
+    uwTick += ms;
+
+    stats.slept_ms += ms;
+    if (ms > stats.max_sleep_ms) {
+        stats.max_sleep_ms = ms;
+    }
+}
+
+/**
+ * @brief Count a wake-up and close the rate window once it is long enough
+ * @param deadline true if the LPTIM1 compare ended the sleep
+ */
+static void CountWakeup(bool deadline)
+{
+    if (deadline) {
+        stats.wakeups_deadline++;
+    } else {
+        stats.wakeups_other++;
+    }
+
+    window_count++;
+    uint32_t now = HAL_GetTick();
+    uint32_t elapsed = now - window_start;
+    if (elapsed >= UART_IDLE_RATE_WINDOW_MS) {
+        stats.window_wakeups = window_count;
+        stats.window_ms = elapsed;
+        stats.wakeups_per_s = (uint32_t)(((uint64_t)window_count * 1000U) / elapsed);
+        window_start = now;
+        window_count = 0;
+    }
+}
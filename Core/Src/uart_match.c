@@ -0,0 +1,375 @@
+/*
+ * uart_match.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_match.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define NO_SKIP 0xFFU
+
+/**** Private Function Prototypes ****/
+static void ResetState(UART_MatchStateTypeDef *state);
+static void Step(const UART_PatternTypeDef *pattern, UART_MatchStateTypeDef *state, uint8_t c);
+static bool Advance(const UART_PatternTypeDef *pattern, UART_MatchStateTypeDef *state);
+static void Fail(UART_MatchStateTypeDef *state, uint8_t c);
+static uint8_t Fallback(const char *text, uint8_t pos, uint8_t c);
+static int HexValue(uint8_t c);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Attach a set of patterns to a matcher
+ * @param matcher Matcher state owned by the caller
+ * @param patterns Array of pattern pointers, may live in flash
+ * @param count Number of patterns, at most UART_MATCH_MAX_PATTERNS
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if a pattern is malformed
+ */
+UART_ErrorTypeDef UART_Match_Init(UART_MatcherTypeDef *matcher,
+                                  const UART_PatternTypeDef *const *patterns, uint8_t count)
+{
+    if (matcher == NULL || patterns == NULL || count > UART_MATCH_MAX_PATTERNS) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    for (uint8_t p = 0; p < count; p++) {
+        const UART_PatternTypeDef *pattern = patterns[p];
+        uint8_t captures = 0;
+
+        if (pattern == NULL || pattern->op_count == 0U || pattern->op_count == NO_SKIP) {
+            return UART_ERROR_INVALID_PARAM;
+        }
+
+        for (uint8_t i = 0; i < pattern->op_count; i++) {
+            const UART_MatchOpTypeDef *op = &pattern->ops[i];
+
+            switch (op->kind) {
+            case UART_MATCH_OP_LITERAL:
+                if (op->text == NULL || op->len == 0U) {
+                    return UART_ERROR_INVALID_PARAM;
+                }
+                break;
+            case UART_MATCH_OP_INT:
+            case UART_MATCH_OP_HEX:
+            case UART_MATCH_OP_STR:
+                captures++;
+                break;
+            case UART_MATCH_OP_SKIP:
+                // The wildcard resumes on the next literal's first byte
+                if (i + 1U >= pattern->op_count || pattern->ops[i + 1U].kind != UART_MATCH_OP_LITERAL) {
+                    return UART_ERROR_INVALID_PARAM;
+                }
+                break;
+            case UART_MATCH_OP_ANY:
+                break;
+            default:
+                return UART_ERROR_INVALID_PARAM;
+            }
+        }
+
+        if (captures > UART_MATCH_MAX_CAPTURES) {
+            return UART_ERROR_INVALID_PARAM;
+        }
+    }
+
+    matcher->patterns = patterns;
+    matcher->count = count;
+    matcher->matches = 0;
+    UART_Match_Reset(matcher);
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Restart every pattern as if at the start of a line
+ * @param matcher Matcher
+ */
+void UART_Match_Reset(UART_MatcherTypeDef *matcher)
+{
+    for (uint8_t p = 0; p < matcher->count; p++) {
+        ResetState(&matcher->states[p]);
+    }
+}
+
+/**
+ * @brief Advance all patterns over a block of bytes
+ * @param matcher Matcher
+ * @param data Bytes
+ * @param len Number of bytes
+ */
+void UART_Match_Feed(UART_MatcherTypeDef *matcher, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t c = data[i];
+
+        for (uint8_t p = 0; p < matcher->count; p++) {
+            const UART_PatternTypeDef *pattern = matcher->patterns[p];
+            UART_MatchStateTypeDef *state = &matcher->states[p];
+
+            Step(pattern, state, c);
+
+            if (state->op == pattern->op_count) {
+                matcher->matches++;
+                if (pattern->callback != NULL) {
+                    pattern->callback(state->captures, state->capture, pattern->context);
+                }
+                // Anchored again only if the match ended the line
+                ResetState(state);
+                state->waiting = (c != '\n');
+            }
+        }
+    }
+}
+
+/**
+ * @brief Consume everything in the RX ring and feed it to the matcher
+ * @param matcher Matcher
+ * @return Number of bytes consumed
+ */
+uint16_t UART_Match_Process(UART_MatcherTypeDef *matcher)
+{
+    const uint8_t *span;
+    uint16_t total = 0;
+    uint16_t len;
+
+    // At most two spans when the data wraps
+    while ((len = UART_RxPeekSpan(&span)) != 0U) {
+        UART_Match_Feed(matcher, span, len);
+        UART_RxConsume(len);
+        total += len;
+    }
+
+    return total;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Put a pattern back at its first op
+ * @param state Pattern state
+ */
+static void ResetState(UART_MatchStateTypeDef *state)
+{
+    state->op = 0;
+    state->pos = 0;
+    state->skip_op = NO_SKIP;
+    state->capture = 0;
+    state->digits = 0;
+    state->negative = false;
+    state->waiting = false;
+    state->captures[0].value.u = 0;
+}
+
+/**
+ * @brief Feed one byte to one pattern
+ * @param pattern Pattern
+ * @param state Pattern state
+ * @param c Byte
+ * @note A number or string ends on the first byte it cannot take; that
+ *       byte is then offered to the next op, hence the loop
+ */
+static void Step(const UART_PatternTypeDef *pattern, UART_MatchStateTypeDef *state, uint8_t c)
+{
+    if (state->waiting) {
+        if (c == '\n') {
+            ResetState(state);
+        }
+        return;
+    }
+
+    while (state->op < pattern->op_count) {
+        const UART_MatchOpTypeDef *op = &pattern->ops[state->op];
+        UART_MatchCaptureTypeDef *cap = &state->captures[state->capture];
+
+        switch (op->kind) {
+        case UART_MATCH_OP_LITERAL:
+            if (c == (uint8_t)op->text[state->pos]) {
+                if (++state->pos == op->len) {
+                    state->skip_op = NO_SKIP;
+                    (void)Advance(pattern, state);
+                }
+                return;
+            }
+            if (state->skip_op != NO_SKIP && c != '\n') {
+                // Partial literal after a wildcard: keep the longest part that still fits
+                state->pos = Fallback(op->text, state->pos, c);
+                if (state->pos == op->len) {
+                    state->skip_op = NO_SKIP;
+                    (void)Advance(pattern, state);
+                }
+                return;
+            }
+            Fail(state, c);
+            return;
+
+        case UART_MATCH_OP_INT:
+            if (c >= '0' && c <= '9') {
+                uint32_t d = (uint32_t)(c - '0');
+                // Magnitude accumulates unsigned; -2147483648 is the one value that needs bit 31
+                if (cap->value.u > (0x80000000UL - d) / 10U) {
+                    Fail(state, c);
+                    return;
+                }
+                cap->value.u = cap->value.u * 10U + d;
+                state->digits++;
+                return;
+            }
+            if (c == '-' && state->digits == 0U && !state->negative) {
+                state->negative = true;
+                return;
+            }
+            if (state->digits == 0U ||
+                (!state->negative && cap->value.u > 0x7FFFFFFFUL)) {
+                Fail(state, c);
+                return;
+            }
+            if (state->negative) {
+                cap->value.i = (int32_t)(0U - cap->value.u);
+            }
+            if (!Advance(pattern, state)) {
+                return;
+            }
+            continue;
+
+        case UART_MATCH_OP_HEX: {
+            int h = HexValue(c);
+            if (h >= 0) {
+                if (state->digits == 8U) {
+                    Fail(state, c);
+                    return;
+                }
+                cap->value.u = (cap->value.u << 4) | (uint32_t)h;
+                state->digits++;
+                return;
+            }
+            if (state->digits == 0U) {
+                Fail(state, c);
+                return;
+            }
+            if (!Advance(pattern, state)) {
+                return;
+            }
+            continue;
+        }
+
+        case UART_MATCH_OP_STR: {
+            uint8_t next = state->op + 1U;
+            bool ends = (c == '\r' || c == '\n');
+
+            if (next < pattern->op_count && pattern->ops[next].kind == UART_MATCH_OP_LITERAL) {
+                ends = ends || (c == (uint8_t)pattern->ops[next].text[0]);
+            }
+            if (!ends) {
+                if (state->pos >= UART_MATCH_STR_MAX - 1U) {
+                    Fail(state, c);
+                    return;
+                }
+                cap->value.s[state->pos++] = (char)c;
+                return;
+            }
+            cap->value.s[state->pos] = '\0';
+            if (!Advance(pattern, state)) {
+                return;
+            }
+            continue;
+        }
+
+        case UART_MATCH_OP_ANY:
+            (void)Advance(pattern, state);
+            return;
+
+        case UART_MATCH_OP_SKIP:
+            // Mark the wildcard and let the following literal look at this byte
+            state->skip_op = state->op;
+            state->op++;
+            state->pos = 0;
+            continue;
+
+        default:
+            Fail(state, c);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Move to the next op, closing a capture if the current op made one
+ * @param pattern Pattern
+ * @param state Pattern state
+ * @return true if there are more ops, false if the pattern has matched
+ */
+static bool Advance(const UART_PatternTypeDef *pattern, UART_MatchStateTypeDef *state)
+{
+    uint8_t kind = pattern->ops[state->op].kind;
+
+    if (kind == UART_MATCH_OP_INT || kind == UART_MATCH_OP_HEX || kind == UART_MATCH_OP_STR) {
+        state->captures[state->capture].kind = kind;
+        state->capture++;
+    }
+
+    state->op++;
+    state->pos = 0;
+    state->digits = 0;
+    state->negative = false;
+
+    if (state->op < pattern->op_count) {
+        // Captures accumulate in place, so start the next one from zero
+        UART_MatchCaptureTypeDef *cap = &state->captures[state->capture < UART_MATCH_MAX_CAPTURES ?
+                                                         state->capture : 0U];
+        cap->value.u = 0;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Abandon the current line
+ * @param state Pattern state
+ * @param c Byte that did not match
+ */
+static void Fail(UART_MatchStateTypeDef *state, uint8_t c)
+{
+    ResetState(state);
+    state->waiting = (c != '\n');
+}
+
+/**
+ * @brief Literal position after a mismatch behind a wildcard
+ * @param text Literal
+ * @param pos Bytes of text matched before c
+ * @param c Byte that did not continue the match
+ * @return Length of the longest prefix of text that ends the input text[0..pos) + c
+ * @note Literals are short and mismatches rare, so the prefix is searched instead of
+ *       keeping a failure table next to each flash-resident pattern
+ */
+static uint8_t Fallback(const char *text, uint8_t pos, uint8_t c)
+{
+    for (uint8_t k = pos; k > 0U; k--) {
+        if ((uint8_t)text[k - 1U] == c && memcmp(text, &text[pos - k + 1U], k - 1U) == 0) {
+            return k;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Convert a hex digit
+ * @param c Character
+ * @return Digit value, or -1 if c is not a hex digit
+ */
+static int HexValue(uint8_t c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c |= 0x20U;     // Fold to lowercase
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
@@ -0,0 +1,381 @@
+/*
+ * uart_number.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_number.h"
+#include "uart_word.h"
+#include <string.h>
+#if UART_NUMBER_ENABLE_BENCHMARK
+#include <stdlib.h>
+#include "uart_timebase.h"
+#endif
+
+/**** Configuration Section ****/
+#define ONES        0x01010101U     // Broadcasts a byte constant to all four lanes
+#define U32_LIMIT   0xFFFFFFFFULL
+#define NO_LIMIT    0xFFFFFFFFU
+
+#if UART_NUMBER_MAX_SCALE > 9
+#error "UART_NUMBER_MAX_SCALE must be at most 9"
+#endif
+
+/**** Private Variables ****/
+static const uint32_t powers_of_ten[10] = {
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+};
+
+#if UART_NUMBER_ENABLE_BENCHMARK
+static const char *const bench_unsigned[] = {
+    "0", "7", "42", "1234", "65535", "4807038", "123456789", "4294967295"
+};
+static const char *const bench_signed[] = {
+    "-1", "+42", "-1234", "65535", "-4807038", "123456789", "-2147483648", "2147483647"
+};
+static const char *const bench_fixed[] = {
+    "4807.038", "-0.5", "3.141592", "12.", "1013.25", "-45.123456", "0.000001", "-1999.999999"
+};
+#define BENCH_FIELDS (sizeof(bench_unsigned) / sizeof(bench_unsigned[0]))
+#endif
+
+/**** Private Function Prototypes ****/
+static inline uint32_t SliceLength(const UART_SliceTypeDef *slice);
+static inline uint8_t ByteAt(const UART_SliceTypeDef *slice, uint32_t pos);
+static inline uint32_t Load4(const UART_SliceTypeDef *slice, uint32_t pos);
+static inline uint32_t DigitMask(uint32_t w);
+static inline uint32_t LeadingDigits(uint32_t w);
+static inline uint32_t Convert4(uint32_t w, uint32_t n);
+static uint32_t ScanDigits(const UART_SliceTypeDef *slice, uint32_t pos, uint32_t max, uint64_t *acc);
+static uint32_t ParseSign(const UART_SliceTypeDef *slice, uint32_t pos, bool *negative);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Parse an unsigned decimal integer
+ * @param slice Input, e.g. from UART_RxPeekSlice()
+ * @param pos Offset of the first digit; advanced past the number on success
+ * @param value Pointer to store the result
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Number_ParseU32(const UART_SliceTypeDef *slice, uint16_t *pos, uint32_t *value)
+{
+    if (slice == NULL || pos == NULL || value == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    uint64_t acc = 0;
+    uint32_t digits = ScanDigits(slice, *pos, NO_LIMIT, &acc);
+    if (digits == 0U || acc > U32_LIMIT) {
+        return UART_ERROR_INVALID_DATA;
+    }
+
+    *value = (uint32_t)acc;
+    *pos = (uint16_t)(*pos + digits);
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Parse a signed decimal integer with optional '+' or '-'
+ * @param slice Input
+ * @param pos Offset of the sign or first digit; advanced past the number on success
+ * @param value Pointer to store the result
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA otherwise
+ */
+UART_ErrorTypeDef UART_Number_ParseI32(const UART_SliceTypeDef *slice, uint16_t *pos, int32_t *value)
+{
+    return UART_Number_ParseFixed(slice, pos, 0, value);
+}
+
+/**
+ * @brief Parse a decimal number with optional sign and fraction into fixed point
+ * @param slice Input
+ * @param pos Offset of the sign or first digit; advanced past the number on success
+ * @param scale Fractional digits to keep, 0 .. UART_NUMBER_MAX_SCALE
+ * @param value Pointer to store the number times 10^scale
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA otherwise
+ * @note With scale 0 a fraction is not part of the number and is left unread
+ */
+UART_ErrorTypeDef UART_Number_ParseFixed(const UART_SliceTypeDef *slice, uint16_t *pos,
+                                         uint8_t scale, int32_t *value)
+{
+    if (slice == NULL || pos == NULL || value == NULL || scale > UART_NUMBER_MAX_SCALE) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    bool negative;
+    uint32_t p = ParseSign(slice, *pos, &negative);
+
+    uint64_t whole = 0;
+    uint32_t int_digits = ScanDigits(slice, p, NO_LIMIT, &whole);
+    uint32_t frac_digits = 0;
+    uint64_t frac = 0;
+    p += int_digits;
+
+    bool has_point = (scale != 0U && ByteAt(slice, p) == '.');
+    uint32_t extra = 0;
+    if (has_point) {
+        frac_digits = ScanDigits(slice, p + 1U, scale, &frac);
+        // Digits beyond the scale are truncated but still belong to the field
+        extra = ScanDigits(slice, p + 1U + frac_digits, NO_LIMIT, NULL);
+    }
+
+    if (int_digits + frac_digits + extra == 0U) {
+        return UART_ERROR_INVALID_DATA;
+    }
+    if (has_point) {
+        p += 1U + frac_digits + extra;
+    }
+
+    // Checked before scaling, so the product stays far inside 64 bits
+    uint64_t limit = negative ? 0x80000000ULL : 0x7FFFFFFFULL;
+    if (whole > limit) {
+        return UART_ERROR_INVALID_DATA;
+    }
+    uint64_t scaled = whole * powers_of_ten[scale] + frac * powers_of_ten[scale - frac_digits];
+    if (scaled > limit) {
+        return UART_ERROR_INVALID_DATA;
+    }
+
+    *value = negative ? (int32_t)(0U - (uint32_t)scaled) : (int32_t)scaled;
+    *pos = (uint16_t)p;
+    return UART_SUCCESS;
+}
+
+#if UART_NUMBER_ENABLE_BENCHMARK
+/**
+ * @brief Time the SWAR parsers against newlib on the same fields
+ * @param result Pointer to store DWT cycle counts
+ */
+void UART_Number_Benchmark(UART_NumberBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    UART_SliceTypeDef slices[3][BENCH_FIELDS];
+    volatile int32_t sink = 0;
+    uint32_t start;
+    uint32_t primask = __get_PRIMASK();
+
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        const char *fields[3] = { bench_unsigned[i], bench_signed[i], bench_fixed[i] };
+        for (uint32_t k = 0; k < 3U; k++) {
+            slices[k][i] = (UART_SliceTypeDef)UART_SLICE(fields[k], strlen(fields[k]));
+        }
+    }
+    result->fields = BENCH_FIELDS;
+
+    // Interrupts masked so the UART ISR does not land inside a measurement
+    __disable_irq();
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        uint16_t pos = 0;
+        uint32_t v;
+        (void)UART_Number_ParseU32(&slices[0][i], &pos, &v);
+        sink += (int32_t)v;
+    }
+    result->u32_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        sink += (int32_t)strtoul(bench_unsigned[i], NULL, 10);
+    }
+    result->strtoul_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        uint16_t pos = 0;
+        int32_t v;
+        (void)UART_Number_ParseI32(&slices[1][i], &pos, &v);
+        sink += v;
+    }
+    result->i32_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        sink += (int32_t)strtol(bench_signed[i], NULL, 10);
+    }
+    result->strtol_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        uint16_t pos = 0;
+        int32_t v;
+        (void)UART_Number_ParseFixed(&slices[2][i], &pos, 6, &v);
+        sink += v;
+    }
+    result->fixed_cycles = UART_TIME_CYCLES() - start;
+
+    start = UART_TIME_CYCLES();
+    for (uint32_t i = 0; i < BENCH_FIELDS; i++) {
+        sink += (int32_t)(strtod(bench_fixed[i], NULL) * 1e6);
+    }
+    result->strtod_cycles = UART_TIME_CYCLES() - start;
+
+    __set_PRIMASK(primask);
+    (void)sink;
+}
+#endif /* UART_NUMBER_ENABLE_BENCHMARK */
+
+/**** Private Functions ****/
+
+/**
+ * @brief Total bytes in both parts of a slice
+ */
+static inline uint32_t SliceLength(const UART_SliceTypeDef *slice)
+{
+    return (uint32_t)slice->len[0] + slice->len[1];
+}
+
+/**
+ * @brief Read one byte of a slice
+ * @return The byte, or 0 (a non-digit) past the end
+ */
+static inline uint8_t ByteAt(const UART_SliceTypeDef *slice, uint32_t pos)
+{
+    if (pos < slice->len[0]) {
+        return slice->part[0][pos];
+    }
+    pos -= slice->len[0];
+    return (pos < slice->len[1]) ? slice->part[1][pos] : 0U;
+}
+
+/**
+ * @brief Load four bytes of a slice as a little-endian word
+ * @note Whole words inside one part are a single load; words that straddle
+ *       the wrap or the end are assembled, with 0 past the end
+ */
+static inline uint32_t Load4(const UART_SliceTypeDef *slice, uint32_t pos)
+{
+    if (pos + 4U <= slice->len[0]) {
+        return UART_LoadWord(&slice->part[0][pos]);
+    }
+    if (pos >= slice->len[0] && pos + 4U <= SliceLength(slice)) {
+        return UART_LoadWord(&slice->part[1][pos - slice->len[0]]);
+    }
+
+    return (uint32_t)ByteAt(slice, pos) |
+           ((uint32_t)ByteAt(slice, pos + 1U) << 8) |
+           ((uint32_t)ByteAt(slice, pos + 2U) << 16) |
+           ((uint32_t)ByteAt(slice, pos + 3U) << 24);
+}
+
+/**
+ * @brief 0xFF in each byte lane that holds '0'..'9', up to the first non-digit lane
+ * @note Lanes after the first non-digit may be misclassified; only the leading run is used
+ */
+static inline uint32_t DigitMask(uint32_t w)
+{
+#if defined(__ARM_FEATURE_SIMD32)
+    // USUB8 sets a GE flag per lane without borrow, SEL turns the flags into a mask
+    (void)__USUB8(w, '0' * ONES);
+    uint32_t ge_zero = __SEL(0xFFFFFFFFU, 0U);
+    (void)__USUB8(w, ('9' + 1) * ONES);
+    uint32_t ge_ten = __SEL(0xFFFFFFFFU, 0U);
+    return ge_zero & ~ge_ten;
+#else
+    // A digit has high nibble 3, and adding 6 does not carry out of the low nibble;
+    // a carry out of a non-digit lane only disturbs lanes after it
+    uint32_t t = (w & 0xF0F0F0F0U) | (((w + 0x06U * ONES) & 0xF0F0F0F0U) >> 4);
+    t ^= 0x33U * ONES;
+    uint32_t non_digit = (((t & 0x7F7F7F7FU) + 0x7F7F7F7FU) | t) & 0x80808080U;
+    return ~((non_digit >> 7) * 0xFFU);
+#endif
+}
+
+/**
+ * @brief Count the digits at the start of a word
+ * @return 0 .. 4
+ */
+static inline uint32_t LeadingDigits(uint32_t w)
+{
+    uint32_t non_digit = ~DigitMask(w);
+    if (non_digit == 0U) {
+        return 4U;
+    }
+    return __CLZ(__RBIT(non_digit)) >> 3;
+}
+
+/**
+ * @brief Convert the first n digits of a word
+ * @param w Characters in memory order, the first n are digits
+ * @param n 1 .. 4
+ * @return Value of the n digits
+ */
+static inline uint32_t Convert4(uint32_t w, uint32_t n)
+{
+    // Digit values, shifted up so unused lanes become leading zeros (lane 0 is the most significant)
+    w = (w - '0' * ONES) << (8U * (4U - n));
+    // Lanes 0 and 2 now hold two-digit values 10*d0+d1 and 10*d2+d3
+    w = w * 10U + (w >> 8);
+    // One multiply forms 100*(lane 0) + (lane 2) in bits 16-31
+    return ((w & 0x00FF00FFU) * (100U * 65536U + 1U)) >> 16;
+}
+
+/**
+ * @brief Accumulate a run of digits, eight per step
+ * @param slice Input
+ * @param pos Offset of the first digit
+ * @param max Most digits to take
+ * @param acc Accumulator, may be NULL to only count; accumulation stops above 2^32
+ * @return Digits taken
+ */
+static uint32_t ScanDigits(const UART_SliceTypeDef *slice, uint32_t pos, uint32_t max, uint64_t *acc)
+{
+    uint32_t count = 0;
+
+    while (count < max) {
+        uint32_t lo = Load4(slice, pos + count);
+        uint32_t n_lo = LeadingDigits(lo);
+        uint32_t n_hi = 0;
+        uint32_t hi = 0;
+
+        if (n_lo == 4U) {
+            hi = Load4(slice, pos + count + 4U);
+            n_hi = LeadingDigits(hi);
+        }
+        if (n_lo + n_hi > max - count) {
+            uint32_t n = max - count;
+            n_lo = (n < 4U) ? n : 4U;
+            n_hi = n - n_lo;
+        }
+        if (n_lo == 0U) {
+            break;
+        }
+
+        uint32_t n = n_lo + n_hi;
+        if (acc != NULL && *acc <= U32_LIMIT) {
+            uint32_t chunk = Convert4(lo, n_lo);
+            if (n_hi != 0U) {
+                chunk = chunk * powers_of_ten[n_hi] + Convert4(hi, n_hi);
+            }
+            *acc = *acc * powers_of_ten[n] + chunk;
+        }
+        count += n;
+
+        if (n < 8U) {
+            break;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Skip an optional sign
+ * @param slice Input
+ * @param pos Offset of the sign or first digit
+ * @param negative Pointer to store whether the sign was '-'
+ * @return Offset after the sign
+ */
+static uint32_t ParseSign(const UART_SliceTypeDef *slice, uint32_t pos, bool *negative)
+{
+    uint8_t c = ByteAt(slice, pos);
+
+    *negative = (c == '-');
+    return (c == '-' || c == '+') ? pos + 1U : pos;
+}
@@ -0,0 +1,333 @@
+/*
+ * uart_pipeline.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_pipeline.h"
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#if UART_PIPELINE_BUFFERS == 0 || UART_PIPELINE_BUFFERS > 32
+#error "UART_PIPELINE_BUFFERS must be 1 .. 32"
+#endif
+
+#define ALL_BUFFERS ((UART_PIPELINE_BUFFERS == 32U) ? UINT32_MAX : ((1UL << UART_PIPELINE_BUFFERS) - 1U))
+
+/**** Private Variables ****/
+static UART_PipelineStageTypeDef *stages;
+static uint8_t buffers[UART_PIPELINE_BUFFERS][UART_PIPELINE_BUFFER_SIZE] __attribute__((aligned(4)));
+static uint32_t free_buffers;                   // Bit per buffer, set when free
+static UART_PipelineDescTypeDef *ingress_slot;  // Parse stage output while it runs
+static bool ingress_filled;
+static UART_PipelineStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static void IngressHandler(const UART_FrameTypeDef *frame);
+static inline uint8_t QueueDepth(const UART_PipelineQueueTypeDef *queue);
+static void Account(UART_PipelineStageTypeDef *stage, const UART_PipelineDescTypeDef *item,
+                    uint32_t start, uint32_t end);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Forget all stages and return every buffer to the pool
+ */
+void UART_Pipeline_Init(void)
+{
+    stages = NULL;
+    free_buffers = ALL_BUFFERS;
+    ingress_slot = NULL;
+    memset(&stats, 0, sizeof(stats));
+    stats.buffers_free = UART_PIPELINE_BUFFERS;
+    stats.buffers_min_free = UART_PIPELINE_BUFFERS;
+}
+
+/**
+ * @brief Add a stage to the schedule
+ * @param stage Stage object owned by the caller
+ * @param name Name for diagnostics
+ * @param priority 0 runs first
+ * @param fn Stage function
+ * @param in Input queue, NULL for a source stage
+ * @param out Output queue, NULL for a sink stage
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ */
+UART_ErrorTypeDef UART_Pipeline_AddStage(UART_PipelineStageTypeDef *stage, const char *name, uint8_t priority,
+                                         UART_PipelineStageFnTypeDef fn,
+                                         UART_PipelineQueueTypeDef *in, UART_PipelineQueueTypeDef *out)
+{
+    UART_PipelineStageTypeDef **link = &stages;
+
+    if (stage == NULL || fn == NULL || (in == NULL && out == NULL)) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    memset(stage, 0, sizeof(*stage));
+    stage->name = name;
+    stage->fn = fn;
+    stage->in = in;
+    stage->out = out;
+    stage->priority = priority;
+
+    // Sorted by priority so Run() takes the first runnable stage
+    while (*link != NULL && (*link)->priority <= priority) {
+        link = &(*link)->next;
+    }
+    stage->next = *link;
+    *link = stage;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Run the highest-priority stage that has work, once
+ * @return true if a stage did work, false if the pipeline is idle
+ */
+bool UART_Pipeline_Run(void)
+{
+    for (UART_PipelineStageTypeDef *stage = stages; stage != NULL; stage = stage->next) {
+        UART_PipelineQueueTypeDef *in = stage->in;
+        UART_PipelineQueueTypeDef *out = stage->out;
+        UART_PipelineDescTypeDef *item = NULL;
+        UART_PipelineDescTypeDef *slot = NULL;
+
+        if (in != NULL) {
+            if (QueueDepth(in) == 0U) {
+                continue;
+            }
+            item = &in->slots[in->tail & (in->capacity - 1U)];
+        }
+
+        if (out != NULL) {
+            if (QueueDepth(out) == out->capacity) {
+                stage->stats.blocked++;
+                continue;
+            }
+            slot = &out->slots[out->head & (out->capacity - 1U)];
+            slot->buf = NULL;
+            slot->len = 0;
+            slot->type = (item != NULL) ? item->type : 0U;
+            slot->timestamp = (item != NULL) ? item->timestamp : UART_TIME_CYCLES();
+        }
+
+        uint32_t start = UART_TIME_CYCLES();
+        UART_PipelineResultTypeDef result = stage->fn(item, slot);
+        uint32_t end = UART_TIME_CYCLES();
+
+        if (result == UART_PIPELINE_IDLE) {
+            continue;
+        }
+        if (result == UART_PIPELINE_RETRY) {
+            stage->stats.retries++;
+            continue;                       // Let lower-priority stages use the pass
+        }
+
+        if (result == UART_PIPELINE_FORWARD && slot != NULL) {
+            __DMB();                        // Slot contents land before the new head
+            out->head = (uint8_t)(out->head + 1U);
+            if (QueueDepth(out) > out->high_water) {
+                out->high_water = QueueDepth(out);
+            }
+        } else {
+            slot = NULL;
+        }
+
+        if (item != NULL) {
+            if (slot == NULL || slot->buf != item->buf) {
+                UART_Pipeline_FreeBuffer(item->buf);
+            }
+            in->tail = (uint8_t)(in->tail + 1U);
+        }
+
+        Account(stage, (item != NULL) ? item : slot, start, end);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Route a frame type into UART_Pipeline_ParseStage()
+ * @param type Frame type
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Pipeline_AttachFrames(uint8_t type)
+{
+    return UART_Frame_RegisterHandler(type, IngressHandler);
+}
+
+/**
+ * @brief Take a payload buffer from the pool
+ * @return Buffer, NULL if the pool is empty
+ */
+uint8_t *UART_Pipeline_AllocBuffer(void)
+{
+    if (free_buffers == 0U) {
+        return NULL;
+    }
+
+    uint32_t index = (uint32_t)__builtin_ctz(free_buffers);
+    free_buffers &= free_buffers - 1U;
+
+    stats.buffers_free--;
+    if (stats.buffers_free < stats.buffers_min_free) {
+        stats.buffers_min_free = stats.buffers_free;
+    }
+    return buffers[index];
+}
+
+/**
+ * @brief Return a payload buffer to the pool
+ * @param buf Buffer from UART_Pipeline_AllocBuffer(), NULL is ignored
+ */
+void UART_Pipeline_FreeBuffer(uint8_t *buf)
+{
+    if (buf == NULL) {
+        return;
+    }
+
+    uint32_t index = (uint32_t)(buf - buffers[0]) / UART_PIPELINE_BUFFER_SIZE;
+    if (index < UART_PIPELINE_BUFFERS && (free_buffers & (1UL << index)) == 0U) {
+        free_buffers |= 1UL << index;
+        stats.buffers_free++;
+    }
+}
+
+/**
+ * @brief Source stage: parse RX bytes into one frame descriptor
+ * @param in Unused
+ * @param out Slot for the parsed frame
+ * @return FORWARD with a frame, CONSUMED if only other frame types arrived, IDLE otherwise
+ */
+UART_PipelineResultTypeDef UART_Pipeline_ParseStage(UART_PipelineDescTypeDef *in, UART_PipelineDescTypeDef *out)
+{
+    bool dispatched = false;
+
+    (void)in;
+
+    // No buffer to copy a frame into: leave the bytes in the RX ring until one is freed
+    if (free_buffers == 0U) {
+        if (UART_Available() != 0U) {
+            stats.parse_stalls++;
+        }
+        return UART_PIPELINE_IDLE;
+    }
+
+    ingress_slot = out;
+    ingress_filled = false;
+
+    while (!ingress_filled && UART_Frame_PollOne()) {
+        dispatched = true;
+    }
+
+    ingress_slot = NULL;
+    if (ingress_filled) {
+        return UART_PIPELINE_FORWARD;
+    }
+    return dispatched ? UART_PIPELINE_CONSUMED : UART_PIPELINE_IDLE;
+}
+
+/**
+ * @brief Sink stage: send the descriptor as a frame
+ * @param in Item to send
+ * @param out Unused
+ * @return CONSUMED once queued, RETRY while the TX ring is too full
+ */
+UART_PipelineResultTypeDef UART_Pipeline_TxStage(UART_PipelineDescTypeDef *in, UART_PipelineDescTypeDef *out)
+{
+    (void)out;
+
+    if (UART_TxFree() < UART_FRAME_HEADER_SIZE + in->len + UART_FRAME_TRAILER_SIZE) {
+        return UART_PIPELINE_RETRY;
+    }
+
+    UART_Frame_Send(in->type, in->buf, in->len);
+    return UART_PIPELINE_CONSUMED;
+}
+
+/**
+ * @brief Get a stage's metrics
+ * @param stage Stage
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Pipeline_GetStageStats(const UART_PipelineStageTypeDef *stage, UART_PipelineStageStatsTypeDef *out)
+{
+    if (stage == NULL || out == NULL) {
+        return;
+    }
+
+    *out = stage->stats;
+    if (stage->in != NULL) {
+        out->depth = QueueDepth(stage->in);
+        out->high_water = stage->in->high_water;
+        out->capacity = stage->in->capacity;
+    }
+}
+
+/**
+ * @brief Get ingress and buffer pool statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Pipeline_GetStats(UART_PipelineStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = stats;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Copy an attached frame into a pool buffer and fill the parse stage output
+ * @param frame Received frame
+ */
+static void IngressHandler(const UART_FrameTypeDef *frame)
+{
+    uint8_t *buf;
+
+    if (ingress_slot == NULL || ingress_filled || frame->len > UART_PIPELINE_BUFFER_SIZE ||
+        (buf = UART_Pipeline_AllocBuffer()) == NULL) {
+        stats.ingress_drops++;
+        return;
+    }
+
+    memcpy(buf, frame->payload, frame->len);
+    ingress_slot->buf = buf;
+    ingress_slot->len = frame->len;
+    ingress_slot->type = frame->type;
+    ingress_filled = true;
+    stats.ingress_frames++;
+}
+
+/**
+ * @brief Items waiting in a queue
+ */
+static inline uint8_t QueueDepth(const UART_PipelineQueueTypeDef *queue)
+{
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+/**
+ * @brief Update a stage's service time and latency after it processed an item
+ */
+static void Account(UART_PipelineStageTypeDef *stage, const UART_PipelineDescTypeDef *item,
+                    uint32_t start, uint32_t end)
+{
+    uint32_t cycles = end - start;
+
+    stage->stats.runs++;
+    stage->stats.cycles_total += cycles;
+    if (cycles > stage->stats.cycles_max) {
+        stage->stats.cycles_max = cycles;
+    }
+
+    if (item != NULL && end - item->timestamp > stage->stats.latency_max) {
+        stage->stats.latency_max = end - item->timestamp;
+    }
+}
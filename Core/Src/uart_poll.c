@@ -0,0 +1,88 @@
+/*
+ * uart_poll.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_poll.h"
+#include "uart_timebase.h"
+
+/**** Private Variables ****/
+static volatile uint32_t ready_events;
+
+/**** Public Functions ****/
+
+/**
+ * @brief Wait until any of the requested events is ready
+ * @param mask Events of interest
+ * @param deadline_us Absolute deadline, or UART_POLL_FOREVER
+ * @return Ready events within mask, 0 if the deadline passed first
+ */
+uint32_t UART_PollSet(uint32_t mask, uint64_t deadline_us)
+{
+    bool timed = (deadline_us != UART_POLL_FOREVER);
+    uint32_t ready;
+
+    for (;;) {
+        __disable_irq();
+
+        ready = ready_events & mask;
+        if (ready != 0) {
+            break;
+        }
+
+        // Nothing else may interrupt WFI before the deadline, so a TIM2 compare does
+        if (timed && !UART_Time_ArmWakeup(deadline_us)) {
+            break;
+        }
+
+        // Interrupts stay masked so an ISR cannot slip in between the check and the
+        // sleep; a pending interrupt still ends WFI and runs once PRIMASK clears
+        __WFI();
+        __enable_irq();
+    }
+
+    if (timed) {
+        UART_Time_DisarmWakeup();
+    }
+    __enable_irq();
+
+    return ready;
+}
+
+/**
+ * @brief Mark events ready
+ * @param events Event bits
+ */
+void UART_Poll_SetReady(uint32_t events)
+{
+    uint32_t value;
+
+    do {
+        value = __LDREXW(&ready_events);
+    } while (__STREXW(value | events, &ready_events) != 0U);
+}
+
+/**
+ * @brief Mark events not ready
+ * @param events Event bits
+ */
+void UART_Poll_ClearReady(uint32_t events)
+{
+    uint32_t value;
+
+    do {
+        value = __LDREXW(&ready_events);
+    } while (__STREXW(value & ~events, &ready_events) != 0U);
+}
+
+/**
+ * @brief Snapshot of the ready set without waiting
+ * @return Ready event bits
+ */
+uint32_t UART_Poll_Ready(void)
+{
+    return ready_events;
+}
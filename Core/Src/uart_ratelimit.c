@@ -0,0 +1,249 @@
+/*
+ * uart_ratelimit.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_ratelimit.h"
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define TOKEN_SCALE 1000000ULL      // Token units per byte (one per byte-microsecond of rate)
+
+/**** Private Variables ****/
+static UART_RateLimiterTypeDef *limiters;
+
+/**** Private Function Prototypes ****/
+static void Refill(UART_RateLimiterTypeDef *limiter);
+static void DrainBacklog(UART_RateLimiterTypeDef *limiter);
+static uint16_t TxRoom(void);
+static void SendBytes(UART_RateLimiterTypeDef *limiter, const uint8_t *data, uint16_t len);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Set up a producer and register it for UART_RateLimit_Process()
+ * @param limiter Producer state owned by the caller
+ * @param rate_bps Sustained rate in bytes per second
+ * @param burst_bytes Bucket depth
+ * @param policy What to do with over-limit writes
+ * @param backlog Backlog storage for UART_RATE_POLICY_DEFER
+ * @param backlog_size Size of backlog in bytes
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ */
+UART_ErrorTypeDef UART_RateLimit_Init(UART_RateLimiterTypeDef *limiter, uint32_t rate_bps, uint32_t burst_bytes,
+                                      UART_RatePolicyTypeDef policy, uint8_t *backlog, uint16_t backlog_size)
+{
+    if (limiter == NULL || rate_bps == 0 || burst_bytes == 0 ||
+        (policy == UART_RATE_POLICY_DEFER && (backlog == NULL || backlog_size == 0))) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    // Re-initializing a registered producer must not link it twice
+    bool registered = false;
+    for (UART_RateLimiterTypeDef *it = limiters; it != NULL; it = it->next) {
+        if (it == limiter) {
+            registered = true;
+            break;
+        }
+    }
+
+    UART_RateLimiterTypeDef *next = registered ? limiter->next : limiters;
+    memset(limiter, 0, sizeof(*limiter));
+    limiter->next = next;
+    limiter->rate_bps = rate_bps;
+    limiter->burst_bytes = burst_bytes;
+    limiter->tokens = (uint64_t)burst_bytes * TOKEN_SCALE;
+    limiter->last_refill_us = UART_Time_Us();
+    limiter->policy = policy;
+    limiter->backlog = (policy == UART_RATE_POLICY_DEFER) ? backlog : NULL;
+    limiter->backlog_size = (policy == UART_RATE_POLICY_DEFER) ? backlog_size : 0;
+
+    if (!registered) {
+        limiters = limiter;
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Write a message on behalf of a producer
+ * @param limiter Producer
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return UART_SUCCESS if sent or deferred, UART_ERROR_RATE_LIMITED if dropped
+ */
+UART_ErrorTypeDef UART_RateLimit_Write(UART_RateLimiterTypeDef *limiter, const uint8_t *data, uint16_t len)
+{
+    if (limiter == NULL || (data == NULL && len != 0)) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+    if (len == 0) {
+        return UART_SUCCESS;
+    }
+
+    Refill(limiter);
+    DrainBacklog(limiter);
+
+    // Older deferred bytes go first, so only an empty backlog allows a direct send
+    if (limiter->backlog_count == 0 &&
+        limiter->tokens >= (uint64_t)len * TOKEN_SCALE && TxRoom() >= len) {
+        limiter->tokens -= (uint64_t)len * TOKEN_SCALE;
+        SendBytes(limiter, data, len);
+        return UART_SUCCESS;
+    }
+
+    if (limiter->policy == UART_RATE_POLICY_DEFER &&
+        (uint16_t)(limiter->backlog_size - limiter->backlog_count) >= len) {
+        for (uint16_t i = 0; i < len; i++) {
+            uint16_t pos = (uint16_t)((limiter->backlog_head + limiter->backlog_count) % limiter->backlog_size);
+            limiter->backlog[pos] = data[i];
+            limiter->backlog_count++;
+        }
+
+        limiter->stats.bytes_deferred += len;
+        if (limiter->backlog_count > limiter->stats.backlog_peak) {
+            limiter->stats.backlog_peak = limiter->backlog_count;
+        }
+        return UART_SUCCESS;
+    }
+
+    limiter->stats.writes_dropped++;
+    limiter->stats.bytes_dropped += len;
+    return UART_ERROR_RATE_LIMITED;
+}
+
+/**
+ * @brief Write a null-terminated string on behalf of a producer
+ * @param limiter Producer
+ * @param str String to send
+ * @return UART_SUCCESS if sent or deferred, UART_ERROR_RATE_LIMITED if dropped
+ */
+UART_ErrorTypeDef UART_RateLimit_SendString(UART_RateLimiterTypeDef *limiter, const char *str)
+{
+    if (str == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    size_t len = strlen(str);
+    if (len > UINT16_MAX) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    return UART_RateLimit_Write(limiter, (const uint8_t *)str, (uint16_t)len);
+}
+
+/**
+ * @brief Move deferred bytes into the TX ring as tokens and ring space allow
+ */
+void UART_RateLimit_Process(void)
+{
+    for (UART_RateLimiterTypeDef *limiter = limiters; limiter != NULL; limiter = limiter->next) {
+        if (limiter->backlog_count != 0) {
+            Refill(limiter);
+            DrainBacklog(limiter);
+        }
+    }
+}
+
+/**
+ * @brief Get a producer's counters
+ * @param limiter Producer
+ * @param stats Destination for a copy of the counters
+ */
+void UART_RateLimit_GetStats(const UART_RateLimiterTypeDef *limiter, UART_RateLimitStatsTypeDef *stats)
+{
+    if (limiter != NULL && stats != NULL) {
+        *stats = limiter->stats;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Credit tokens for the time since the last refill
+ * @param limiter Producer
+ */
+static void Refill(UART_RateLimiterTypeDef *limiter)
+{
+    uint64_t now = UART_Time_Us();
+    uint64_t elapsed_us = now - limiter->last_refill_us;
+    uint64_t full = (uint64_t)limiter->burst_bytes * TOKEN_SCALE;
+
+    limiter->last_refill_us = now;
+
+    // Compare before multiplying so a long idle period cannot overflow
+    if (elapsed_us >= full / limiter->rate_bps) {
+        limiter->tokens = full;
+    } else {
+        limiter->tokens += elapsed_us * limiter->rate_bps;
+        if (limiter->tokens > full) {
+            limiter->tokens = full;
+        }
+    }
+}
+
+/**
+ * @brief Send as much of the backlog as tokens and TX headroom allow
+ * @param limiter Producer
+ */
+static void DrainBacklog(UART_RateLimiterTypeDef *limiter)
+{
+    uint64_t affordable = limiter->tokens / TOKEN_SCALE;
+    uint16_t n = limiter->backlog_count;
+
+    if (affordable < n) {
+        n = (uint16_t)affordable;
+    }
+    uint16_t room = TxRoom();
+    if (room < n) {
+        n = room;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    limiter->tokens -= (uint64_t)n * TOKEN_SCALE;
+
+    // The backlog wraps at most once, so this takes at most two contiguous chunks
+    while (n > 0) {
+        uint16_t chunk = (uint16_t)(limiter->backlog_size - limiter->backlog_head);
+        if (chunk > n) {
+            chunk = n;
+        }
+
+        SendBytes(limiter, &limiter->backlog[limiter->backlog_head], chunk);
+        limiter->backlog_head = (uint16_t)((limiter->backlog_head + chunk) % limiter->backlog_size);
+        limiter->backlog_count -= chunk;
+        n -= chunk;
+    }
+}
+
+/**
+ * @brief TX ring space a limited producer may use
+ * @return Free bytes above UART_RATELIMIT_TX_HEADROOM
+ */
+static uint16_t TxRoom(void)
+{
+    uint16_t free_bytes = UART_TxFree();
+    return (free_bytes > UART_RATELIMIT_TX_HEADROOM) ? (uint16_t)(free_bytes - UART_RATELIMIT_TX_HEADROOM) : 0U;
+}
+
+/**
+ * @brief Hand bytes to the TX ring
+ * @param limiter Producer
+ * @param data Bytes to send
+ * @param len Number of bytes, already checked against TxRoom()
+ */
+static void SendBytes(UART_RateLimiterTypeDef *limiter, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (UART_WriteChar(data[i]) != UART_SUCCESS) {
+            break;
+        }
+        limiter->stats.bytes_sent++;
+    }
+}
@@ -7,27 +7,248 @@
 
 
 #include "uart_ring_buffer.h"
+#include "uart_copy.h"
 #include <string.h>
 #include <stdbool.h>
 #include <stdio.h>
+#if UART_USE_US_TIMEBASE || UART_ENABLE_TIMESTAMPS || UART_ENABLE_ISR_PROFILE || UART_ENABLE_ISR_BENCHMARK
+#include "uart_timebase.h"
+#endif
+#if UART_ENABLE_SCHED_TX
+#include "uart_sched_tx.h"
+#endif
+#if UART_ELASTIC_RINGS
+#include "uart_ring_pool.h"
+#endif
+#if UART_ENABLE_POLL
+#include "uart_poll.h"
+#endif
+#if UART_ENABLE_HALF_DUPLEX
+#include "uart_half_duplex.h"
+#endif
+#if UART_USE_FREERTOS
+#include "uart_rtos.h"
+#endif
+#if UART_ENABLE_TICKLESS_IDLE
+#include "uart_idle.h"
+#endif
+#if UART_BOOT_PROFILE
+#include "uart_boot.h"
+#endif
 
 /**** Configuration Section ****/
 #define UART_INSTANCE &huart2
 #define DEFAULT_TIMEOUT_MS 500
+#define ISR_BENCH_ITERATIONS 32U    // Bytes per RX/TX path in UART_BenchmarkIsr()
 #define UART_BUFFER_SIZE 1024  // Make this configurable
 
 /**** External Dependencies ****/
 extern UART_HandleTypeDef huart2;
 
+/**** Type Definitions ****/
+#if UART_ELASTIC_RINGS
+typedef UART_ElasticRingTypeDef RingTypeDef;
+#else
+typedef RingBuffer_TypeDef RingTypeDef;
+#endif
+
+#if UART_ENABLE_SCHED_TX
+typedef enum {
+    TX_GATE_OPEN = 0,
+    TX_GATE_CLOSING,    // Ring TX runs on to the held message boundary
+    TX_GATE_CLOSED      // Ring TX stopped, the line belongs to the scheduled frame
+} TxGateTypeDef;
+#endif
+
 /**** Private Variables ****/
-static RingBuffer_TypeDef rx_buffer = {{0}, 0, 0};
-static RingBuffer_TypeDef tx_buffer = {{0}, 0, 0};
+#if UART_ELASTIC_RINGS
+static RingTypeDef rx_buffer;
+static RingTypeDef tx_buffer;
+#else
+static RingTypeDef rx_buffer = {{0}, 0, 0};
+static RingTypeDef tx_buffer = {{0}, 0, 0};
+#endif
+#if UART_USE_US_TIMEBASE
+static volatile uint64_t timeout_start;
+#else
 static volatile uint32_t timeout_start;
+#endif
+
+#if UART_ENABLE_TIMESTAMPS
+static uint32_t rx_marker_ts[UART_RX_TIMESTAMP_DEPTH];
+static volatile uint32_t rx_markers_stored;     // Written by ISR
+static uint32_t rx_markers_read;
+static uint32_t rx_marker_last_ts;
+static bool rx_marker_last_valid;
+
+static volatile uint32_t tx_stamp_pos;
+static volatile uint32_t tx_stamp_ts;
+static volatile enum { TX_STAMP_IDLE, TX_STAMP_PENDING, TX_STAMP_DONE } tx_stamp_state;
+#endif
+
+#if UART_ENABLE_SCHED_TX
+static volatile TxGateTypeDef tx_gate = TX_GATE_OPEN;
+static volatile uint32_t tx_boundary_pos;   // RingWritePos() after the last complete message
+static volatile uint32_t tx_hold_pos;       // Boundary ring TX stops at while closing
+static volatile bool tx_slot_due;           // Slot reached, start on TC once the gate closes
+#endif
+
+#if UART_ENABLE_THRESHOLDS
+static uint16_t rx_threshold;               // 0: byte-count notification off
+static uint16_t tx_threshold;               // 0: TX notification off
+static volatile bool rx_notify_armed;
+static volatile bool tx_notify_armed;
+static UART_ThresholdStatsTypeDef threshold_stats;
+#endif
+
+#if UART_ENABLE_CLOCK_GOVERNOR
+static volatile uint32_t rx_byte_count;     // Written by ISR
+static volatile uint32_t tx_byte_count;     // Written by ISR
+#endif
+
+static UART_IsrProfileTypeDef isr_profile;  // Written by ISR
+
+/**** Convenience Macros ****/
+#if UART_ENABLE_ISR_PROFILE
+// Charge the cycles since the previous mark to one path
+#define ISR_PROFILE_START()         uint32_t profile_start = UART_TIME_CYCLES(); \
+                                    uint32_t profile_mark = profile_start
+#define ISR_PROFILE_PATH(path)      (profile_mark = ProfilePath((path), profile_mark))
+#define ISR_PROFILE_END()           ProfileHandler(profile_start)
+#else
+#define ISR_PROFILE_START()
+#define ISR_PROFILE_PATH(path)
+#define ISR_PROFILE_END()
+#endif
+
+/*
+ * ISR feature hooks. UART_ISR_Handler() is written once against these;
+ * a disabled feature expands to nothing (or to a constant the compiler
+ * folds away even at -O0), so each build gets a straight-line ISR that
+ * holds only its own features (UART_ISR_FEATURES) and tests no feature
+ * flag at run time.
+ */
+#if UART_ENABLE_CLOCK_GOVERNOR
+#define HOOK_RX_COUNT()             (rx_byte_count++)
+#define HOOK_TX_COUNT()             (tx_byte_count++)
+#else
+#define HOOK_RX_COUNT()             ((void)0)
+#define HOOK_TX_COUNT()             ((void)0)
+#endif
+
+#if UART_ENABLE_HALF_DUPLEX
+#define HOOK_RX_IS_ECHO(c)          UART_HalfDuplex_IsEcho(c)   // Our own byte read back from the wire
+#define HOOK_TX_HALF_DUPLEX(c)      UART_HalfDuplex_OnTransmit(c)
+#else
+#define HOOK_RX_IS_ECHO(c)          false
+#define HOOK_TX_HALF_DUPLEX(c)      ((void)0)
+#endif
+
+#if UART_ENABLE_TIMESTAMPS
+#define HOOK_RX_TIMESTAMP(c)        do { \
+        if ((c) == UART_TIMESTAMP_MARKER) { \
+            rx_marker_ts[rx_markers_stored & (UART_RX_TIMESTAMP_DEPTH - 1)] = UART_TIME_US32(); \
+            rx_markers_stored++; \
+        } \
+    } while (0)
+#define HOOK_TX_POSITION()          uint32_t send_pos = RingReadPos(&tx_buffer)
+#define HOOK_TX_TIMESTAMP()         do { \
+        if (tx_stamp_state == TX_STAMP_PENDING && send_pos == tx_stamp_pos) { \
+            tx_stamp_ts = UART_TIME_US32(); \
+            tx_stamp_state = TX_STAMP_DONE; \
+        } \
+    } while (0)
+#else
+#define HOOK_RX_TIMESTAMP(c)        ((void)0)
+#define HOOK_TX_POSITION()          ((void)0)
+#define HOOK_TX_TIMESTAMP()         ((void)0)
+#endif
+
+#if UART_ENABLE_POLL
+#define HOOK_RX_POLL()              UpdateRxReadiness()
+#define HOOK_TX_POLL()              UpdateTxReadiness()
+#else
+#define HOOK_RX_POLL()              ((void)0)
+#define HOOK_TX_POLL()              ((void)0)
+#endif
+
+#if UART_ENABLE_THRESHOLDS
+#define HOOK_RX_THRESHOLD()         CheckRxThreshold()
+#define HOOK_TX_THRESHOLD()         CheckTxThreshold()
+#else
+#define HOOK_RX_THRESHOLD()         ((void)0)
+#define HOOK_TX_THRESHOLD()         ((void)0)
+#endif
+
+#if UART_ENABLE_SCHED_TX
+#define HOOK_TX_SCHEDULED(pc)       UART_SchedTx_NextByte(pc)   // Time-triggered frame owns the line
+#define HOOK_TX_GATED()             TxGated()
+#else
+#define HOOK_TX_SCHEDULED(pc)       false
+#define HOOK_TX_GATED()             false
+#endif
+
+#if UART_USE_FREERTOS
+#define HOOK_RX_RTOS(c)             UART_Rtos_RxHook(c)
+#define HOOK_TX_RTOS()              UART_Rtos_TxHook()
+#else
+#define HOOK_RX_RTOS(c)             ((void)0)
+#define HOOK_TX_RTOS()              ((void)0)
+#endif
+
+#if UART_BOOT_PROFILE
+#define HOOK_TX_BOOT_MARK()         UART_Boot_Mark(UART_BOOT_MARK_FIRST_TX)
+#else
+#define HOOK_TX_BOOT_MARK()         ((void)0)
+#endif
+
+// Every byte read from RDR / written to TDR, whatever its source
+#define ISR_ON_RX_BYTE(c)           do { HOOK_RX_COUNT(); } while (0)
+#define ISR_ON_TX_BYTE(c)           do { HOOK_TX_COUNT(); HOOK_TX_HALF_DUPLEX(c); HOOK_TX_BOOT_MARK(); } while (0)
+
+// A byte entered the RX ring / left the TX ring
+#define ISR_ON_RX_STORED(c)         do { HOOK_RX_TIMESTAMP(c); HOOK_RX_POLL(); HOOK_RX_THRESHOLD(); \
+                                         HOOK_RX_RTOS(c); } while (0)
+#define ISR_ON_TX_DEQUEUED()        do { HOOK_TX_TIMESTAMP(); HOOK_TX_POLL(); HOOK_TX_THRESHOLD(); \
+                                         HOOK_TX_RTOS(); } while (0)
 
 /**** Private Function Prototypes ****/
-static UART_ErrorTypeDef StoreChar(uint8_t c, RingBuffer_TypeDef *buffer);
+__STATIC_FORCEINLINE void ServiceInterrupt(UART_HandleTypeDef *huart);
+static UART_ErrorTypeDef StoreChar(uint8_t c, RingTypeDef *buffer);
+static UART_ErrorTypeDef FetchChar(RingTypeDef *buffer, uint8_t *c);
+static uint16_t RingCount(const RingTypeDef *buffer);
+#if UART_ENABLE_TIMESTAMPS || UART_ENABLE_SCHED_TX
+static uint32_t RingReadPos(const RingTypeDef *buffer);
+static uint32_t RingWritePos(const RingTypeDef *buffer);
+#endif
+#if UART_ENABLE_SCHED_TX
+static uint32_t RingSpan(uint32_t from, uint32_t to);
+static bool TxGated(void);
+#endif
+static uint16_t RingFree(const RingTypeDef *buffer);
+#if UART_ENABLE_THRESHOLDS
+static uint32_t RingCapacity(const RingTypeDef *buffer);
+#endif
+#if UART_ENABLE_POLL
+static void UpdateRxReadiness(void);
+static void UpdateTxReadiness(void);
+#endif
+#if UART_ENABLE_THRESHOLDS
+static void CheckRxThreshold(void);
+static void CheckTxThreshold(void);
+static void RearmRxThreshold(void);
+static void RearmTxThreshold(void);
+#endif
+#if UART_ENABLE_ISR_PROFILE
+static uint32_t ProfilePath(UART_IsrPathTypeDef path, uint32_t start);
+static void ProfileHandler(uint32_t start);
+#endif
 static bool IsTimeOutExpired(uint32_t timeout_ms);
 static void ResetTimeout(void);
+#if UART_ENABLE_TICKLESS_IDLE
+static uint32_t TimeoutRemaining(uint32_t timeout_ms);
+static bool TxHasRoom(void);
+#endif
 static size_t FindStringInBuffer(const char *str, const char *buffer, size_t buffer_len);
 static UART_ErrorTypeDef WaitForData(uint32_t timeout_ms);
 
@@ -39,17 +260,77 @@ static UART_ErrorTypeDef WaitForData(uint32_t timeout_ms);
  */
 UART_ErrorTypeDef UART_RingBuff_Init(void)
 {
-    // Clear buffers
-    memset(&rx_buffer, 0, sizeof(RingBuffer_TypeDef));
-    memset(&tx_buffer, 0, sizeof(RingBuffer_TypeDef));
+#if UART_ELASTIC_RINGS
+    // Both rings start with one segment and grow from the shared pool
+    UART_Pool_Init();
+    if (UART_ElasticRing_Init(&rx_buffer, UART_POOL_RX_MIN_SEGMENTS, UART_POOL_RX_MAX_SEGMENTS) != UART_SUCCESS ||
+        UART_ElasticRing_Init(&tx_buffer, UART_POOL_TX_MIN_SEGMENTS, UART_POOL_TX_MAX_SEGMENTS) != UART_SUCCESS) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+#else
+    // Clear buffers; the first call finds them zeroed by the startup .bss fill
+    static bool initialized;
+    if (initialized) {
+        memset(&rx_buffer, 0, sizeof(RingBuffer_TypeDef));
+        memset(&tx_buffer, 0, sizeof(RingBuffer_TypeDef));
+    }
+    initialized = true;
+#endif
 
     // Enable UART interrupts
     __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_ERR);
     __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_RXNE);
 
+#if UART_ENABLE_POLL
+    UpdateRxReadiness();
+    UpdateTxReadiness();
+#endif
+
+#if UART_ENABLE_THRESHOLDS
+    memset(&threshold_stats, 0, sizeof(threshold_stats));
+    rx_notify_armed = true;
+    tx_notify_armed = false;    // TX starts empty, nothing to wait for
+    __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_RTO);
+#endif
+
+#if UART_BOOT_PROFILE
+    UART_Boot_Mark(UART_BOOT_MARK_RX_READY);
+#endif
+
     return UART_SUCCESS;
 }
 
+/**
+ * @brief Select the USART kernel clock and reprogram BRR, keeping every other USART setting
+ * @param clock_source RCC_USART2CLKSOURCE_x
+ * @param baud New baud rate
+ */
+void UART_SetBaudRate(uint32_t clock_source, uint32_t baud)
+{
+    USART_TypeDef *usart = (UART_INSTANCE)->Instance;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t cr1 = usart->CR1;
+    CLEAR_BIT(usart->CR1, USART_CR1_UE);
+
+    __HAL_RCC_USART2_CONFIG(clock_source);
+    uint32_t kernel_hz = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_USART2);
+
+    if (READ_BIT(cr1, USART_CR1_OVER8)) {
+        uint32_t div = (2U * kernel_hz + baud / 2U) / baud;
+        usart->BRR = (div & 0xFFF0U) | ((div & 0x000FU) >> 1);
+    } else {
+        usart->BRR = (kernel_hz + baud / 2U) / baud;
+    }
+
+    usart->CR1 = cr1;
+    (UART_INSTANCE)->Init.BaudRate = baud;
+
+    __set_PRIMASK(primask);
+}
+
 /**
  * @brief Read a single character from RX buffer
  * @param c Pointer to store the character
@@ -62,12 +343,25 @@ UART_ErrorTypeDef UART_ReadChar(uint8_t *c)
     }
 
     // Check if buffer is empty
-    if (rx_buffer.head == rx_buffer.tail) {
+    if (FetchChar(&rx_buffer, c) != UART_SUCCESS) {
         return UART_ERROR_BUFFER_EMPTY;
     }
 
-    *c = rx_buffer.buffer[rx_buffer.tail];
-    rx_buffer.tail = (rx_buffer.tail + 1) % UART_BUFFER_SIZE;
+#if UART_ENABLE_TIMESTAMPS
+    // Markers are timestamped in arrival order, pair them up in read order
+    if (*c == UART_TIMESTAMP_MARKER) {
+        uint32_t index = rx_markers_read++;
+        rx_marker_last_valid = (rx_markers_stored - index) <= UART_RX_TIMESTAMP_DEPTH;
+        rx_marker_last_ts = rx_marker_ts[index & (UART_RX_TIMESTAMP_DEPTH - 1)];
+    }
+#endif
+
+#if UART_ENABLE_POLL
+    UpdateRxReadiness();
+#endif
+#if UART_ENABLE_THRESHOLDS
+    RearmRxThreshold();
+#endif
 
     return UART_SUCCESS;
 }
@@ -79,18 +373,37 @@ UART_ErrorTypeDef UART_ReadChar(uint8_t *c)
  */
 UART_ErrorTypeDef UART_WriteChar(uint8_t c)
 {
-    uint16_t next_head = (tx_buffer.head + 1) % UART_BUFFER_SIZE;
-
     // Wait if buffer is full (with timeout)
     ResetTimeout();
-    while (next_head == tx_buffer.tail) {
+    while (StoreChar(c, &tx_buffer) != UART_SUCCESS) {
+#if UART_USE_FREERTOS
+        if (UART_Rtos_CanBlock()) {
+            // Sleep until the ISR has drained some space instead of spinning
+            UART_ErrorTypeDef status = UART_Rtos_WaitTx(1, UART_RTOS_DEADLINE_MS(DEFAULT_TIMEOUT_MS));
+            if (status == UART_SUCCESS) {
+                continue;
+            }
+            if (status != UART_ERROR_BUSY) {
+                return status;
+            }
+            // Another task holds the single TX wait slot; poll under the timeout below
+        }
+#endif
         if (IsTimeOutExpired(DEFAULT_TIMEOUT_MS)) {
             return UART_ERROR_TIMEOUT;
         }
+#if UART_ENABLE_TICKLESS_IDLE
+        // Sleep until the TX interrupt frees a slot or the deadline passes
+        UART_Idle_Sleep(TimeoutRemaining(DEFAULT_TIMEOUT_MS), TxHasRoom);
+#endif
     }
 
-    tx_buffer.buffer[tx_buffer.head] = c;
-    tx_buffer.head = next_head;
+#if UART_ENABLE_POLL
+    UpdateTxReadiness();
+#endif
+#if UART_ENABLE_THRESHOLDS
+    RearmTxThreshold();
+#endif
 
     // Enable TX interrupt
     __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_TXE);
@@ -117,6 +430,7 @@ UART_ErrorTypeDef UART_SendString(const char *str)
         str++;
     }
 
+    UART_TxMarkBoundary();
     return UART_SUCCESS;
 }
 
@@ -126,7 +440,287 @@ UART_ErrorTypeDef UART_SendString(const char *str)
  */
 uint16_t UART_Available(void)
 {
-    return (UART_BUFFER_SIZE + rx_buffer.head - rx_buffer.tail) % UART_BUFFER_SIZE;
+    return RingCount(&rx_buffer);
+}
+
+/**
+ * @brief Check whether the RX buffer holds any data
+ * @return true if at least one byte can be read
+ */
+bool UART_RxPending(void)
+{
+    return RingCount(&rx_buffer) != 0U;
+}
+
+/**
+ * @brief Check free space in TX buffer
+ * @return Number of bytes that can be written without waiting
+ */
+uint16_t UART_TxFree(void)
+{
+    return RingFree(&tx_buffer);
+}
+
+/**
+ * @brief Get the number of bytes moved by the ISR since initialization
+ * @param rx_bytes Pointer to store the received byte count, may be NULL
+ * @param tx_bytes Pointer to store the transmitted byte count, may be NULL
+ */
+void UART_GetByteCounts(uint32_t *rx_bytes, uint32_t *tx_bytes)
+{
+#if UART_ENABLE_CLOCK_GOVERNOR
+    uint32_t rx = rx_byte_count;
+    uint32_t tx = tx_byte_count;
+#else
+    uint32_t rx = 0;
+    uint32_t tx = 0;
+#endif
+
+    if (rx_bytes != NULL) {
+        *rx_bytes = rx;
+    }
+    if (tx_bytes != NULL) {
+        *tx_bytes = tx;
+    }
+}
+
+/**
+ * @brief Get the contiguous free span at the TX write position
+ * @param span Pointer to store the span start
+ * @return Bytes that can be written to the span, 0 if TX is full
+ */
+uint16_t UART_TxReserve(uint8_t **span)
+{
+    if (span == NULL) {
+        return 0;
+    }
+
+#if UART_ELASTIC_RINGS
+    return UART_ElasticRing_Reserve(&tx_buffer, span);
+#else
+    uint16_t head = tx_buffer.head;
+    uint16_t tail = tx_buffer.tail;
+    uint16_t len;
+
+    // One slot stays empty to tell full from empty
+    if (head >= tail) {
+        len = (uint16_t)(((tail == 0) ? UART_BUFFER_SIZE - 1U : UART_BUFFER_SIZE) - head);
+    } else {
+        len = (uint16_t)(tail - 1U - head);
+    }
+
+    *span = &tx_buffer.buffer[head];
+    return len;
+#endif
+}
+
+/**
+ * @brief Publish bytes written into a reserved span and start sending
+ * @param len Bytes written
+ */
+void UART_TxCommit(uint16_t len)
+{
+    if (len == 0) {
+        return;
+    }
+
+#if UART_ELASTIC_RINGS
+    UART_ElasticRing_Commit(&tx_buffer, len);
+#else
+    __DMB();    // Data lands before the ISR can see the new head
+    tx_buffer.head = (uint16_t)((tx_buffer.head + len) % UART_BUFFER_SIZE);
+#endif
+
+#if UART_ENABLE_POLL
+    UpdateTxReadiness();
+#endif
+#if UART_ENABLE_THRESHOLDS
+    RearmTxThreshold();
+#endif
+
+    __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_TXE);
+}
+
+/**
+ * @brief Get the contiguous run of received data at the RX read position
+ * @param span Pointer to store the span start
+ * @return Bytes readable from the span, 0 if RX is empty
+ */
+uint16_t UART_RxPeekSpan(const uint8_t **span)
+{
+    if (span == NULL) {
+        return 0;
+    }
+
+#if UART_ELASTIC_RINGS
+    return UART_ElasticRing_PeekSpan(&rx_buffer, span);
+#else
+    uint16_t head = rx_buffer.head;
+    uint16_t tail = rx_buffer.tail;
+
+    *span = &rx_buffer.buffer[tail];
+    return (uint16_t)((head >= tail) ? head - tail : UART_BUFFER_SIZE - tail);
+#endif
+}
+
+/**
+ * @brief Get all received data at the RX read position, in up to two parts
+ * @param slice Pointer to store the parts
+ * @return Bytes readable from the slice, 0 if RX is empty
+ */
+uint16_t UART_RxPeekSlice(UART_SliceTypeDef *slice)
+{
+    if (slice == NULL) {
+        return 0;
+    }
+
+    slice->part[1] = NULL;
+    slice->len[1] = 0;
+
+#if UART_ELASTIC_RINGS
+    slice->part[0] = NULL;
+    slice->len[0] = UART_ElasticRing_PeekSpan(&rx_buffer, &slice->part[0]);
+    return slice->len[0];
+#else
+    uint16_t head = rx_buffer.head;
+    uint16_t tail = rx_buffer.tail;
+
+    slice->part[0] = &rx_buffer.buffer[tail];
+    if (head >= tail) {
+        slice->len[0] = head - tail;
+    } else {
+        slice->len[0] = UART_BUFFER_SIZE - tail;
+        slice->part[1] = &rx_buffer.buffer[0];
+        slice->len[1] = head;
+    }
+
+    return (uint16_t)(slice->len[0] + slice->len[1]);
+#endif
+}
+
+/**
+ * @brief Release bytes at the RX read position
+ * @param len Bytes consumed
+ */
+void UART_RxConsume(uint16_t len)
+{
+    if (len == 0) {
+        return;
+    }
+
+#if UART_ENABLE_TIMESTAMPS
+    // Keep marker timestamps paired with the bytes that are still unread
+    const uint8_t *span;
+    uint16_t avail = UART_RxPeekSpan(&span);
+    uint32_t markers = 0;
+    for (uint16_t i = 0; i < len && i < avail; i++) {
+        if (span[i] == UART_TIMESTAMP_MARKER) {
+            markers++;
+        }
+    }
+    if (markers != 0) {
+        uint32_t index = rx_markers_read + markers - 1U;
+        rx_markers_read += markers;
+        rx_marker_last_valid = (rx_markers_stored - index) <= UART_RX_TIMESTAMP_DEPTH;
+        rx_marker_last_ts = rx_marker_ts[index & (UART_RX_TIMESTAMP_DEPTH - 1)];
+    }
+#endif
+
+#if UART_ELASTIC_RINGS
+    UART_ElasticRing_Consume(&rx_buffer, len);
+#else
+    __DMB();    // Reads of the span complete before the ISR may reuse it
+    rx_buffer.tail = (uint16_t)((rx_buffer.tail + len) % UART_BUFFER_SIZE);
+#endif
+
+#if UART_ENABLE_POLL
+    UpdateRxReadiness();
+#endif
+#if UART_ENABLE_THRESHOLDS
+    RearmRxThreshold();
+#endif
+}
+
+/**
+ * @brief Copy received data out of the RX buffer
+ * @param data Destination
+ * @param len Largest number of bytes to read
+ * @return Bytes read, 0 if RX is empty
+ */
+uint16_t UART_ReadBlock(uint8_t *data, uint16_t len)
+{
+    if (data == NULL) {
+        return 0;
+    }
+
+#if UART_ELASTIC_RINGS
+    // Segments are not contiguous, copy one span at a time
+    const uint8_t *span;
+    uint16_t done = 0;
+    uint16_t n;
+
+    while (done < len && (n = UART_RxPeekSpan(&span)) != 0) {
+        if (n > len - done) {
+            n = (uint16_t)(len - done);
+        }
+        UART_Copy(&data[done], span, n);
+        UART_RxConsume(n);
+        done = (uint16_t)(done + n);
+    }
+    return done;
+#else
+    uint16_t avail = RingCount(&rx_buffer);
+    if (len > avail) {
+        len = avail;
+    }
+
+    uint16_t first = (uint16_t)UART_Copy_FromRing(data, rx_buffer.buffer, UART_BUFFER_SIZE,
+                                                  rx_buffer.tail, len);
+
+    // One release per segment, as UART_RxConsume() expects for a peeked span
+    UART_RxConsume(first);
+    UART_RxConsume((uint16_t)(len - first));
+    return len;
+#endif
+}
+
+/**
+ * @brief Copy data into the TX buffer and start sending
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return Bytes queued, fewer than len if TX filled up
+ */
+uint16_t UART_WriteBlock(const uint8_t *data, uint16_t len)
+{
+    if (data == NULL) {
+        return 0;
+    }
+
+#if UART_ELASTIC_RINGS
+    // Segments are not contiguous, copy one span at a time
+    uint8_t *span;
+    uint16_t done = 0;
+    uint16_t n;
+
+    while (done < len && (n = UART_TxReserve(&span)) != 0) {
+        if (n > len - done) {
+            n = (uint16_t)(len - done);
+        }
+        UART_Copy(span, &data[done], n);
+        UART_TxCommit(n);
+        done = (uint16_t)(done + n);
+    }
+    return done;
+#else
+    uint16_t room = RingFree(&tx_buffer);
+    if (len > room) {
+        len = room;
+    }
+
+    UART_Copy_ToRing(tx_buffer.buffer, UART_BUFFER_SIZE, tx_buffer.head, data, len);
+    UART_TxCommit(len);
+    return len;
+#endif
 }
 
 /**
@@ -140,12 +734,16 @@ UART_ErrorTypeDef UART_Peek(uint8_t *c)
         return UART_ERROR_INVALID_PARAM;
     }
 
+#if UART_ELASTIC_RINGS
+    return UART_ElasticRing_Peek(&rx_buffer, c);
+#else
     if (rx_buffer.head == rx_buffer.tail) {
         return UART_ERROR_BUFFER_EMPTY;
     }
 
     *c = rx_buffer.buffer[rx_buffer.tail];
     return UART_SUCCESS;
+#endif
 }
 
 /**
@@ -154,9 +752,23 @@ UART_ErrorTypeDef UART_Peek(uint8_t *c)
 void UART_FlushRX(void)
 {
     __disable_irq();
+#if UART_ELASTIC_RINGS
+    UART_ElasticRing_Flush(&rx_buffer);
+#else
     rx_buffer.head = 0;
     rx_buffer.tail = 0;
     memset(rx_buffer.buffer, 0, UART_BUFFER_SIZE);
+#endif
+#if UART_ENABLE_TIMESTAMPS
+    rx_markers_read = rx_markers_stored;
+    rx_marker_last_valid = false;
+#endif
+#if UART_ENABLE_POLL
+    UpdateRxReadiness();
+#endif
+#if UART_ENABLE_THRESHOLDS
+    rx_notify_armed = true;
+#endif
     __enable_irq();
 }
 
@@ -300,6 +912,273 @@ UART_ErrorTypeDef UART_ExtractBetween(const char *start_str, const char *end_str
     return UART_SUCCESS;
 }
 
+/**
+ * @brief Get the receive time of the marker byte last returned by UART_ReadChar()
+ * @param timestamp_us Pointer to store the timestamp
+ * @return UART_SUCCESS on success, UART_ERROR_NOT_FOUND if no valid timestamp
+ */
+UART_ErrorTypeDef UART_GetRxMarkerTimestamp(uint32_t *timestamp_us)
+{
+    if (timestamp_us == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+#if UART_ENABLE_TIMESTAMPS
+    if (rx_marker_last_valid) {
+        *timestamp_us = rx_marker_last_ts;
+        return UART_SUCCESS;
+    }
+#endif
+
+    return UART_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief Timestamp the next byte written to the TX buffer when it is sent
+ */
+void UART_RequestTxTimestamp(void)
+{
+#if UART_ENABLE_TIMESTAMPS
+    __disable_irq();
+    tx_stamp_pos = RingWritePos(&tx_buffer);
+    tx_stamp_state = TX_STAMP_PENDING;
+    __enable_irq();
+#endif
+}
+
+/**
+ * @brief Get the send time of the byte selected by UART_RequestTxTimestamp()
+ * @param timestamp_us Pointer to store the timestamp
+ * @return UART_SUCCESS on success, UART_ERROR_NOT_FOUND if not sent yet
+ */
+UART_ErrorTypeDef UART_GetTxTimestamp(uint32_t *timestamp_us)
+{
+    if (timestamp_us == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+#if UART_ENABLE_TIMESTAMPS
+    if (tx_stamp_state == TX_STAMP_DONE) {
+        *timestamp_us = tx_stamp_ts;
+        return UART_SUCCESS;
+    }
+#endif
+
+    return UART_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief Mark the end of a complete message in the TX buffer
+ */
+void UART_TxMarkBoundary(void)
+{
+#if UART_ENABLE_SCHED_TX
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    tx_boundary_pos = RingWritePos(&tx_buffer);
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * @brief Stop sending from the TX buffer at the next message boundary
+ */
+void UART_TxHold(void)
+{
+#if UART_ENABLE_SCHED_TX
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (tx_gate == TX_GATE_OPEN) {
+        uint32_t read_pos = RingReadPos(&tx_buffer);
+        uint32_t write_pos = RingWritePos(&tx_buffer);
+
+        // The last mark is usable only if ring TX has not gone past it yet; writers that
+        // never mark (WriteChar, WriteBlock, ...) end their message at what is queued now
+        if (RingSpan(read_pos, tx_boundary_pos) <= RingSpan(read_pos, write_pos)) {
+            tx_hold_pos = tx_boundary_pos;
+        } else {
+            tx_hold_pos = write_pos;
+        }
+        tx_gate = TX_GATE_CLOSING;
+    }
+    (void)TxGated();
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * @brief Resume sending from the TX buffer after UART_TxHold()
+ */
+void UART_TxRelease(void)
+{
+#if UART_ENABLE_SCHED_TX
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    tx_gate = TX_GATE_OPEN;
+    tx_slot_due = false;
+    __HAL_UART_DISABLE_IT(UART_INSTANCE, UART_IT_TC);
+    if (RingCount(&tx_buffer) != 0U) {
+        __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_TXE);
+    }
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * @brief Hand the line to the scheduled frame once the held TX buffer is idle
+ * @return true if the line was already idle, false if the start waits for ring TX or TC
+ */
+bool UART_TxStartScheduled(void)
+{
+#if UART_ENABLE_SCHED_TX
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    UART_TxHold();      // No-op when the guard compare has already closed the gate
+    bool idle = (tx_gate == TX_GATE_CLOSED) &&
+                (READ_REG((UART_INSTANCE)->Instance->ISR) & USART_ISR_TC);
+    tx_slot_due = true;
+    (void)TxGated();
+
+    __set_PRIMASK(primask);
+    return idle;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Configure the RX notification
+ * @param bytes Byte-count threshold, 0 to disable
+ * @param idle_us Idle time threshold, 0 to disable
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if out of range
+ */
+UART_ErrorTypeDef UART_SetRxThreshold(uint16_t bytes, uint32_t idle_us)
+{
+#if UART_ENABLE_THRESHOLDS
+    // Idle detection uses the USART receiver timeout, counted in bit periods
+    uint64_t idle_bits = ((uint64_t)idle_us * (UART_INSTANCE)->Init.BaudRate + 999999U) / 1000000U;
+
+    if (bytes > RingCapacity(&rx_buffer) || idle_bits > USART_RTOR_RTO) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    rx_threshold = bytes;
+    rx_notify_armed = (bytes == 0U) || (RingCount(&rx_buffer) < bytes);
+    __enable_irq();
+
+    if (idle_bits == 0U) {
+        HAL_UART_DisableReceiverTimeout(UART_INSTANCE);
+    } else {
+        HAL_UART_ReceiverTimeout_Config(UART_INSTANCE, (uint32_t)idle_bits);
+        HAL_UART_EnableReceiverTimeout(UART_INSTANCE);
+    }
+
+    return UART_SUCCESS;
+#else
+    (void)bytes;
+    (void)idle_us;
+    return UART_ERROR_INVALID_PARAM;
+#endif
+}
+
+/**
+ * @brief Configure the TX notification
+ * @param free_bytes Free-space threshold, 0 to disable
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if out of range
+ */
+UART_ErrorTypeDef UART_SetTxThreshold(uint16_t free_bytes)
+{
+#if UART_ENABLE_THRESHOLDS
+    if (free_bytes > RingCapacity(&tx_buffer)) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    tx_threshold = free_bytes;
+    tx_notify_armed = (free_bytes != 0U) && (RingFree(&tx_buffer) < free_bytes);
+    __enable_irq();
+
+    return UART_SUCCESS;
+#else
+    (void)free_bytes;
+    return UART_ERROR_INVALID_PARAM;
+#endif
+}
+
+/**
+ * @brief Get threshold notification counters
+ * @param stats Destination for a snapshot of the counters
+ */
+void UART_GetThresholdStats(UART_ThresholdStatsTypeDef *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+#if UART_ENABLE_THRESHOLDS
+    __disable_irq();
+    *stats = threshold_stats;
+    __enable_irq();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/**
+ * @brief Get the ISR cycle profile and line error counters
+ * @param profile Destination for a snapshot
+ */
+void UART_GetIsrProfile(UART_IsrProfileTypeDef *profile)
+{
+    if (profile == NULL) {
+        return;
+    }
+
+    __disable_irq();
+    *profile = isr_profile;
+    __enable_irq();
+}
+
+/**
+ * @brief Restart the ISR cycle profile
+ */
+void UART_ResetIsrProfile(void)
+{
+    __disable_irq();
+    memset(isr_profile.path, 0, sizeof(isr_profile.path));
+    isr_profile.handler_cycles_max = 0;
+    isr_profile.entry_sp_min = 0;
+    __enable_irq();
+}
+
+/**
+ * @brief RX notification, called from the UART ISR
+ * @param event What triggered the notification
+ * @param available Bytes buffered in RX
+ */
+__weak void UART_RxThresholdCallback(UART_RxEventTypeDef event, uint16_t available)
+{
+    UNUSED(event);
+    UNUSED(available);
+}
+
+/**
+ * @brief TX notification, called from the UART ISR
+ * @param free_bytes Bytes free in TX
+ */
+__weak void UART_TxThresholdCallback(uint16_t free_bytes)
+{
+    UNUSED(free_bytes);
+}
+
 /**
  * @brief UART ISR handler - call this from your UART interrupt
  * @param huart UART handle
@@ -310,34 +1189,260 @@ void UART_ISR_Handler(UART_HandleTypeDef *huart)
         return;
     }
 
+    ServiceInterrupt(huart);
+}
+
+#if UART_ENABLE_ISR_BENCHMARK
+/**
+ * @brief Time each ISR path of this build on a RAM image of the USART registers
+ * @param result Pointer to store DWT cycle counts and the feature set
+ * @return UART_SUCCESS on success, UART_ERROR_BUSY if a ring holds data or TX is running
+ */
+UART_ErrorTypeDef UART_BenchmarkIsr(UART_IsrBenchmarkTypeDef *result)
+{
+    if (result == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    // The handler reads and writes this instead of USART2; flags are set per path
+    USART_TypeDef regs;
+    UART_HandleTypeDef handle = *UART_INSTANCE;
+    UART_IsrProfileTypeDef saved_profile;
+    uint32_t total;
+    uint32_t start;
+    uint8_t c;
+    uint32_t primask = __get_PRIMASK();
+
+    memset(&regs, 0, sizeof(regs));
+    handle.Instance = &regs;
+    result->features = UART_ISR_FEATURES;
+
+    // Interrupts masked so the real ISR cannot touch the rings meanwhile
+    __disable_irq();
+
+    // The paths run on the live rings, so only bytes of its own may pass through them
+    if (RingCount(&rx_buffer) != 0U || RingCount(&tx_buffer) != 0U ||
+        READ_BIT((UART_INSTANCE)->Instance->CR1, USART_CR1_TXEIE | USART_CR1_TCIE)) {
+        __set_PRIMASK(primask);
+        return UART_ERROR_BUSY;
+    }
+
+    // Save what the hooks record and park what they would notify; each hook takes its idle path
+    saved_profile = isr_profile;
+#if UART_ENABLE_CLOCK_GOVERNOR
+    uint32_t saved_rx_count = rx_byte_count;
+    uint32_t saved_tx_count = tx_byte_count;
+#endif
+#if UART_ENABLE_TIMESTAMPS
+    uint32_t saved_marker_ts[UART_RX_TIMESTAMP_DEPTH];
+    uint32_t saved_markers_stored = rx_markers_stored;
+    uint32_t saved_stamp_state = tx_stamp_state;
+    memcpy(saved_marker_ts, rx_marker_ts, sizeof(saved_marker_ts));
+    tx_stamp_state = TX_STAMP_IDLE;
+#endif
+#if UART_ENABLE_THRESHOLDS
+    UART_ThresholdStatsTypeDef saved_threshold_stats = threshold_stats;
+    bool saved_rx_armed = rx_notify_armed;
+    bool saved_tx_armed = tx_notify_armed;
+    rx_notify_armed = false;
+    tx_notify_armed = false;
+#endif
+#if UART_ENABLE_SCHED_TX
+    TxGateTypeDef saved_gate = tx_gate;
+    bool saved_slot_due = tx_slot_due;
+    tx_gate = TX_GATE_OPEN;
+    tx_slot_due = false;
+#endif
+#if UART_ENABLE_HALF_DUPLEX
+    UART_HalfDuplex_HoldEcho(true);
+#endif
+#if UART_USE_FREERTOS
+    UART_Rtos_HoldWakeups(true);
+#endif
+#if UART_BOOT_PROFILE
+    uint32_t saved_marks = UART_Boot_GetMarks();
+#endif
+
+    regs.CR1 = USART_CR1_RXNEIE | USART_CR1_TXEIE;
+    start = UART_TIME_CYCLES();
+    ServiceInterrupt(&handle);
+    result->idle_cycles = UART_TIME_CYCLES() - start;
+
+    // Not the timestamp marker, so the RX path is the common one
+    regs.ISR = USART_ISR_RXNE;
+    regs.RDR = 0x55U;
+    total = 0;
+    for (uint32_t i = 0; i < ISR_BENCH_ITERATIONS; i++) {
+        start = UART_TIME_CYCLES();
+        ServiceInterrupt(&handle);
+        total += UART_TIME_CYCLES() - start;
+    }
+    result->rx_cycles = total / ISR_BENCH_ITERATIONS;
+
+    // RX was empty and interrupts are masked, so every byte in it is one of ours
+    while (FetchChar(&rx_buffer, &c) == UART_SUCCESS) {
+    }
+
+    // TX is idle, so the ring holds exactly the bytes queued here
+    for (uint32_t i = 0; i < ISR_BENCH_ITERATIONS; i++) {
+        (void)StoreChar((uint8_t)i, &tx_buffer);
+    }
+    regs.ISR = USART_ISR_TXE;
+    total = 0;
+    for (uint32_t i = 0; i < ISR_BENCH_ITERATIONS; i++) {
+        start = UART_TIME_CYCLES();
+        ServiceInterrupt(&handle);
+        total += UART_TIME_CYCLES() - start;
+    }
+    result->tx_cycles = total / ISR_BENCH_ITERATIONS;
+
+    start = UART_TIME_CYCLES();
+    ServiceInterrupt(&handle);
+    result->tx_empty_cycles = UART_TIME_CYCLES() - start;
+
+    regs.ISR = USART_ISR_ORE;
+    start = UART_TIME_CYCLES();
+    ServiceInterrupt(&handle);
+    result->error_cycles = UART_TIME_CYCLES() - start;
+
+    isr_profile = saved_profile;
+#if UART_ENABLE_CLOCK_GOVERNOR
+    rx_byte_count = saved_rx_count;
+    tx_byte_count = saved_tx_count;
+#endif
+#if UART_ENABLE_TIMESTAMPS
+    memcpy(rx_marker_ts, saved_marker_ts, sizeof(saved_marker_ts));
+    rx_markers_stored = saved_markers_stored;
+    tx_stamp_state = saved_stamp_state;
+#endif
+#if UART_ENABLE_THRESHOLDS
+    threshold_stats = saved_threshold_stats;
+    rx_notify_armed = saved_rx_armed;
+    tx_notify_armed = saved_tx_armed;
+#endif
+#if UART_ENABLE_SCHED_TX
+    tx_gate = saved_gate;
+    tx_slot_due = saved_slot_due;
+#endif
+#if UART_ENABLE_HALF_DUPLEX
+    UART_HalfDuplex_HoldEcho(false);
+#endif
+#if UART_USE_FREERTOS
+    UART_Rtos_HoldWakeups(false);
+#endif
+#if UART_BOOT_PROFILE
+    UART_Boot_RestoreMarks(saved_marks);
+#endif
+#if UART_ENABLE_POLL
+    // Both rings are empty again, as they were on entry
+    UpdateRxReadiness();
+    UpdateTxReadiness();
+#endif
+    __set_PRIMASK(primask);
+
+    return UART_SUCCESS;
+}
+#endif /* UART_ENABLE_ISR_BENCHMARK */
+
+/**** Private Functions ****/
+
+/**
+ * @brief Body of UART_ISR_Handler(), assembled from the ISR feature hooks
+ * @param huart UART handle
+ */
+__STATIC_FORCEINLINE void ServiceInterrupt(UART_HandleTypeDef *huart)
+{
+    ISR_PROFILE_START();
     uint32_t isr_flags = READ_REG(huart->Instance->ISR);
     uint32_t cr1_flags = READ_REG(huart->Instance->CR1);
 
+    // Line errors are cleared here: HAL_UART_IRQHandler() would end reception on an overrun
+    uint32_t error_flags = isr_flags & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE | USART_ISR_PE);
+    if (error_flags != 0U) {
+        huart->Instance->ICR = error_flags;     // Clear bits sit at the same positions as the flags
+        if (error_flags & USART_ISR_ORE) {
+            isr_profile.overrun_errors++;
+        }
+        if (error_flags & USART_ISR_FE) {
+            isr_profile.framing_errors++;
+        }
+        if (error_flags & USART_ISR_NE) {
+            isr_profile.noise_errors++;
+        }
+        if (error_flags & USART_ISR_PE) {
+            isr_profile.parity_errors++;
+        }
+        ISR_PROFILE_PATH(UART_ISR_PATH_ERROR);
+    }
+
     // Handle RX interrupt
     if ((isr_flags & USART_ISR_RXNE) && (cr1_flags & USART_CR1_RXNEIE)) {
         // Clear flags by reading SR then DR
         (void)huart->Instance->ISR;
         uint8_t received_char = (uint8_t)huart->Instance->RDR;
-        StoreChar(received_char, &rx_buffer);
+        ISR_ON_RX_BYTE(received_char);
+
+        if (!HOOK_RX_IS_ECHO(received_char) && StoreChar(received_char, &rx_buffer) == UART_SUCCESS) {
+            ISR_ON_RX_STORED(received_char);
+        }
+        ISR_PROFILE_PATH(UART_ISR_PATH_RX);
+    }
+
+#if UART_ENABLE_THRESHOLDS
+    // Receiver timeout: the line has been idle for the configured time since the last byte
+    if ((isr_flags & USART_ISR_RTOF) && (cr1_flags & USART_CR1_RTOIE)) {
+        __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_RTOF);
+
+        uint16_t available = RingCount(&rx_buffer);
+        if (rx_notify_armed && available != 0U) {
+            rx_notify_armed = false;
+            threshold_stats.rx_idle_events++;
+            UART_RxThresholdCallback(UART_RX_EVENT_IDLE, available);
+        }
+        ISR_PROFILE_PATH(UART_ISR_PATH_RX);
     }
+#endif
+
+#if UART_ENABLE_SCHED_TX
+    // Slot start: ring TX stopped at a message boundary and the line is idle
+    if ((isr_flags & USART_ISR_TC) && (cr1_flags & USART_CR1_TCIE)) {
+        uint8_t c;
+        __HAL_UART_DISABLE_IT(huart, UART_IT_TC);
+
+        if (UART_SchedTx_Start(&c)) {
+            huart->Instance->TDR = c;
+            ISR_ON_TX_BYTE(c);
+            __HAL_UART_ENABLE_IT(huart, UART_IT_TXE);
+        }
+        isr_flags &= ~USART_ISR_TXE;    // TDR is full again, the rest goes out on the next TXE
+        ISR_PROFILE_PATH(UART_ISR_PATH_TX);
+    }
+#endif
 
     // Handle TX interrupt
     if ((isr_flags & USART_ISR_TXE) && (cr1_flags & USART_CR1_TXEIE)) {
-        if (tx_buffer.head == tx_buffer.tail) {
-            // Buffer empty, disable TX interrupt
-            __HAL_UART_DISABLE_IT(huart, UART_IT_TXE);
-        } else {
-            // Send next character
-            uint8_t c = tx_buffer.buffer[tx_buffer.tail];
-            tx_buffer.tail = (tx_buffer.tail + 1) % UART_BUFFER_SIZE;
+        uint8_t c;
+        HOOK_TX_POSITION();
 
+        if (HOOK_TX_SCHEDULED(&c)) {
+            // Time-triggered frame owns the line until it is fully sent
+            huart->Instance->TDR = c;
+            ISR_ON_TX_BYTE(c);
+        } else if (!HOOK_TX_GATED() && FetchChar(&tx_buffer, &c) == UART_SUCCESS) {
+            // Send next character
             (void)huart->Instance->ISR;
             huart->Instance->TDR = c;
+            ISR_ON_TX_BYTE(c);
+            ISR_ON_TX_DEQUEUED();
+        } else {
+            // Buffer empty, disable TX interrupt
+            __HAL_UART_DISABLE_IT(huart, UART_IT_TXE);
         }
+        ISR_PROFILE_PATH(UART_ISR_PATH_TX);
     }
-}
 
-/**** Private Functions ****/
+    ISR_PROFILE_END();
+}
 
 /**
  * @brief Store character in ring buffer
@@ -345,8 +1450,11 @@ void UART_ISR_Handler(UART_HandleTypeDef *huart)
  * @param buffer Ring buffer
  * @return UART_SUCCESS on success, UART_ERROR_BUFFER_FULL if buffer is full
  */
-static UART_ErrorTypeDef StoreChar(uint8_t c, RingBuffer_TypeDef *buffer)
+static UART_ErrorTypeDef StoreChar(uint8_t c, RingTypeDef *buffer)
 {
+#if UART_ELASTIC_RINGS
+    return UART_ElasticRing_Put(buffer, c);
+#else
     uint16_t next_head = (buffer->head + 1) % UART_BUFFER_SIZE;
 
     // Check for buffer overflow
@@ -358,7 +1466,308 @@ static UART_ErrorTypeDef StoreChar(uint8_t c, RingBuffer_TypeDef *buffer)
     buffer->head = next_head;
 
     return UART_SUCCESS;
+#endif
+}
+
+/**
+ * @brief Take the oldest character from a ring buffer
+ * @param buffer Ring buffer
+ * @param c Pointer to store the character
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if no data
+ */
+static UART_ErrorTypeDef FetchChar(RingTypeDef *buffer, uint8_t *c)
+{
+#if UART_ELASTIC_RINGS
+    return UART_ElasticRing_Get(buffer, c);
+#else
+    if (buffer->head == buffer->tail) {
+        return UART_ERROR_BUFFER_EMPTY;
+    }
+
+    *c = buffer->buffer[buffer->tail];
+    buffer->tail = (buffer->tail + 1) % UART_BUFFER_SIZE;
+
+    return UART_SUCCESS;
+#endif
+}
+
+/**
+ * @brief Number of characters stored in a ring buffer
+ * @param buffer Ring buffer
+ * @return Character count
+ */
+static uint16_t RingCount(const RingTypeDef *buffer)
+{
+#if UART_ELASTIC_RINGS
+    return (uint16_t)UART_ElasticRing_Count(buffer);
+#else
+    return (UART_BUFFER_SIZE + buffer->head - buffer->tail) % UART_BUFFER_SIZE;
+#endif
+}
+
+/**
+ * @brief Free space left in a ring buffer
+ * @param buffer Ring buffer
+ * @return Characters that can still be stored
+ * @note For elastic rings this is what the pool can supply now, not the max_segments limit
+ */
+static uint16_t RingFree(const RingTypeDef *buffer)
+{
+#if UART_ELASTIC_RINGS
+    uint32_t room = UART_ElasticRing_Free(buffer);
+    return (uint16_t)((room < UINT16_MAX) ? room : UINT16_MAX);
+#else
+    return (uint16_t)(UART_BUFFER_SIZE - 1U - RingCount(buffer));
+#endif
+}
+
+#if UART_ENABLE_THRESHOLDS
+/**
+ * @brief Most characters a ring buffer can ever hold
+ * @param buffer Ring buffer
+ * @return Capacity; for elastic rings the max_segments limit, whether or not the pool has them now
+ */
+static uint32_t RingCapacity(const RingTypeDef *buffer)
+{
+#if UART_ELASTIC_RINGS
+    return (uint32_t)buffer->max_segments * UART_POOL_SEGMENT_SIZE;
+#else
+    (void)buffer;
+    return UART_BUFFER_SIZE - 1U;
+#endif
 }
+#endif
+
+#if UART_ENABLE_POLL
+/**
+ * @brief Publish whether RX holds at least UART_POLL_RX_THRESHOLD characters
+ * @note Safe from thread and ISR context
+ */
+static void UpdateRxReadiness(void)
+{
+    uint32_t event = UART_POLL_READABLE(UART_PORT_USART2);
+    bool ready = RingCount(&rx_buffer) >= UART_POLL_RX_THRESHOLD;
+
+    if (ready == ((UART_Poll_Ready() & event) != 0U)) {
+        return;     // Common case: no change, no atomic update
+    }
+
+    if (ready) {
+        UART_Poll_SetReady(event);
+    } else {
+        UART_Poll_ClearReady(event);
+        // The ISR may have stored data between the count and the clear
+        if (RingCount(&rx_buffer) >= UART_POLL_RX_THRESHOLD) {
+            UART_Poll_SetReady(event);
+        }
+    }
+}
+
+/**
+ * @brief Publish whether TX has at least UART_POLL_TX_THRESHOLD free slots
+ * @note Safe from thread and ISR context
+ */
+static void UpdateTxReadiness(void)
+{
+    uint32_t event = UART_POLL_WRITABLE(UART_PORT_USART2);
+    bool ready = RingFree(&tx_buffer) >= UART_POLL_TX_THRESHOLD;
+
+    if (ready == ((UART_Poll_Ready() & event) != 0U)) {
+        return;
+    }
+
+    if (ready) {
+        UART_Poll_SetReady(event);
+    } else {
+        UART_Poll_ClearReady(event);
+        // The ISR may have drained data between the count and the clear
+        if (RingFree(&tx_buffer) >= UART_POLL_TX_THRESHOLD) {
+            UART_Poll_SetReady(event);
+        }
+    }
+}
+#endif /* UART_ENABLE_POLL */
+
+#if UART_ENABLE_THRESHOLDS
+/**
+ * @brief Fire the RX notification if a stored byte reached the threshold
+ * @note ISR context
+ */
+static void CheckRxThreshold(void)
+{
+    if (!rx_notify_armed || rx_threshold == 0U) {
+        return;     // Common case: one load and out
+    }
+
+    uint16_t available = RingCount(&rx_buffer);
+    if (available >= rx_threshold) {
+        rx_notify_armed = false;
+        threshold_stats.rx_threshold_events++;
+        UART_RxThresholdCallback(UART_RX_EVENT_THRESHOLD, available);
+    }
+}
+
+/**
+ * @brief Fire the TX notification if a sent byte freed enough space
+ * @note ISR context
+ */
+static void CheckTxThreshold(void)
+{
+    if (!tx_notify_armed) {
+        return;
+    }
+
+    uint16_t free_bytes = RingFree(&tx_buffer);
+    if (free_bytes >= tx_threshold) {
+        tx_notify_armed = false;
+        threshold_stats.tx_threshold_events++;
+        UART_TxThresholdCallback(free_bytes);
+    }
+}
+
+/**
+ * @brief Re-arm the RX notification once reads bring RX below the threshold
+ * @note Thread context; the check and the arm are atomic against the ISR
+ */
+static void RearmRxThreshold(void)
+{
+    if (rx_notify_armed) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (rx_threshold == 0U || RingCount(&rx_buffer) < rx_threshold) {
+        rx_notify_armed = true;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Arm the TX notification once writes bring free space below the threshold
+ * @note Thread context; the check and the arm are atomic against the ISR
+ */
+static void RearmTxThreshold(void)
+{
+    if (tx_notify_armed || tx_threshold == 0U) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (RingFree(&tx_buffer) < tx_threshold) {
+        tx_notify_armed = true;
+    }
+    __set_PRIMASK(primask);
+}
+#endif /* UART_ENABLE_THRESHOLDS */
+
+#if UART_ENABLE_TIMESTAMPS || UART_ENABLE_SCHED_TX
+/**
+ * @brief Position of the next character to be read
+ * @param buffer Ring buffer
+ * @return Opaque position, comparable with RingWritePos()
+ */
+static uint32_t RingReadPos(const RingTypeDef *buffer)
+{
+#if UART_ELASTIC_RINGS
+    return buffer->read;
+#else
+    return buffer->tail;
+#endif
+}
+
+/**
+ * @brief Position of the next character to be written
+ * @param buffer Ring buffer
+ * @return Opaque position, comparable with RingReadPos()
+ */
+static uint32_t RingWritePos(const RingTypeDef *buffer)
+{
+#if UART_ELASTIC_RINGS
+    return buffer->written;
+#else
+    return buffer->head;
+#endif
+}
+#endif /* UART_ENABLE_TIMESTAMPS || UART_ENABLE_SCHED_TX */
+
+#if UART_ENABLE_SCHED_TX
+/**
+ * @brief Distance between two ring positions
+ * @param from Earlier position from RingReadPos()/RingWritePos()
+ * @param to Later position
+ * @return Characters from from up to to
+ */
+static uint32_t RingSpan(uint32_t from, uint32_t to)
+{
+#if UART_ELASTIC_RINGS
+    return to - from;
+#else
+    return (UART_BUFFER_SIZE + to - from) % UART_BUFFER_SIZE;
+#endif
+}
+
+/**
+ * @brief Close the TX gate once ring TX has reached the held boundary
+ * @return true if ring TX is stopped
+ * @note Called from the UART ISR or with interrupts masked
+ */
+static bool TxGated(void)
+{
+    if (tx_gate == TX_GATE_CLOSING && RingReadPos(&tx_buffer) == tx_hold_pos) {
+        tx_gate = TX_GATE_CLOSED;
+    }
+
+    if (tx_gate == TX_GATE_CLOSED && tx_slot_due) {
+        // The first scheduled byte waits for TC, the last ring byte must leave the shifter
+        tx_slot_due = false;
+        __HAL_UART_ENABLE_IT(UART_INSTANCE, UART_IT_TC);
+    }
+
+    return tx_gate == TX_GATE_CLOSED;
+}
+#endif /* UART_ENABLE_SCHED_TX */
+
+#if UART_ENABLE_ISR_PROFILE
+/**
+ * @brief Charge the cycles since start to one ISR path
+ * @param path Path that just finished
+ * @param start Cycle count at the previous mark
+ * @return Cycle count now, the start of the next path
+ */
+static uint32_t ProfilePath(UART_IsrPathTypeDef path, uint32_t start)
+{
+    uint32_t now = UART_TIME_CYCLES();
+    uint32_t cycles = now - start;
+    UART_IsrPathStatsTypeDef *entry = &isr_profile.path[path];
+
+    entry->count++;
+    entry->cycles_total += cycles;
+    if (cycles > entry->cycles_max) {
+        entry->cycles_max = cycles;
+    }
+
+    return now;
+}
+
+/**
+ * @brief Record the whole handler's cycles and how deep the stack was
+ * @param start Cycle count on entry
+ */
+static void ProfileHandler(uint32_t start)
+{
+    uint32_t cycles = UART_TIME_CYCLES() - start;
+    uint32_t sp = __get_MSP();
+
+    if (cycles > isr_profile.handler_cycles_max) {
+        isr_profile.handler_cycles_max = cycles;
+    }
+    if (isr_profile.entry_sp_min == 0U || sp < isr_profile.entry_sp_min) {
+        isr_profile.entry_sp_min = sp;
+    }
+}
+#endif /* UART_ENABLE_ISR_PROFILE */
 
 /**
  * @brief Check if timeout has expired
@@ -367,7 +1776,11 @@ static UART_ErrorTypeDef StoreChar(uint8_t c, RingBuffer_TypeDef *buffer)
  */
 static bool IsTimeOutExpired(uint32_t timeout_ms)
 {
+#if UART_USE_US_TIMEBASE
+    return (UART_Time_Us() - timeout_start) >= (uint64_t)timeout_ms * 1000U;
+#else
     return (HAL_GetTick() - timeout_start) >= timeout_ms;
+#endif
 }
 
 /**
@@ -375,9 +1788,38 @@ static bool IsTimeOutExpired(uint32_t timeout_ms)
  */
 static void ResetTimeout(void)
 {
+#if UART_USE_US_TIMEBASE
+    timeout_start = UART_Time_Us();
+#else
     timeout_start = HAL_GetTick();
+#endif
+}
+
+#if UART_ENABLE_TICKLESS_IDLE
+/**
+ * @brief Time left before the running timeout expires
+ * @param timeout_ms Timeout value in milliseconds
+ * @return Milliseconds left, 0 if expired
+ */
+static uint32_t TimeoutRemaining(uint32_t timeout_ms)
+{
+#if UART_USE_US_TIMEBASE
+    uint64_t elapsed_ms = (UART_Time_Us() - timeout_start) / 1000U;
+#else
+    uint32_t elapsed_ms = HAL_GetTick() - timeout_start;
+#endif
+    return (elapsed_ms < timeout_ms) ? (uint32_t)(timeout_ms - elapsed_ms) : 0U;
 }
 
+/**
+ * @brief Idle wake condition: TX ring has room
+ */
+static bool TxHasRoom(void)
+{
+    return UART_TxFree() != 0;
+}
+#endif /* UART_ENABLE_TICKLESS_IDLE */
+
 /**
  * @brief Find string in buffer
  * @param str String to find
@@ -412,12 +1854,23 @@ static size_t FindStringInBuffer(const char *str, const char *buffer, size_t buf
  */
 static UART_ErrorTypeDef WaitForData(uint32_t timeout_ms)
 {
+#if UART_USE_FREERTOS
+    if (UART_Rtos_CanBlock()) {
+        // Yield to other tasks; the ISR notifies on the first byte
+        return UART_Rtos_WaitRx(0, 1, UART_RTOS_NO_DELIMITER, UART_RTOS_DEADLINE_MS(timeout_ms));
+    }
+#endif
+
     ResetTimeout();
 
     while (UART_Available() == 0) {
         if (IsTimeOutExpired(timeout_ms)) {
             return UART_ERROR_TIMEOUT;
         }
+#if UART_ENABLE_TICKLESS_IDLE
+        // Sleep until the RX interrupt or the timeout instead of spinning on SysTick
+        UART_Idle_Sleep(TimeoutRemaining(timeout_ms), UART_RxPending);
+#endif
     }
 
     return UART_SUCCESS;
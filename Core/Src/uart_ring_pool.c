@@ -0,0 +1,395 @@
+/*
+ * uart_ring_pool.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_ring_pool.h"
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define POOL_MAX_RINGS 2
+
+/**** Private Variables ****/
+static uint8_t segment_data[UART_POOL_SEGMENTS][UART_POOL_SEGMENT_SIZE];
+static uint8_t segment_next[UART_POOL_SEGMENTS];
+static uint8_t free_head = UART_POOL_NO_SEGMENT;
+static UART_ElasticRingTypeDef *rings[POOL_MAX_RINGS];
+static uint8_t ring_count;
+static UART_PoolStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static uint32_t ReservedForOthers(const UART_ElasticRingTypeDef *ring);
+static uint8_t AllocSegment(UART_ElasticRingTypeDef *ring);
+static void FreeSegment(UART_ElasticRingTypeDef *ring, uint8_t seg);
+static void AdvanceTail(UART_ElasticRingTypeDef *ring);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Return every segment to the pool
+ */
+void UART_Pool_Init(void)
+{
+    for (uint8_t i = 0; i < UART_POOL_SEGMENTS; i++) {
+        segment_next[i] = (uint8_t)(i + 1U);
+    }
+    segment_next[UART_POOL_SEGMENTS - 1] = UART_POOL_NO_SEGMENT;
+    free_head = 0;
+    ring_count = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.free_segments = UART_POOL_SEGMENTS;
+    stats.min_free_segments = UART_POOL_SEGMENTS;
+}
+
+/**
+ * @brief Attach a ring to the pool with one initial segment
+ * @param ring Ring to initialize
+ * @param min_segments Segments held in reserve for this ring
+ * @param max_segments Upper bound on segments linked into this ring
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM if the limits do not fit the pool
+ */
+UART_ErrorTypeDef UART_ElasticRing_Init(UART_ElasticRingTypeDef *ring, uint8_t min_segments, uint8_t max_segments)
+{
+    if (ring == NULL || ring_count >= POOL_MAX_RINGS || min_segments == 0 ||
+        max_segments < min_segments || max_segments > UART_POOL_SEGMENTS) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t reserved = min_segments;
+    for (uint8_t i = 0; i < ring_count; i++) {
+        reserved += rings[i]->min_segments;
+    }
+    if (reserved > UART_POOL_SEGMENTS) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->min_segments = min_segments;
+    ring->max_segments = max_segments;
+    rings[ring_count++] = ring;
+
+    uint8_t seg = AllocSegment(ring);
+    if (seg == UART_POOL_NO_SEGMENT) {
+        ring_count--;
+        return UART_ERROR_BUFFER_FULL;
+    }
+    ring->head_seg = seg;
+    ring->tail_seg = seg;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Append a byte, growing the ring by one segment if needed
+ * @param ring Ring
+ * @param c Byte to store
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_FULL if no segment can be taken
+ */
+UART_ErrorTypeDef UART_ElasticRing_Put(UART_ElasticRingTypeDef *ring, uint8_t c)
+{
+    if (ring->head_off == UART_POOL_SEGMENT_SIZE) {
+        uint8_t seg = AllocSegment(ring);
+        if (seg == UART_POOL_NO_SEGMENT) {
+            return UART_ERROR_BUFFER_FULL;
+        }
+
+        // Link before publishing: the reader follows segment_next once it sees the data
+        segment_next[ring->head_seg] = seg;
+        ring->head_seg = seg;
+        ring->head_off = 0;
+    }
+
+    segment_data[ring->head_seg][ring->head_off++] = c;
+    __DMB();
+    ring->written++;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Remove the oldest byte, releasing segments the reader has left
+ * @param ring Ring
+ * @param c Pointer to store the byte
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if no data
+ */
+UART_ErrorTypeDef UART_ElasticRing_Get(UART_ElasticRingTypeDef *ring, uint8_t *c)
+{
+    if (ring->written == ring->read) {
+        return UART_ERROR_BUFFER_EMPTY;
+    }
+
+    if (ring->tail_off == UART_POOL_SEGMENT_SIZE) {
+        AdvanceTail(ring);  // Data beyond this segment exists, so the link is in place
+    }
+
+    *c = segment_data[ring->tail_seg][ring->tail_off++];
+    __DMB();
+    ring->read++;
+
+    // Give the segment back as soon as the writer has moved on from it
+    if (ring->tail_off == UART_POOL_SEGMENT_SIZE && ring->tail_seg != ring->head_seg) {
+        AdvanceTail(ring);
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Read the oldest byte without removing it
+ * @param ring Ring
+ * @param c Pointer to store the byte
+ * @return UART_SUCCESS on success, UART_ERROR_BUFFER_EMPTY if no data
+ */
+UART_ErrorTypeDef UART_ElasticRing_Peek(const UART_ElasticRingTypeDef *ring, uint8_t *c)
+{
+    if (ring->written == ring->read) {
+        return UART_ERROR_BUFFER_EMPTY;
+    }
+
+    if (ring->tail_off == UART_POOL_SEGMENT_SIZE) {
+        *c = segment_data[segment_next[ring->tail_seg]][0];
+    } else {
+        *c = segment_data[ring->tail_seg][ring->tail_off];
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Get the contiguous free span at the write position, growing the ring if needed
+ * @param ring Ring
+ * @param span Pointer to store the span start
+ * @return Bytes that can be written to the span, 0 if no segment can be taken
+ */
+uint16_t UART_ElasticRing_Reserve(UART_ElasticRingTypeDef *ring, uint8_t **span)
+{
+    if (ring->head_off == UART_POOL_SEGMENT_SIZE) {
+        uint8_t seg = AllocSegment(ring);
+        if (seg == UART_POOL_NO_SEGMENT) {
+            return 0;
+        }
+
+        segment_next[ring->head_seg] = seg;
+        ring->head_seg = seg;
+        ring->head_off = 0;
+    }
+
+    *span = &segment_data[ring->head_seg][ring->head_off];
+    return (uint16_t)(UART_POOL_SEGMENT_SIZE - ring->head_off);
+}
+
+/**
+ * @brief Publish bytes written into a reserved span
+ * @param ring Ring
+ * @param len Bytes written
+ */
+void UART_ElasticRing_Commit(UART_ElasticRingTypeDef *ring, uint16_t len)
+{
+    ring->head_off = (uint8_t)(ring->head_off + len);
+    __DMB();
+    ring->written += len;
+}
+
+/**
+ * @brief Get the contiguous run of data at the read position
+ * @param ring Ring
+ * @param span Pointer to store the span start
+ * @return Bytes readable from the span, 0 if empty
+ */
+uint16_t UART_ElasticRing_PeekSpan(UART_ElasticRingTypeDef *ring, const uint8_t **span)
+{
+    uint32_t count = ring->written - ring->read;
+    if (count == 0) {
+        return 0;
+    }
+
+    if (ring->tail_off == UART_POOL_SEGMENT_SIZE) {
+        AdvanceTail(ring);
+    }
+
+    uint32_t len = UART_POOL_SEGMENT_SIZE - ring->tail_off;
+    *span = &segment_data[ring->tail_seg][ring->tail_off];
+    return (uint16_t)((count < len) ? count : len);
+}
+
+/**
+ * @brief Release bytes at the read position
+ * @param ring Ring
+ * @param len Bytes consumed
+ */
+void UART_ElasticRing_Consume(UART_ElasticRingTypeDef *ring, uint16_t len)
+{
+    ring->tail_off = (uint8_t)(ring->tail_off + len);
+    __DMB();
+    ring->read += len;
+
+    if (ring->tail_off == UART_POOL_SEGMENT_SIZE && ring->tail_seg != ring->head_seg) {
+        AdvanceTail(ring);
+    }
+}
+
+/**
+ * @brief Number of bytes stored
+ * @param ring Ring
+ * @return Byte count
+ */
+uint32_t UART_ElasticRing_Count(const UART_ElasticRingTypeDef *ring)
+{
+    return ring->written - ring->read;
+}
+
+/**
+ * @brief Number of bytes that can be stored now
+ * @param ring Ring
+ * @return Room left in the write segment plus the segments the ring may still take from the pool
+ */
+uint32_t UART_ElasticRing_Free(const UART_ElasticRingTypeDef *ring)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t reserved = ReservedForOthers(ring);
+    uint32_t available = (stats.free_segments > reserved) ? (stats.free_segments - reserved) : 0U;
+    uint32_t allowed = (ring->segments < ring->max_segments) ? (uint32_t)(ring->max_segments - ring->segments) : 0U;
+    uint32_t room = UART_POOL_SEGMENT_SIZE - ring->head_off;
+
+    __set_PRIMASK(primask);
+    return room + ((available < allowed) ? available : allowed) * UART_POOL_SEGMENT_SIZE;
+}
+
+/**
+ * @brief Drop all stored bytes and shrink the ring back to one segment
+ * @param ring Ring
+ */
+void UART_ElasticRing_Flush(UART_ElasticRingTypeDef *ring)
+{
+    while (ring->tail_seg != ring->head_seg) {
+        uint8_t seg = ring->tail_seg;
+        ring->tail_seg = segment_next[seg];
+        FreeSegment(ring, seg);
+    }
+
+    ring->tail_off = ring->head_off;
+    ring->read = ring->written;
+}
+
+/**
+ * @brief Get pool statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Pool_GetStats(UART_PoolStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Segments other rings are still owed under their minimum
+ * @param ring Ring asking, excluded from the sum
+ * @return Free segments this ring must leave in the pool
+ * @note Call with interrupts masked
+ */
+static uint32_t ReservedForOthers(const UART_ElasticRingTypeDef *ring)
+{
+    uint32_t reserved = 0;
+    for (uint8_t i = 0; i < ring_count; i++) {
+        if (rings[i] != ring && rings[i]->segments < rings[i]->min_segments) {
+            reserved += rings[i]->min_segments - rings[i]->segments;
+        }
+    }
+    return reserved;
+}
+
+/**
+ * @brief Take a segment from the pool for a ring
+ * @param ring Requesting ring
+ * @return Segment index or UART_POOL_NO_SEGMENT
+ */
+static uint8_t AllocSegment(UART_ElasticRingTypeDef *ring)
+{
+    uint32_t start = UART_TIME_CYCLES();
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t reserved = ReservedForOthers(ring);
+
+    uint8_t seg = UART_POOL_NO_SEGMENT;
+    if (ring->segments < ring->max_segments && stats.free_segments > reserved) {
+        seg = free_head;
+        free_head = segment_next[seg];
+        segment_next[seg] = UART_POOL_NO_SEGMENT;
+
+        ring->segments++;
+        if (ring->segments > ring->peak_segments) {
+            ring->peak_segments = ring->segments;
+        }
+        stats.free_segments--;
+        if (stats.free_segments < stats.min_free_segments) {
+            stats.min_free_segments = stats.free_segments;
+        }
+        stats.allocs++;
+    } else {
+        stats.alloc_failures++;
+    }
+
+    uint32_t cycles = UART_TIME_CYCLES() - start;
+    stats.alloc_cycles_total += cycles;
+    if (cycles > stats.alloc_cycles_max) {
+        stats.alloc_cycles_max = cycles;
+    }
+
+    __set_PRIMASK(primask);
+    return seg;
+}
+
+/**
+ * @brief Return a segment to the pool
+ * @param ring Ring the segment was linked into
+ * @param seg Segment index
+ */
+static void FreeSegment(UART_ElasticRingTypeDef *ring, uint8_t seg)
+{
+    uint32_t start = UART_TIME_CYCLES();
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    segment_next[seg] = free_head;
+    free_head = seg;
+    ring->segments--;
+    stats.free_segments++;
+    stats.frees++;
+
+    uint32_t cycles = UART_TIME_CYCLES() - start;
+    stats.free_cycles_total += cycles;
+    if (cycles > stats.free_cycles_max) {
+        stats.free_cycles_max = cycles;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Move the reader onto the next segment and free the old one
+ * @param ring Ring whose reader has consumed its whole tail segment
+ */
+static void AdvanceTail(UART_ElasticRingTypeDef *ring)
+{
+    uint8_t seg = ring->tail_seg;
+
+    ring->tail_seg = segment_next[seg];
+    ring->tail_off = 0;
+    FreeSegment(ring, seg);
+}
@@ -0,0 +1,324 @@
+/*
+ * uart_rpc.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_rpc.h"
+#include "uart_timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/**** Configuration Section ****/
+#define REQ_HEADER_SIZE     2U      // call_id, proc_id
+#define RESP_HEADER_SIZE    3U      // call_id, proc_id, status
+#define TLV_HEADER_SIZE     2U      // tag, len
+#define FIELD_END           0xFFU   // Descriptor list terminator
+
+/**** Type Definitions ****/
+typedef struct {
+    uint8_t id;
+    uint16_t args_size;
+    uint16_t results_size;
+    const UART_RpcFieldTypeDef *args;
+    const UART_RpcFieldTypeDef *results;
+    UART_ErrorTypeDef (*call)(const void *args, void *results);
+} ProcedureTypeDef;
+
+/**** Generated Tables ****/
+#define FIELD_DESCRIPTOR(S, tag, type, name) \
+    { (tag), UART_RPC_TYPE_##type, (uint16_t)offsetof(S, name) },
+
+#define DEFINE_PROCEDURE(id, name, args, results)                                   \
+    static const UART_RpcFieldTypeDef name##ArgFields[] = {                         \
+        args(FIELD_DESCRIPTOR, UART_Rpc##name##ArgsTypeDef)                         \
+        { FIELD_END, 0, 0 }                                                         \
+    };                                                                              \
+    static const UART_RpcFieldTypeDef name##ResultFields[] = {                      \
+        results(FIELD_DESCRIPTOR, UART_Rpc##name##ResultsTypeDef)                   \
+        { FIELD_END, 0, 0 }                                                         \
+    };                                                                              \
+    static UART_ErrorTypeDef Call##name(const void *args, void *results)            \
+    {                                                                               \
+        return UART_Rpc_##name((const UART_Rpc##name##ArgsTypeDef *)args,           \
+                               (UART_Rpc##name##ResultsTypeDef *)results);          \
+    }                                                                               \
+    static const ProcedureTypeDef name##Procedure = {                               \
+        (id), sizeof(UART_Rpc##name##ArgsTypeDef), sizeof(UART_Rpc##name##ResultsTypeDef), \
+        name##ArgFields, name##ResultFields, Call##name                             \
+    };
+
+UART_RPC_PROCEDURES(DEFINE_PROCEDURE)
+
+#define ARGS_MEMBER(id, name, args, results)    UART_Rpc##name##ArgsTypeDef name;
+#define RESULTS_MEMBER(id, name, args, results) UART_Rpc##name##ResultsTypeDef name;
+#define PROCEDURE_CASE(id, name, args, results) case (id): return &name##Procedure;
+
+/**** Private Variables ****/
+static union {
+    UART_RPC_PROCEDURES(ARGS_MEMBER)
+} args_storage;
+
+static union {
+    UART_RPC_PROCEDURES(RESULTS_MEMBER)
+} results_storage;
+
+static UART_RpcStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static void HandleRequest(const UART_FrameTypeDef *frame);
+static const ProcedureTypeDef *FindProcedure(uint8_t id);
+static UART_ErrorTypeDef DecodeFields(const UART_RpcFieldTypeDef *fields, const uint8_t *in,
+                                      uint16_t len, void *out);
+static uint16_t EncodeFields(const UART_RpcFieldTypeDef *fields, const void *in,
+                             uint8_t *out, uint16_t size);
+static uint8_t UnsignedWidth(uint32_t value);
+static uint8_t SignedWidth(int32_t value);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Register the request frame handler
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rpc_Init(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    return UART_Frame_RegisterHandler(UART_FRAME_TYPE_RPC_REQ, HandleRequest);
+}
+
+/**
+ * @brief Get call counts, payload bytes and cycles
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Rpc_GetStats(UART_RpcStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = stats;
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Decode, call and answer one RPC_REQ frame
+ * @param frame Received frame
+ */
+static void HandleRequest(const UART_FrameTypeDef *frame)
+{
+    uint32_t start = UART_TIME_CYCLES();
+    const ProcedureTypeDef *proc;
+    UART_ErrorTypeDef result;
+    uint16_t results_len = 0;
+    uint8_t *out;
+
+    if (frame->len < REQ_HEADER_SIZE) {
+        return;
+    }
+
+    proc = FindProcedure(frame->payload[1]);
+
+    if (proc == NULL) {
+        result = UART_ERROR_NOT_FOUND;
+    } else {
+        memset(&args_storage, 0, proc->args_size);
+        result = DecodeFields(proc->args, &frame->payload[REQ_HEADER_SIZE],
+                              (uint16_t)(frame->len - REQ_HEADER_SIZE), &args_storage);
+        if (result == UART_SUCCESS) {
+            memset(&results_storage, 0, proc->results_size);
+            *(uint32_t *)&results_storage = UINT32_MAX;
+            result = proc->call(&args_storage, &results_storage);
+        }
+    }
+
+    // Reserve only after the call, which may itself print
+    out = UART_Frame_Reserve(UART_FRAME_MAX_PAYLOAD);
+    if (result == UART_SUCCESS) {
+        results_len = EncodeFields(proc->results, &results_storage, &out[RESP_HEADER_SIZE],
+                                   UART_FRAME_MAX_PAYLOAD - RESP_HEADER_SIZE);
+        if (results_len == UINT16_MAX) {
+            results_len = 0;
+            result = UART_ERROR_BUFFER_FULL;
+        }
+    }
+
+    out[0] = frame->payload[0];
+    out[1] = frame->payload[1];
+    out[2] = (uint8_t)(int8_t)result;
+    UART_Frame_Commit(UART_FRAME_TYPE_RPC_RESP, (uint16_t)(RESP_HEADER_SIZE + results_len));
+
+    stats.calls++;
+    stats.rx_bytes += frame->len;
+    stats.tx_bytes += RESP_HEADER_SIZE + results_len;
+    stats.cycles += UART_TIME_CYCLES() - start;
+    if (result != UART_SUCCESS) {
+        stats.failed_calls++;
+    }
+}
+
+/**
+ * @brief Look up a procedure by id
+ * @param id Procedure id from the request
+ * @return Procedure, NULL if unknown
+ */
+static const ProcedureTypeDef *FindProcedure(uint8_t id)
+{
+    switch (id) {
+    UART_RPC_PROCEDURES(PROCEDURE_CASE)
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Decode TLV fields in place into a generated struct
+ * @param fields Descriptor list
+ * @param in TLV bytes, must outlive the decoded BYTES views
+ * @param len Number of TLV bytes
+ * @param out Zeroed struct; present bits are set per decoded tag
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_DATA on a malformed TLV
+ */
+static UART_ErrorTypeDef DecodeFields(const UART_RpcFieldTypeDef *fields, const uint8_t *in,
+                                      uint16_t len, void *out)
+{
+    uint32_t *present = (uint32_t *)out;
+    uint16_t pos = 0;
+
+    while (pos < len) {
+        if ((uint16_t)(len - pos) < TLV_HEADER_SIZE) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        uint8_t tag = in[pos];
+        uint8_t n = in[pos + 1];
+        const uint8_t *value = &in[pos + TLV_HEADER_SIZE];
+        pos += TLV_HEADER_SIZE;
+        if (n > len - pos) {
+            return UART_ERROR_INVALID_DATA;
+        }
+        pos += n;
+
+        const UART_RpcFieldTypeDef *field = fields;
+        while (field->tag != FIELD_END && field->tag != tag) {
+            field++;
+        }
+        if (field->tag == FIELD_END) {
+            continue;                               // Unknown tag, skip
+        }
+
+        uint8_t *dst = (uint8_t *)out + field->offset;
+        if (field->type == UART_RPC_TYPE_BYTES) {
+            UART_RpcBytesTypeDef view = { value, n };
+            memcpy(dst, &view, sizeof(view));
+        } else {
+            static const uint8_t widths[] = { 1U, 2U, 4U, 4U };
+            uint32_t v = 0;
+
+            if (n > widths[field->type]) {
+                return UART_ERROR_INVALID_DATA;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                v |= (uint32_t)value[i] << (8U * i);
+            }
+            if (field->type == UART_RPC_TYPE_I32 && n > 0 && n < 4 && (value[n - 1] & 0x80)) {
+                v |= UINT32_MAX << (8U * n);
+            }
+
+            memcpy(dst, &v, widths[field->type]);  // Little-endian core, low bytes first
+        }
+        *present |= 1UL << tag;
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Encode the present fields of a generated struct as TLV
+ * @param fields Descriptor list
+ * @param in Struct to encode
+ * @param out Destination, typically inside the TX buffer
+ * @param size Capacity of out
+ * @return Bytes written, UINT16_MAX if out is too small
+ */
+static uint16_t EncodeFields(const UART_RpcFieldTypeDef *fields, const void *in,
+                             uint8_t *out, uint16_t size)
+{
+    uint32_t present = *(const uint32_t *)in;
+    uint16_t pos = 0;
+
+    for (const UART_RpcFieldTypeDef *field = fields; field->tag != FIELD_END; field++) {
+        if ((present & (1UL << field->tag)) == 0) {
+            continue;
+        }
+
+        const uint8_t *src = (const uint8_t *)in + field->offset;
+        uint32_t v = 0;
+        const uint8_t *value = (const uint8_t *)&v;     // Little-endian core, low bytes first
+        uint8_t n;
+
+        if (field->type == UART_RPC_TYPE_BYTES) {
+            UART_RpcBytesTypeDef view;
+            memcpy(&view, src, sizeof(view));
+            value = view.data;
+            n = view.len;
+        } else if (field->type == UART_RPC_TYPE_I32) {
+            memcpy(&v, src, sizeof(v));
+            n = SignedWidth((int32_t)v);
+        } else {
+            memcpy(&v, src, (field->type == UART_RPC_TYPE_U8) ? 1U :
+                            (field->type == UART_RPC_TYPE_U16) ? 2U : 4U);
+            n = UnsignedWidth(v);
+        }
+
+        if (TLV_HEADER_SIZE + n > (uint16_t)(size - pos)) {
+            return UINT16_MAX;
+        }
+        out[pos++] = field->tag;
+        out[pos++] = n;
+        memcpy(&out[pos], value, n);
+        pos += n;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Bytes needed for an unsigned value
+ * @param value Value to encode
+ * @return 0 .. 4
+ */
+static uint8_t UnsignedWidth(uint32_t value)
+{
+    uint8_t n = 0;
+
+    while (value != 0) {
+        value >>= 8;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Bytes needed for a sign-extended value
+ * @param value Value to encode
+ * @return 0 .. 4
+ */
+static uint8_t SignedWidth(int32_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    if (value >= INT8_MIN && value <= INT8_MAX) {
+        return 1;
+    }
+    if (value >= INT16_MIN && value <= INT16_MAX) {
+        return 2;
+    }
+    if (value >= -0x800000 && value <= 0x7FFFFF) {
+        return 3;
+    }
+    return 4;
+}
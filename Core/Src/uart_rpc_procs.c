@@ -0,0 +1,72 @@
+/*
+ * uart_rpc_procs.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_rpc.h"
+
+/*
+ * Procedures declared in uart_rpc_table.h. Each receives decoded
+ * arguments and fills its results struct; returning an error sends the
+ * status without results.
+ */
+
+/**** Public Functions ****/
+
+/**
+ * @brief Echo the data argument and report the HAL tick
+ * @param args Decoded arguments
+ * @param results Results to encode
+ * @return UART_SUCCESS
+ */
+UART_ErrorTypeDef UART_Rpc_Ping(const UART_RpcPingArgsTypeDef *args, UART_RpcPingResultsTypeDef *results)
+{
+    results->data = args->data;         // View into the request, encoded before it is reused
+    results->tick_ms = HAL_GetTick();
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Report frame layer statistics
+ * @param args Decoded arguments (none)
+ * @param results Results to encode
+ * @return UART_SUCCESS
+ */
+UART_ErrorTypeDef UART_Rpc_GetFrameStats(const UART_RpcGetFrameStatsArgsTypeDef *args,
+                                         UART_RpcGetFrameStatsResultsTypeDef *results)
+{
+    UART_FrameStatsTypeDef frame_stats;
+
+    (void)args;
+    UART_Frame_GetStats(&frame_stats);
+    results->rx_frames = frame_stats.rx_frames;
+    results->rx_checksum_errors = frame_stats.rx_checksum_errors;
+    results->rx_oversize = frame_stats.rx_oversize;
+    results->rx_unhandled = frame_stats.rx_unhandled;
+    results->tx_frames = frame_stats.tx_frames;
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Report RPC statistics, excluding the current call
+ * @param args Decoded arguments (none)
+ * @param results Results to encode
+ * @return UART_SUCCESS
+ */
+UART_ErrorTypeDef UART_Rpc_GetRpcStats(const UART_RpcGetRpcStatsArgsTypeDef *args,
+                                       UART_RpcGetRpcStatsResultsTypeDef *results)
+{
+    UART_RpcStatsTypeDef rpc_stats;
+
+    (void)args;
+    UART_Rpc_GetStats(&rpc_stats);
+    results->calls = rpc_stats.calls;
+    results->failed_calls = rpc_stats.failed_calls;
+    results->rx_bytes = rpc_stats.rx_bytes;
+    results->tx_bytes = rpc_stats.tx_bytes;
+    results->cycles = rpc_stats.cycles;
+    return UART_SUCCESS;
+}
@@ -0,0 +1,459 @@
+/*
+ * uart_rtos.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_rtos.h"
+
+#if UART_USE_FREERTOS
+
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Private Variables ****/
+static volatile TaskHandle_t rx_waiter;     // Cleared by the ISR when it notifies
+static volatile TaskHandle_t tx_waiter;
+static volatile uint16_t rx_level;
+static volatile int16_t rx_delimiter;
+static volatile uint16_t tx_space;
+static volatile uint32_t rx_wake_stamp;
+static volatile uint32_t tx_wake_stamp;
+static uint16_t rx_trigger_level = 1;
+static UART_RtosStatsTypeDef stats;
+static TaskHandle_t held_rx_waiter;         // Parked by UART_Rtos_HoldWakeups()
+static TaskHandle_t held_tx_waiter;
+
+/**** Private Function Prototypes ****/
+static bool RemainingTicks(TickType_t deadline, TickType_t *ticks);
+static UART_ErrorTypeDef Sleep(volatile TaskHandle_t *slot, uint32_t bit, TickType_t deadline,
+                               volatile uint32_t *stamp);
+static uint16_t CopyOut(uint8_t *data, uint16_t len, int16_t delimiter, bool *found);
+static void RecordLatency(uint32_t stamp);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Prepare the port and move the USART interrupt to a FreeRTOS-safe priority
+ */
+void UART_Rtos_Init(void)
+{
+    rx_waiter = NULL;
+    tx_waiter = NULL;
+    rx_trigger_level = 1;
+    memset(&stats, 0, sizeof(stats));
+    stats.min_wake_latency = UINT32_MAX;
+
+    // FromISR calls are only legal at or below the syscall priority; taskENTER_CRITICAL masks it
+    HAL_NVIC_SetPriority(USART2_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    // TIM2 feeds bytes through the same hooks, so it follows USART2 and stays below it
+    HAL_NVIC_SetPriority(TIM2_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1U, 0);
+}
+
+/**
+ * @brief Set the reader trigger level
+ * @param bytes Bytes UART_Rtos_Read() waits for before returning, at least 1
+ */
+void UART_Rtos_SetRxTriggerLevel(uint16_t bytes)
+{
+    rx_trigger_level = (bytes == 0U) ? 1U : bytes;
+}
+
+/**
+ * @brief Receive bytes, blocking until the trigger level is reached
+ * @param data Destination
+ * @param len Capacity of data
+ * @param received Pointer to store the number of bytes read
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_Read(uint8_t *data, uint16_t len, uint16_t *received, TickType_t deadline)
+{
+    if (data == NULL || received == NULL || len == 0U) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    uint16_t trigger = (rx_trigger_level < len) ? rx_trigger_level : len;
+    UART_ErrorTypeDef status = UART_SUCCESS;
+
+    for (;;) {
+        uint16_t available = UART_Available();
+        if (available >= trigger) {
+            break;
+        }
+        status = UART_Rtos_WaitRx(available, trigger, UART_RTOS_NO_DELIMITER, deadline);
+        if (status != UART_SUCCESS) {
+            break;
+        }
+    }
+
+    // Like a stream buffer, a timed-out read still hands over what did arrive
+    *received = CopyOut(data, len, UART_RTOS_NO_DELIMITER, NULL);
+    return status;
+}
+
+/**
+ * @brief Receive bytes up to and including a delimiter
+ * @param data Destination
+ * @param size Capacity of data
+ * @param delimiter Byte that ends the record
+ * @param received Pointer to store the number of bytes read
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_ReadUntil(uint8_t *data, uint16_t size, uint8_t delimiter,
+                                      uint16_t *received, TickType_t deadline)
+{
+    if (data == NULL || received == NULL || size == 0U) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    uint16_t count = 0;
+    bool found = false;
+
+    for (;;) {
+        // Move what has arrived into the caller's buffer, freeing ring space as we go
+        count += CopyOut(&data[count], size - count, delimiter, &found);
+        if (found) {
+            *received = count;
+            return UART_SUCCESS;
+        }
+        if (count == size) {
+            *received = count;
+            return UART_ERROR_BUFFER_FULL;
+        }
+
+        UART_ErrorTypeDef status = UART_Rtos_WaitRx(0, size - count, (int16_t)delimiter, deadline);
+        if (status != UART_SUCCESS) {
+            *received = count;
+            return status;
+        }
+    }
+}
+
+/**
+ * @brief Queue bytes for transmission, blocking while the TX ring is full
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @param sent Pointer to store the number of bytes queued, may be NULL
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_Write(const uint8_t *data, uint16_t len, uint16_t *sent, TickType_t deadline)
+{
+    if (data == NULL && len != 0U) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    UART_ErrorTypeDef status = UART_SUCCESS;
+    uint16_t done = 0;
+
+    while (done < len) {
+        uint8_t *span;
+        uint16_t n = UART_TxReserve(&span);
+
+        if (n != 0U) {
+            if (n > len - done) {
+                n = len - done;
+            }
+            memcpy(span, &data[done], n);
+            UART_TxCommit(n);
+            done += n;
+            continue;
+        }
+
+        // Sleep until a useful amount of space is free rather than per drained byte
+        uint16_t want = len - done;
+        if (want > UART_RTOS_TX_WAKE_SPACE) {
+            want = UART_RTOS_TX_WAKE_SPACE;
+        }
+        status = UART_Rtos_WaitTx(want, deadline);
+        if (status != UART_SUCCESS) {
+            break;
+        }
+    }
+
+    if (sent != NULL) {
+        *sent = done;
+    }
+    return status;
+}
+
+/**
+ * @brief Block until RX holds at least level bytes or a delimiter arrives
+ * @param seen RX byte count the caller has already examined
+ * @param level Byte count that ends the wait
+ * @param delimiter Byte that ends the wait, or UART_RTOS_NO_DELIMITER
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS when woken or when RX changed since seen, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_WaitRx(uint16_t seen, uint16_t level, int16_t delimiter, TickType_t deadline)
+{
+    taskENTER_CRITICAL();
+
+    // Bytes that landed after the caller looked were never offered to the ISR check
+    uint16_t available = UART_Available();
+    if (available != seen || available >= level) {
+        taskEXIT_CRITICAL();
+        return UART_SUCCESS;
+    }
+    if (rx_waiter != NULL) {
+        taskEXIT_CRITICAL();
+        return UART_ERROR_BUSY;
+    }
+
+    rx_level = level;
+    rx_delimiter = delimiter;
+    (void)ulTaskNotifyValueClear(NULL, UART_RTOS_NOTIFY_RX);
+    rx_waiter = xTaskGetCurrentTaskHandle();
+
+    taskEXIT_CRITICAL();
+
+    return Sleep(&rx_waiter, UART_RTOS_NOTIFY_RX, deadline, &rx_wake_stamp);
+}
+
+/**
+ * @brief Block until the TX ring has at least space free bytes
+ * @param space Free bytes that end the wait
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @return UART_SUCCESS when the space is available, error code otherwise
+ */
+UART_ErrorTypeDef UART_Rtos_WaitTx(uint16_t space, TickType_t deadline)
+{
+    taskENTER_CRITICAL();
+
+    if (UART_TxFree() >= space) {
+        taskEXIT_CRITICAL();
+        return UART_SUCCESS;
+    }
+    if (tx_waiter != NULL) {
+        taskEXIT_CRITICAL();
+        return UART_ERROR_BUSY;
+    }
+
+    tx_space = space;
+    (void)ulTaskNotifyValueClear(NULL, UART_RTOS_NOTIFY_TX);
+    tx_waiter = xTaskGetCurrentTaskHandle();
+
+    taskEXIT_CRITICAL();
+
+    return Sleep(&tx_waiter, UART_RTOS_NOTIFY_TX, deadline, &tx_wake_stamp);
+}
+
+/**
+ * @brief Check whether the caller may block
+ * @return true in a task with the scheduler running, false otherwise
+ */
+bool UART_Rtos_CanBlock(void)
+{
+    return __get_IPSR() == 0U && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+/**
+ * @brief Get wake and latency statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_Rtos_GetStats(UART_RtosStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *out = stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Park the blocked reader and writer so the ISR hooks pass them by, or put them back
+ * @param hold true to park, false to restore
+ */
+void UART_Rtos_HoldWakeups(bool hold)
+{
+    if (hold) {
+        held_rx_waiter = rx_waiter;
+        held_tx_waiter = tx_waiter;
+        rx_waiter = NULL;
+        tx_waiter = NULL;
+    } else {
+        rx_waiter = held_rx_waiter;
+        tx_waiter = held_tx_waiter;
+        held_rx_waiter = NULL;
+        held_tx_waiter = NULL;
+    }
+}
+
+/**
+ * @brief Wake the reader if its level or delimiter was reached
+ * @param c Byte just stored in RX
+ */
+void UART_Rtos_RxHook(uint8_t c)
+{
+    TaskHandle_t task = rx_waiter;
+    if (task == NULL) {
+        return;     // Common case: one load and out
+    }
+    if ((int16_t)c != rx_delimiter && UART_Available() < rx_level) {
+        return;
+    }
+
+    BaseType_t woken = pdFALSE;
+    rx_waiter = NULL;
+    rx_wake_stamp = UART_RTOS_TIMESTAMP();
+    stats.rx_wakes++;
+    (void)xTaskNotifyFromISR(task, UART_RTOS_NOTIFY_RX, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Wake the writer if enough TX space was freed
+ */
+void UART_Rtos_TxHook(void)
+{
+    TaskHandle_t task = tx_waiter;
+    if (task == NULL || UART_TxFree() < tx_space) {
+        return;
+    }
+
+    BaseType_t woken = pdFALSE;
+    tx_waiter = NULL;
+    tx_wake_stamp = UART_RTOS_TIMESTAMP();
+    stats.tx_wakes++;
+    (void)xTaskNotifyFromISR(task, UART_RTOS_NOTIFY_TX, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Convert an absolute deadline into a block time
+ * @param deadline Absolute tick deadline, or UART_RTOS_FOREVER
+ * @param ticks Pointer to store the ticks left
+ * @return false if the deadline has passed
+ */
+static bool RemainingTicks(TickType_t deadline, TickType_t *ticks)
+{
+    if (deadline == UART_RTOS_FOREVER) {
+        *ticks = portMAX_DELAY;
+        return true;
+    }
+
+    // Wrap-safe: a deadline more than half the tick range ahead is in the past
+    TickType_t left = deadline - xTaskGetTickCount();
+    if (left == 0U || left > (portMAX_DELAY / 2U)) {
+        return false;
+    }
+
+    *ticks = left;
+    return true;
+}
+
+/**
+ * @brief Wait for the ISR to notify this task
+ * @param slot Waiter slot the ISR clears when it notifies
+ * @param bit Notification bit for this direction
+ * @param deadline Absolute tick deadline
+ * @param stamp ISR timestamp of the notification
+ * @return UART_SUCCESS when notified, UART_ERROR_TIMEOUT at the deadline
+ */
+static UART_ErrorTypeDef Sleep(volatile TaskHandle_t *slot, uint32_t bit, TickType_t deadline,
+                               volatile uint32_t *stamp)
+{
+    TickType_t ticks;
+    uint32_t value;
+
+    while (RemainingTicks(deadline, &ticks)) {
+        // Other bits (the other direction) may end the wait early; only ours counts
+        if (xTaskNotifyWait(0U, bit, &value, ticks) == pdTRUE && (value & bit) != 0U) {
+            RecordLatency(*stamp);
+            return UART_SUCCESS;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    bool notified = (*slot == NULL);
+    *slot = NULL;
+    taskEXIT_CRITICAL();
+
+    if (notified) {
+        // The ISR fired between the last wait and the deadline check
+        (void)ulTaskNotifyValueClear(NULL, bit);
+        RecordLatency(*stamp);
+        return UART_SUCCESS;
+    }
+
+    stats.timeouts++;
+    return UART_ERROR_TIMEOUT;
+}
+
+/**
+ * @brief Move received bytes into a buffer through the RX span API
+ * @param data Destination
+ * @param len Most bytes to move
+ * @param delimiter Stop after this byte, or UART_RTOS_NO_DELIMITER
+ * @param found Pointer to store whether the delimiter was moved, may be NULL
+ * @return Bytes moved
+ */
+static uint16_t CopyOut(uint8_t *data, uint16_t len, int16_t delimiter, bool *found)
+{
+    uint16_t count = 0;
+
+    if (found != NULL) {
+        *found = false;
+    }
+
+    while (count < len) {
+        const uint8_t *span;
+        uint16_t n = UART_RxPeekSpan(&span);
+        if (n == 0U) {
+            break;
+        }
+        if (n > len - count) {
+            n = len - count;
+        }
+
+        if (delimiter != UART_RTOS_NO_DELIMITER) {
+            const uint8_t *hit = memchr(span, delimiter, n);
+            if (hit != NULL) {
+                n = (uint16_t)(hit - span + 1);
+                if (found != NULL) {
+                    *found = true;
+                }
+            }
+        }
+
+        memcpy(&data[count], span, n);
+        UART_RxConsume(n);
+        count += n;
+
+        if (found != NULL && *found) {
+            break;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Fold one ISR-to-task wake latency into the statistics
+ * @param stamp UART_RTOS_TIMESTAMP() taken by the ISR
+ */
+static void RecordLatency(uint32_t stamp)
+{
+    uint32_t latency = UART_RTOS_TIMESTAMP() - stamp;
+
+    taskENTER_CRITICAL();
+    stats.last_wake_latency = latency;
+    stats.total_wake_latency += latency;
+    if (latency < stats.min_wake_latency) {
+        stats.min_wake_latency = latency;
+    }
+    if (latency > stats.max_wake_latency) {
+        stats.max_wake_latency = latency;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* UART_USE_FREERTOS */
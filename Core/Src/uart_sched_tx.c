@@ -0,0 +1,251 @@
+/*
+ * uart_sched_tx.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_sched_tx.h"
+#include "uart_timebase.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define UART_INSTANCE &huart2
+#define BITS_PER_BYTE 10U           // Start, 8 data, stop
+
+/**** External Dependencies ****/
+extern UART_HandleTypeDef huart2;
+
+/**** Type Definitions ****/
+typedef enum {
+    SCHED_IDLE = 0,
+    SCHED_ARMED,    // Waiting for the guard and slot compare events
+    SCHED_READY,    // Slot reached, UART ISR starts the frame once the line is idle
+    SCHED_ACTIVE    // First byte out, UART ISR drains the rest
+} SchedStateTypeDef;
+
+/**** Private Variables ****/
+static uint8_t frame[UART_SCHED_TX_MAX_FRAME];
+static uint16_t frame_len;
+static volatile uint16_t frame_pos;
+static volatile SchedStateTypeDef state = SCHED_IDLE;
+static UART_SchedTxStatsTypeDef stats;
+
+/**** Private Function Prototypes ****/
+static uint32_t GuardTime(void);
+static void Disarm(void);
+static void RecordJitter(int32_t jitter_us);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Queue a frame to start transmitting at an absolute time
+ * @param data Frame bytes
+ * @param len Frame length
+ * @param start_us Start time on the UART_Time_Us() clock
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_SchedTx_Schedule(const uint8_t *data, uint16_t len, uint64_t start_us)
+{
+    if (data == NULL || len == 0 || len > UART_SCHED_TX_MAX_FRAME) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    if (state != SCHED_IDLE) {
+        return UART_ERROR_BUSY;
+    }
+
+    uint64_t now = UART_Time_Us();
+    if (start_us < now + UART_SCHED_TX_MIN_LEAD_US) {
+        return UART_ERROR_TIMEOUT;
+    }
+    if (start_us - now >= 0x80000000ULL) {
+        return UART_ERROR_INVALID_PARAM;  // Beyond half the 32-bit compare range
+    }
+
+    memcpy(frame, data, len);
+    frame_len = len;
+    frame_pos = 0;
+
+    uint32_t guard_us = GuardTime();
+    bool hold_now = (start_us - now) <= guard_us;
+
+    __disable_irq();
+    UART_TIMEBASE_TIM->CCR1 = (uint32_t)start_us;
+    UART_TIMEBASE_TIM->SR = (uint32_t)~(TIM_SR_CC1IF | TIM_SR_CC2IF);
+    if (!hold_now) {
+        UART_TIMEBASE_TIM->CCR2 = (uint32_t)start_us - guard_us;
+        UART_TIMEBASE_TIM->DIER |= TIM_DIER_CC2IE;
+    }
+    state = SCHED_ARMED;
+    UART_TIMEBASE_TIM->DIER |= TIM_DIER_CC1IE;
+
+    // The counter may have passed CCR1 while we were arming
+    if ((int32_t)((uint32_t)start_us - UART_TIMEBASE_TIM->CNT) <= 0 &&
+        !(UART_TIMEBASE_TIM->SR & TIM_SR_CC1IF)) {
+        Disarm();
+        state = SCHED_IDLE;
+        __enable_irq();
+        return UART_ERROR_TIMEOUT;
+    }
+
+    // Or CCR2, then the guard starts now
+    if (!hold_now && (int32_t)(UART_TIMEBASE_TIM->CCR2 - UART_TIMEBASE_TIM->CNT) <= 0 &&
+        !(UART_TIMEBASE_TIM->SR & TIM_SR_CC2IF)) {
+        UART_TIMEBASE_TIM->DIER &= ~TIM_DIER_CC2IE;
+        hold_now = true;
+    }
+    __enable_irq();
+
+    if (hold_now) {
+        UART_TxHold();
+    }
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Cancel a queued frame that has not started yet
+ */
+void UART_SchedTx_Cancel(void)
+{
+    __disable_irq();
+    if (state == SCHED_ARMED || state == SCHED_READY) {
+        Disarm();
+        state = SCHED_IDLE;
+        UART_TxRelease();
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief Check whether a frame is queued or still transmitting
+ * @return true if busy, false otherwise
+ */
+bool UART_SchedTx_IsPending(void)
+{
+    return state != SCHED_IDLE;
+}
+
+/**
+ * @brief Get start-time jitter statistics
+ * @param out Destination for a snapshot of the statistics
+ */
+void UART_SchedTx_GetStats(UART_SchedTxStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    __disable_irq();
+    *out = stats;
+    __enable_irq();
+}
+
+/**
+ * @brief Start the frame whose slot has been reached
+ * @param c Pointer to store the first byte
+ * @return true if the frame starts with this byte, false if none is due
+ */
+bool UART_SchedTx_Start(uint8_t *c)
+{
+    if (state != SCHED_READY) {
+        return false;
+    }
+
+    *c = frame[0];
+    frame_pos = 1;
+    state = SCHED_ACTIVE;
+    RecordJitter((int32_t)(UART_TIMEBASE_TIM->CNT - UART_TIMEBASE_TIM->CCR1));
+    return true;
+}
+
+/**
+ * @brief Fetch the next byte of the active frame
+ * @param c Pointer to store the byte
+ * @return true if a byte was returned, false if no frame is being sent
+ */
+bool UART_SchedTx_NextByte(uint8_t *c)
+{
+    if (state != SCHED_ACTIVE) {
+        return false;
+    }
+
+    if (frame_pos >= frame_len) {
+        state = SCHED_IDLE;
+        UART_TxRelease();   // Frame boundary, ring traffic follows back to back
+        return false;
+    }
+
+    *c = frame[frame_pos++];
+    return true;
+}
+
+/**
+ * @brief Compare event handler
+ */
+void UART_SchedTx_IRQHandler(void)
+{
+    uint32_t sr = UART_TIMEBASE_TIM->SR;
+    uint32_t dier = UART_TIMEBASE_TIM->DIER;
+
+    // Guard: let ring TX finish its current message, then hold it
+    if ((sr & TIM_SR_CC2IF) && (dier & TIM_DIER_CC2IE)) {
+        UART_TIMEBASE_TIM->SR = (uint32_t)~TIM_SR_CC2IF;
+        UART_TIMEBASE_TIM->DIER &= ~TIM_DIER_CC2IE;
+        if (state == SCHED_ARMED) {
+            UART_TxHold();
+        }
+    }
+
+    // Slot: the UART ISR sends byte 0 on TC, through the same per-byte hooks as ring bytes
+    if ((sr & TIM_SR_CC1IF) && (dier & TIM_DIER_CC1IE)) {
+        Disarm();
+        if (state == SCHED_ARMED) {
+            state = SCHED_READY;
+            if (!UART_TxStartScheduled()) {
+                stats.late_starts++;
+            }
+        }
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Line time of UART_SCHED_TX_GUARD_BYTES at the current baud rate
+ * @return Guard interval in microseconds
+ */
+static uint32_t GuardTime(void)
+{
+    uint32_t baud = (UART_INSTANCE)->Init.BaudRate;
+    return (uint32_t)(((uint64_t)UART_SCHED_TX_GUARD_BYTES * BITS_PER_BYTE * 1000000U + baud - 1U) / baud);
+}
+
+/**
+ * @brief Stop both compare events and drop their pending flags
+ */
+static void Disarm(void)
+{
+    UART_TIMEBASE_TIM->DIER &= ~(TIM_DIER_CC1IE | TIM_DIER_CC2IE);
+    UART_TIMEBASE_TIM->SR = (uint32_t)~(TIM_SR_CC1IF | TIM_SR_CC2IF);
+}
+
+/**
+ * @brief Accumulate one start-time jitter sample
+ * @param jitter_us Actual start minus requested start
+ */
+static void RecordJitter(int32_t jitter_us)
+{
+    if (stats.frames == 0 || jitter_us < stats.min_jitter_us) {
+        stats.min_jitter_us = jitter_us;
+    }
+    if (stats.frames == 0 || jitter_us > stats.max_jitter_us) {
+        stats.max_jitter_us = jitter_us;
+    }
+
+    stats.last_jitter_us = jitter_us;
+    stats.abs_jitter_sum_us += (uint32_t)((jitter_us < 0) ? -jitter_us : jitter_us);
+    stats.frames++;
+}
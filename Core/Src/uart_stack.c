@@ -0,0 +1,89 @@
+/*
+ * uart_stack.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_stack.h"
+#include "stm32l4xx_hal.h"
+#include <stddef.h>
+
+/**** Configuration Section ****/
+#define PAINT_GUARD 32U             // Bytes left unpainted below the SP of UART_Stack_Paint()
+
+/**** External Dependencies ****/
+extern uint8_t _estack;             // Linker script: top of RAM, initial MSP
+extern uint32_t _Min_Stack_Size;    // Linker script: stack budget (the symbol's address is the value)
+
+/**** Private Variables ****/
+static bool painted;
+
+/**** Private Function Prototypes ****/
+static uint32_t *StackLimit(void);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Fill the unused stack budget with the paint pattern
+ */
+void UART_Stack_Paint(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Everything below the SP is free; an interrupt now would push its frame right there
+    uint32_t *word = StackLimit();
+    uint32_t *top = (uint32_t *)(uintptr_t)((__get_MSP() - PAINT_GUARD) & ~3UL);
+    while (word < top) {
+        *word++ = UART_STACK_PAINT_PATTERN;
+    }
+    painted = true;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Measure the stack high-water mark
+ * @param out Destination for the statistics
+ */
+void UART_Stack_GetStats(UART_StackStatsTypeDef *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    uintptr_t estack = (uintptr_t)&_estack;
+
+    out->size = (uint32_t)(uintptr_t)&_Min_Stack_Size;
+    out->used_now = (uint32_t)(estack - __get_MSP());
+    out->painted = painted;
+    out->used_max = 0;
+    out->overflowed = false;
+
+    if (!painted) {
+        return;
+    }
+
+    // The first word that lost the pattern is the deepest the stack has been
+    const uint32_t *limit = StackLimit();
+    const uint32_t *word = limit;
+    while ((uintptr_t)word < estack && *word == UART_STACK_PAINT_PATTERN) {
+        word++;
+    }
+
+    out->used_max = (uint32_t)(estack - (uintptr_t)word);
+    out->overflowed = (word == limit);
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Lowest word of the stack budget, the limit _sbrk() keeps the heap below
+ */
+static uint32_t *StackLimit(void)
+{
+    uintptr_t limit = (uintptr_t)&_estack - (uintptr_t)&_Min_Stack_Size;
+    return (uint32_t *)((limit + 3U) & ~(uintptr_t)3U);
+}
@@ -0,0 +1,187 @@
+/*
+ * uart_timebase.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_timebase.h"
+
+/**** Configuration Section ****/
+#define TIMEBASE_HZ 1000000UL
+
+/**** Private Variables ****/
+static volatile uint32_t overflow_count;   // Upper 32 bits of the microsecond clock
+
+/**** Private Function Prototypes ****/
+static uint32_t GetTimerClock(void);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Start the microsecond timebase and the DWT cycle counter
+ * @return UART_SUCCESS on success, error code otherwise
+ */
+UART_ErrorTypeDef UART_Timebase_Init(void)
+{
+    uint32_t timer_clock = GetTimerClock();
+    if (timer_clock < TIMEBASE_HZ) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    // Cycle counter for cycle-accurate profiling; left running if SystemInit() (UART_BOOT_PROFILE)
+    // or a debugger already started it, boot marks count from the reset vector
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (!UART_BOOT_PROFILE && !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        DWT->CYCCNT = 0;
+    }
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    UART_TIMEBASE_TIM->CR1 = 0;
+    UART_TIMEBASE_TIM->PSC = (timer_clock / TIMEBASE_HZ) - 1U;
+    UART_TIMEBASE_TIM->ARR = 0xFFFFFFFFU;
+    UART_TIMEBASE_TIM->CNT = 0;
+    UART_TIMEBASE_TIM->EGR = TIM_EGR_UG;    // Latch the prescaler now
+    UART_TIMEBASE_TIM->SR = 0;
+    overflow_count = 0;
+
+    UART_TIMEBASE_TIM->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(TIM2_IRQn, UART_TIMEBASE_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+    UART_TIMEBASE_TIM->CR1 = TIM_CR1_URS | TIM_CR1_CEN;
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Read the 64-bit monotonic microsecond clock
+ * @return Microseconds since UART_Timebase_Init()
+ */
+uint64_t UART_Time_Us(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t high = overflow_count;
+    uint32_t low = UART_TIMEBASE_TIM->CNT;
+
+    // Wrapped but the update interrupt has not run yet (masked or preempted)
+    if ((UART_TIMEBASE_TIM->SR & TIM_SR_UIF) && (low < 0x80000000U)) {
+        high++;
+    }
+
+    __set_PRIMASK(primask);
+
+    return ((uint64_t)high << 32) | low;
+}
+
+/**
+ * @brief Check whether a microsecond deadline has passed
+ * @param deadline_us Absolute deadline from UART_Time_Us()
+ * @return true if the deadline has been reached, false otherwise
+ */
+bool UART_Time_DeadlineExpired(uint64_t deadline_us)
+{
+    return UART_Time_Us() >= deadline_us;
+}
+
+/**
+ * @brief Arm a one-shot TIM2 compare that ends WFI at a deadline
+ * @param deadline_us Absolute deadline from UART_Time_Us()
+ * @return true if armed, false if the deadline has already passed
+ */
+bool UART_Time_ArmWakeup(uint64_t deadline_us)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint64_t now = UART_Time_Us();
+    if (now >= deadline_us) {
+        __set_PRIMASK(primask);
+        return false;
+    }
+
+    uint32_t at = (deadline_us - now > UART_TIMEBASE_WAKEUP_MAX_US) ?
+                  (uint32_t)(now + UART_TIMEBASE_WAKEUP_MAX_US) : (uint32_t)deadline_us;
+    UART_TIMEBASE_TIM->CCR3 = at;
+    UART_TIMEBASE_TIM->SR = (uint32_t)~TIM_SR_CC3IF;
+    UART_TIMEBASE_TIM->DIER |= TIM_DIER_CC3IE;
+
+    // The counter may have passed CCR3 while we were arming, then no match comes
+    bool armed = (int32_t)(at - UART_TIMEBASE_TIM->CNT) > 0 || (UART_TIMEBASE_TIM->SR & TIM_SR_CC3IF);
+    if (!armed) {
+        UART_TIMEBASE_TIM->DIER &= ~TIM_DIER_CC3IE;
+    }
+
+    __set_PRIMASK(primask);
+    return armed;
+}
+
+/**
+ * @brief Disarm the compare set by UART_Time_ArmWakeup()
+ */
+void UART_Time_DisarmWakeup(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    UART_TIMEBASE_TIM->DIER &= ~TIM_DIER_CC3IE;
+    UART_TIMEBASE_TIM->SR = (uint32_t)~TIM_SR_CC3IF;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Re-derive the prescaler after a PCLK1 frequency change
+ */
+void UART_Timebase_Rescale(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t count = UART_TIMEBASE_TIM->CNT;
+    UART_TIMEBASE_TIM->PSC = (GetTimerClock() / TIMEBASE_HZ) - 1U;
+    UART_TIMEBASE_TIM->EGR = TIM_EGR_UG;    // Latch the prescaler now, this clears CNT
+    UART_TIMEBASE_TIM->CNT = count;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Timebase timer interrupt handler
+ */
+void UART_Timebase_IRQHandler(void)
+{
+    if (UART_TIMEBASE_TIM->SR & TIM_SR_UIF) {
+        UART_TIMEBASE_TIM->SR = (uint32_t)~TIM_SR_UIF;
+        overflow_count++;
+    }
+
+    // Wake-up compare: taking the interrupt already ended WFI, only disarm it
+    if ((UART_TIMEBASE_TIM->SR & TIM_SR_CC3IF) && (UART_TIMEBASE_TIM->DIER & TIM_DIER_CC3IE)) {
+        UART_TIMEBASE_TIM->SR = (uint32_t)~TIM_SR_CC3IF;
+        UART_TIMEBASE_TIM->DIER &= ~TIM_DIER_CC3IE;
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Get the kernel clock of the APB1 timers
+ * @return Timer clock in Hz
+ */
+static uint32_t GetTimerClock(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+    // APB1 timers run at 2x PCLK1 whenever the APB1 prescaler is not 1
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        return pclk1 * 2U;
+    }
+
+    return pclk1;
+}
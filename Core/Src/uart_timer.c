@@ -0,0 +1,320 @@
+/*
+ * uart_timer.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "uart_timer.h"
+#include <string.h>
+
+/**** Configuration Section ****/
+#define WHEEL_SIZE   (1UL << UART_TIMER_WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SIZE - 1UL)
+#define WHEEL_RANGE  ((1ULL << (UART_TIMER_WHEEL_BITS * UART_TIMER_WHEEL_LEVELS)) - 1ULL)
+#define WHEEL_WIDTH_MASK (WHEEL_SIZE == 64U ? UINT64_MAX : ((1ULL << WHEEL_SIZE) - 1ULL))
+
+#if UART_TIMER_WHEEL_BITS > 6
+#error "UART_TIMER_WHEEL_BITS must be at most 6 (one 64-bit occupancy word per level)"
+#endif
+
+/**** Private Variables ****/
+static UART_TimerTypeDef *wheel[UART_TIMER_WHEEL_LEVELS][WHEEL_SIZE];
+static uint64_t occupied[UART_TIMER_WHEEL_LEVELS];   // Bit per non-empty slot
+static uint32_t wheel_time;     // Last tick processed by UART_Timer_Process()
+
+/**** Private Function Prototypes ****/
+static void InsertTimer(UART_TimerTypeDef *timer);
+static void UnlinkTimer(UART_TimerTypeDef *timer);
+static uint32_t CascadeLevel(uint32_t level);
+static uint32_t NextEventDelta(void);
+static uint32_t EnterCritical(void);
+static void ExitCritical(uint32_t primask);
+
+/**** Public Functions ****/
+
+/**
+ * @brief Initialize the timer wheel
+ */
+void UART_Timer_Init(void)
+{
+    uint32_t primask = EnterCritical();
+    memset(wheel, 0, sizeof(wheel));
+    memset(occupied, 0, sizeof(occupied));
+    wheel_time = HAL_GetTick();
+    ExitCritical(primask);
+}
+
+/**
+ * @brief Arm (or re-arm) a timer relative to the current tick
+ * @param timer Timer object owned by the caller
+ * @param ticks Delay in HAL ticks (0 is treated as 1)
+ * @param callback Function called on expiry
+ * @param context Opaque pointer passed to the callback
+ * @return UART_SUCCESS on success, UART_ERROR_INVALID_PARAM otherwise
+ */
+UART_ErrorTypeDef UART_Timer_Start(UART_TimerTypeDef *timer, uint32_t ticks,
+                                   UART_TimerCallbackTypeDef callback, void *context)
+{
+    if (timer == NULL || callback == NULL) {
+        return UART_ERROR_INVALID_PARAM;
+    }
+
+    if (ticks == 0) {
+        ticks = 1;  // Never expire in the slot that is currently being run
+    }
+
+    uint32_t primask = EnterCritical();
+    if (timer->pprev != NULL) {
+        UnlinkTimer(timer);
+    }
+    timer->expires = HAL_GetTick() + ticks;
+    timer->callback = callback;
+    timer->context = context;
+    InsertTimer(timer);
+    ExitCritical(primask);
+
+    return UART_SUCCESS;
+}
+
+/**
+ * @brief Cancel a timer
+ * @param timer Timer to cancel
+ */
+void UART_Timer_Stop(UART_TimerTypeDef *timer)
+{
+    if (timer == NULL) {
+        return;
+    }
+
+    uint32_t primask = EnterCritical();
+    if (timer->pprev != NULL) {
+        UnlinkTimer(timer);
+    }
+    ExitCritical(primask);
+}
+
+/**
+ * @brief Check whether a timer is armed
+ * @param timer Timer to check
+ * @return true if the timer is pending, false otherwise
+ */
+bool UART_Timer_IsActive(const UART_TimerTypeDef *timer)
+{
+    return (timer != NULL) && (timer->pprev != NULL);
+}
+
+/**
+ * @brief Ticks until the wheel next has work for UART_Timer_Process()
+ * @param ticks Pointer to store the delay from the current tick (0: due now)
+ * @return true if any timer is armed, false otherwise
+ */
+bool UART_Timer_NextDeadline(uint32_t *ticks)
+{
+    if (ticks == NULL) {
+        return false;
+    }
+
+    uint32_t primask = EnterCritical();
+    uint32_t delta = NextEventDelta();
+    uint32_t due = wheel_time + delta;
+    uint32_t now = HAL_GetTick();
+    ExitCritical(primask);
+
+    if (delta == 0) {
+        return false;
+    }
+
+    *ticks = ((int32_t)(due - now) > 0) ? (due - now) : 0U;
+    return true;
+}
+
+/**
+ * @brief Advance the wheel to the current tick and run expired callbacks
+ */
+void UART_Timer_Process(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    while ((int32_t)(now - wheel_time) > 0) {
+        uint32_t primask = EnterCritical();
+
+        // Jump over ticks that neither expire nor cascade anything, e.g. after a tickless sleep
+        uint32_t delta = NextEventDelta();
+        if (delta == 0 || delta > now - wheel_time) {
+            delta = now - wheel_time;
+        }
+        wheel_time += delta;
+
+        // Pull the next chunk of each upper level down whenever the level below wraps
+        for (uint32_t level = 1; level < UART_TIMER_WHEEL_LEVELS; level++) {
+            if (CascadeLevel(level) != 0) {
+                break;
+            }
+        }
+        ExitCritical(primask);
+
+        // Every timer left in this slot expires exactly now
+        UART_TimerTypeDef **slot = &wheel[0][wheel_time & WHEEL_MASK];
+        for (;;) {
+            primask = EnterCritical();
+            UART_TimerTypeDef *timer = *slot;
+            if (timer == NULL) {
+                ExitCritical(primask);
+                break;
+            }
+            UART_TimerCallbackTypeDef callback = timer->callback;
+            void *context = timer->context;
+            UnlinkTimer(timer);
+            ExitCritical(primask);
+
+            callback(context);
+        }
+    }
+}
+
+/**** Private Functions ****/
+
+/**
+ * @brief Link a timer into the slot matching its expiry
+ * @param timer Timer with a valid expires field
+ * @note Caller must hold the critical section
+ */
+static void InsertTimer(UART_TimerTypeDef *timer)
+{
+    uint32_t delta = timer->expires - wheel_time;
+    uint32_t expires = timer->expires;
+    uint32_t level = 0;
+
+    if ((int32_t)delta < 0) {
+        delta = 0;
+        expires = wheel_time;
+    } else if ((uint64_t)delta > WHEEL_RANGE) {
+        // Park out-of-range timers in the top level; cascading re-files them
+        delta = (uint32_t)WHEEL_RANGE;
+        expires = wheel_time + delta;
+    }
+
+    while (level < UART_TIMER_WHEEL_LEVELS - 1 &&
+           delta >= (1UL << (UART_TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint32_t index = (expires >> (UART_TIMER_WHEEL_BITS * level)) & WHEEL_MASK;
+    UART_TimerTypeDef **slot = &wheel[level][index];
+
+    occupied[level] |= 1ULL << index;
+    timer->next = *slot;
+    if (timer->next != NULL) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = slot;
+    *slot = timer;
+}
+
+/**
+ * @brief Remove a timer from whichever slot holds it
+ * @param timer Armed timer
+ * @note Caller must hold the critical section
+ */
+static void UnlinkTimer(UART_TimerTypeDef *timer)
+{
+    UART_TimerTypeDef **pprev = timer->pprev;
+
+    *pprev = timer->next;
+    if (timer->next != NULL) {
+        timer->next->pprev = pprev;
+    }
+
+    // The last timer of a slot links back to the slot itself rather than to another timer
+    uintptr_t offset = (uintptr_t)pprev - (uintptr_t)&wheel[0][0];
+    if (*pprev == NULL && offset < sizeof(wheel)) {
+        uint32_t slot = (uint32_t)(offset / sizeof(wheel[0][0]));
+        occupied[slot >> UART_TIMER_WHEEL_BITS] &= ~(1ULL << (slot & WHEEL_MASK));
+    }
+
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+/**
+ * @brief Re-file the current slot of an upper level if the level below wrapped
+ * @param level Wheel level (1 .. UART_TIMER_WHEEL_LEVELS - 1)
+ * @return Slot index of this level, non-zero stops the cascade
+ * @note Caller must hold the critical section
+ */
+static uint32_t CascadeLevel(uint32_t level)
+{
+    uint32_t shift = UART_TIMER_WHEEL_BITS * level;
+
+    if ((wheel_time & ((1UL << shift) - 1UL)) != 0) {
+        return 1;   // Lower level has not wrapped yet
+    }
+
+    uint32_t index = (wheel_time >> shift) & WHEEL_MASK;
+    UART_TimerTypeDef *timer = wheel[level][index];
+    wheel[level][index] = NULL;
+    occupied[level] &= ~(1ULL << index);
+
+    while (timer != NULL) {
+        UART_TimerTypeDef *next = timer->next;
+        InsertTimer(timer);
+        timer = next;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Distance from wheel_time to the first tick with work
+ * @return Ticks (1 .. range), 0 if no timer is armed
+ * @note A timer in an upper level is reported at its cascade, which is never
+ *       later than its expiry. Caller must hold the critical section
+ */
+static uint32_t NextEventDelta(void)
+{
+    uint32_t best = 0;
+
+    for (uint32_t level = 0; level < UART_TIMER_WHEEL_LEVELS; level++) {
+        uint64_t bits = occupied[level];
+        if (bits == 0) {
+            continue;
+        }
+
+        // Rotate so bit 0 is the slot after the current one; the current slot comes last
+        uint32_t shift = UART_TIMER_WHEEL_BITS * level;
+        uint32_t start = ((wheel_time >> shift) + 1U) & WHEEL_MASK;
+        if (start != 0) {
+            bits = ((bits >> start) | (bits << (WHEEL_SIZE - start))) & WHEEL_WIDTH_MASK;
+        }
+
+        uint32_t slots = (uint32_t)__builtin_ctzll(bits) + 1U;
+        uint32_t delta = (((wheel_time >> shift) + slots) << shift) - wheel_time;
+        if (best == 0 || delta < best) {
+            best = delta;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Mask interrupts, remembering the previous state
+ * @return Previous PRIMASK value
+ */
+static uint32_t EnterCritical(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+/**
+ * @brief Restore the interrupt state saved by EnterCritical()
+ * @param primask Value returned by EnterCritical()
+ */
+static void ExitCritical(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+batch_timing.py
+
+  Created on: Oct 18, 2026
+      Author: agent
+
+End-to-end configuration time for single versus batched commands
+(uart_batch.h): the same command list is sent once as CMD_REQ frames, one
+round trip each, and once packed into BATCH_REQ frames of each requested
+size, resuming from "executed" when the board stops early. Time runs on the
+host clock from the first request byte to the last reply, so it includes the
+wire, USB and driver latency the firmware's UART_Batch_GetStats() cannot see.
+
+    python3 Tools/batch_timing.py /dev/ttyACM0 --cmd 0x10 --args 0102 --commands 64
+    python3 Tools/batch_timing.py --sim --batch 1,8,32,max --csv batch.csv
+
+--sim answers behind a pseudo terminal with the uart_bench.py board
+emulator, paced at the line rate, running an echo command; use it to check
+the tool and to see the wire-only ceiling for a given baud rate.
+"""
+
+import argparse
+import csv
+import sys
+import time
+
+from uart_bench import Link, Port, SimBoard, MAX_PAYLOAD
+
+TYPE_CMD_REQ = 0x03
+TYPE_CMD_RESP = 0x04
+TYPE_BATCH_REQ = 0x05
+TYPE_BATCH_RESP = 0x06
+
+BATCH_HEADER = 3                # batch_id, flags, count
+BATCH_RESP_HEADER = 2           # batch_id, executed
+ENTRY_HEADER = 2                # cmd, len / status, len
+MAX_REPLY = 16                  # UART_BATCH_MAX_REPLY
+FLAG_STOP_ON_ERROR = 0x01
+
+COLUMNS = ("mode", "batch", "commands", "frames", "total_ms", "per_cmd_us", "speedup", "failed")
+
+
+class SimBatchBoard(SimBoard):
+    """SimBoard that also executes CMD_REQ/BATCH_REQ like uart_batch.c, echoing the arguments."""
+
+    def handle(self, frame_type, payload):
+        if frame_type == TYPE_CMD_REQ and len(payload) >= 2:
+            self.queue(TYPE_CMD_RESP, bytes([payload[0], 0]) + payload[2:2 + MAX_REPLY])
+        elif frame_type == TYPE_BATCH_REQ and len(payload) >= BATCH_HEADER:
+            count, pos, out, executed = payload[2], BATCH_HEADER, bytearray(), 0
+            while executed < count and pos + ENTRY_HEADER <= len(payload):
+                length = payload[pos + 1]
+                if pos + ENTRY_HEADER + length > len(payload):
+                    break
+                if BATCH_RESP_HEADER + len(out) + ENTRY_HEADER + MAX_REPLY > MAX_PAYLOAD:
+                    break
+                reply = payload[pos + ENTRY_HEADER:pos + ENTRY_HEADER + length][:MAX_REPLY]
+                out += bytes([0, len(reply)]) + reply
+                pos += ENTRY_HEADER + length
+                executed += 1
+            self.queue(TYPE_BATCH_RESP, bytes([payload[0], executed]) + out)
+        else:
+            super().handle(frame_type, payload)
+
+
+def wait_for(link, frame_type, tag, timeout):
+    """Return the payload of the next frame_type frame whose first byte is tag."""
+    deadline = time.monotonic() + timeout
+    while True:
+        frame = link.receive(max(0.0, deadline - time.monotonic()))
+        if frame is None:
+            raise SystemExit("no reply (type 0x%02X); is uart_batch initialized on the board?" % frame_type)
+        if frame[0] == frame_type and frame[1] and frame[1][0] == tag:
+            return frame[1]
+
+
+def run_single(link, commands, timeout):
+    failed = 0
+    start = time.monotonic()
+    for seq, (cmd, args) in enumerate(commands):
+        link.send(TYPE_CMD_REQ, bytes([seq & 0xFF, cmd]) + args)
+        reply = wait_for(link, TYPE_CMD_RESP, seq & 0xFF, timeout)
+        failed += len(reply) >= 2 and reply[1] != 0
+    return time.monotonic() - start, len(commands), failed
+
+
+def pack(commands, first, limit):
+    """Entries from commands[first:] that fit one BATCH_REQ, at most limit of them."""
+    entries, size = [], BATCH_HEADER
+    for cmd, args in commands[first:first + limit]:
+        if size + ENTRY_HEADER + len(args) > MAX_PAYLOAD:
+            break
+        entries.append(bytes([cmd, len(args)]) + args)
+        size += ENTRY_HEADER + len(args)
+    return entries
+
+
+def run_batch(link, commands, limit, stop_on_error, timeout):
+    failed = frames = done = 0
+    batch_id = 0
+    flags = FLAG_STOP_ON_ERROR if stop_on_error else 0
+    start = time.monotonic()
+    while done < len(commands):
+        entries = pack(commands, done, limit)
+        if not entries:
+            raise SystemExit("command %d does not fit a BATCH_REQ frame" % done)
+        link.send(TYPE_BATCH_REQ, bytes([batch_id, flags, len(entries)]) + b"".join(entries))
+        reply = wait_for(link, TYPE_BATCH_RESP, batch_id, timeout)
+        executed = reply[1] if len(reply) >= 2 else 0
+        if executed == 0:
+            raise SystemExit("board executed nothing from batch %d" % batch_id)
+        pos = BATCH_RESP_HEADER
+        for _ in range(executed):
+            if pos + ENTRY_HEADER > len(reply):
+                break
+            failed += reply[pos] != 0
+            pos += ENTRY_HEADER + reply[pos + 1]
+        done += executed            # Resume after what ran, as the protocol asks
+        frames += 1
+        batch_id = (batch_id + 1) & 0xFF
+    return time.monotonic() - start, frames, failed
+
+
+def row(mode, batch, count, result, single_s):
+    seconds, frames, failed = result
+    return {"mode": mode, "batch": batch, "commands": count, "frames": frames,
+            "total_ms": "%.2f" % (seconds * 1e3), "per_cmd_us": "%.1f" % (seconds * 1e6 / count),
+            "speedup": "%.2f" % (single_s / seconds) if seconds > 0 else "", "failed": failed}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="End-to-end time of single versus batched commands.",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="serial device; omit with --sim")
+    parser.add_argument("--sim", action="store_true", help="run against the pty board emulator")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate of the link")
+    parser.add_argument("--cmd", type=lambda v: int(v, 0), default=0x01, help="command id to send")
+    parser.add_argument("--args", default="", help="argument bytes as hex, the same for every command")
+    parser.add_argument("--commands", type=int, default=64, help="commands in the configuration")
+    parser.add_argument("--batch", default="4,16,max", help="comma-separated commands per BATCH_REQ, or max")
+    parser.add_argument("--stop-on-error", action="store_true", help="set UART_BATCH_FLAG_STOP_ON_ERROR")
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for each reply")
+    parser.add_argument("--csv", help="also write the results to this file")
+    args = parser.parse_args()
+
+    if args.sim == (args.port is not None):
+        parser.error("give a serial port or --sim")
+    cmd_args = bytes.fromhex(args.args)
+    if len(cmd_args) > MAX_PAYLOAD - BATCH_HEADER - ENTRY_HEADER:
+        parser.error("--args too long for one frame")
+    commands = [(args.cmd, cmd_args)] * args.commands
+    limits = [255 if b == "max" else min(max(int(b), 1), 255) for b in args.batch.split(",") if b]
+
+    board = SimBatchBoard(args.baud) if args.sim else None
+    port = Port(board.path if board else args.port, args.baud)
+    link = Link(port)
+    rows = []
+
+    try:
+        print("  ".join("%-10s" % c for c in COLUMNS))
+        single = run_single(link, commands, args.timeout)
+        rows.append(row("single", 1, len(commands), single, single[0]))
+        print("  ".join("%-10s" % rows[-1][c] for c in COLUMNS))
+        for limit in limits:
+            result = run_batch(link, commands, limit, args.stop_on_error, args.timeout)
+            rows.append(row("batch", "max" if limit == 255 else limit, len(commands), result, single[0]))
+            print("  ".join("%-10s" % rows[-1][c] for c in COLUMNS))
+            sys.stdout.flush()
+    finally:
+        port.close()
+        if board is not None:
+            board.close()
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=COLUMNS)
+            writer.writeheader()
+            writer.writerows(rows)
+
+    return 0 if all(r["failed"] == 0 for r in rows) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
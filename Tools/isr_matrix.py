@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+isr_matrix.py
+
+  Created on: Oct 18, 2026
+      Author: agent
+
+ISR cycle matrix over driver feature combinations.
+
+UART_ISR_Handler() is specialized at compile time, so every combination is
+its own firmware. For each one this tool runs the --build command with the
+feature defines substituted for {defines}, runs --flash, then asks the
+board for UART_BenchmarkIsr() over the benchmark link (uart_bench.h,
+BENCH_CTRL op ISR) and prints the per-path cycle counts:
+
+    python3 Tools/isr_matrix.py /dev/ttyACM0 \\
+        --build 'make -C Debug all DEFS="{defines}"' \\
+        --flash 'STM32_Programmer_CLI -c port=SWD -w Debug/app.elf -rst'
+
+By default the matrix is the baseline, each feature alone and all of them
+together; --all-subsets builds every combination. Half-duplex and FreeRTOS
+are left out unless named with --features: the first turns the link into
+a single wire, the second needs an RTOS project.
+
+The feature mask the board reports is checked against the requested one,
+which catches a build command that dropped the defines.
+"""
+
+import argparse
+import csv
+import itertools
+import struct
+import subprocess
+import sys
+import time
+
+from uart_bench import Link, Port, OP_ISR, TYPE_CTRL, TYPE_ISR
+
+ISR_RESULT = struct.Struct("<IIIIII")
+
+# Same order as the UART_ISR_FEATURE_* bits in uart_ring_buffer.h
+FEATURES = [
+    ("elastic", "UART_ELASTIC_RINGS"),
+    ("counts", "UART_ENABLE_CLOCK_GOVERNOR"),
+    ("half_duplex", "UART_ENABLE_HALF_DUPLEX"),
+    ("timestamps", "UART_ENABLE_TIMESTAMPS"),
+    ("poll", "UART_ENABLE_POLL"),
+    ("thresholds", "UART_ENABLE_THRESHOLDS"),
+    ("sched_tx", "UART_ENABLE_SCHED_TX"),
+    ("rtos", "UART_USE_FREERTOS"),
+    ("boot", "UART_BOOT_PROFILE"),
+    ("profile", "UART_ENABLE_ISR_PROFILE"),
+]
+DEFAULT_FEATURES = [name for name, _ in FEATURES if name not in ("half_duplex", "rtos")]
+BASE_DEFINES = ["UART_ENABLE_BENCHMARK", "UART_ENABLE_ISR_BENCHMARK"]
+COLUMNS = ("features", "mask", "idle", "rx", "tx", "tx_empty", "error", "rx_delta", "tx_delta")
+
+
+def feature_mask(names):
+    return sum(1 << i for i, (name, _) in enumerate(FEATURES) if name in names)
+
+
+def combinations(selected, all_subsets):
+    if all_subsets:
+        for n in range(len(selected) + 1):
+            for combo in itertools.combinations(selected, n):
+                yield list(combo)
+        return
+    yield []
+    for name in selected:
+        yield [name]
+    if len(selected) > 1:
+        yield list(selected)
+
+
+def run(command, dry_run):
+    print("$ " + command)
+    if not dry_run:
+        subprocess.run(command, shell=True, check=True)
+
+
+def measure(port_path, baud, timeout):
+    """Ask the running firmware for UART_BenchmarkIsr(), return it as a dict."""
+    port = Port(port_path, baud)
+    try:
+        link = Link(port)
+        link.send(TYPE_CTRL, struct.pack("<B", OP_ISR))
+        deadline = time.monotonic() + timeout
+        while True:
+            frame = link.receive(max(0.0, deadline - time.monotonic()))
+            if frame is None:
+                raise SystemExit("no BENCH_ISR; is the firmware built with UART_ENABLE_ISR_BENCHMARK=1?")
+            if frame[0] == TYPE_ISR and len(frame[1]) >= ISR_RESULT.size:
+                values = ISR_RESULT.unpack_from(frame[1])
+                return dict(zip(("mask", "idle", "rx", "tx", "tx_empty", "error"), values))
+    finally:
+        port.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="ISR cycle matrix over driver feature combinations.",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial device of the board")
+    parser.add_argument("--build", required=True, help="build command, {defines} becomes the -D flags")
+    parser.add_argument("--flash", required=True, help="command that flashes and resets the board")
+    parser.add_argument("--features", default=",".join(DEFAULT_FEATURES),
+                        help="comma-separated features to combine: " + ", ".join(n for n, _ in FEATURES))
+    parser.add_argument("--all-subsets", action="store_true", help="every combination, not only singles")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate the firmware starts at")
+    parser.add_argument("--boot-delay", type=float, default=1.0, help="seconds to wait after flashing")
+    parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for the result")
+    parser.add_argument("--dry-run", action="store_true", help="print the commands only")
+    parser.add_argument("--csv", help="also write the results to this file")
+    args = parser.parse_args()
+
+    known = dict(FEATURES)
+    selected = [f for f in args.features.split(",") if f]
+    for name in selected:
+        if name not in known:
+            parser.error("unknown feature %s" % name)
+
+    rows = []
+    baseline = None
+    print("  ".join("%-10s" % c for c in COLUMNS))
+    for combo in combinations(selected, args.all_subsets):
+        defines = " ".join("-D%s=1" % d for d in BASE_DEFINES + [known[n] for n in combo])
+        run(args.build.replace("{defines}", defines), args.dry_run)
+        run(args.flash, args.dry_run)
+        if args.dry_run:
+            continue
+        time.sleep(args.boot_delay)
+
+        result = measure(args.port, args.baud, args.timeout)
+        if result["mask"] != feature_mask(combo):
+            sys.exit("board reports features 0x%03X, expected 0x%03X: the build ignored {defines}"
+                     % (result["mask"], feature_mask(combo)))
+        if not combo:
+            baseline = result
+        row = dict(result, features="+".join(combo) or "baseline", mask="0x%03X" % result["mask"])
+        row["rx_delta"] = result["rx"] - baseline["rx"] if baseline else ""
+        row["tx_delta"] = result["tx"] - baseline["tx"] if baseline else ""
+        rows.append(row)
+        print("  ".join("%-10s" % row[c] for c in COLUMNS))
+        sys.stdout.flush()
+
+    if args.csv and rows:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=COLUMNS)
+            writer.writeheader()
+            writer.writerows(rows)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
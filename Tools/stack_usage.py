@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+stack_usage.py
+
+  Created on: Oct 18, 2026
+      Author: agent
+
+Static stack report from GCC -fstack-usage output (*.su files).
+
+Build with -fstack-usage (STM32CubeIDE: Project > Properties > C/C++ Build >
+Settings > MCU GCC Compiler > Miscellaneous > "-fstack-usage"), then run
+
+    python3 Tools/stack_usage.py Debug
+    python3 Tools/stack_usage.py Debug --thread main,UART_WaitForString,WaitForData
+
+The report lists the frame of every driver function and estimates the
+worst case for interrupts: one handler chain per priority level can be
+active at a time, each with its hardware exception frame, on top of the
+deepest thread chain given with --thread. Compare the total with the
+runtime high-water mark from UART_Stack_GetStats().
+
+-fstack-usage only knows each function's own frame; inlined static helpers
+are already part of their caller's frame. Chains are therefore summed from
+the names listed below and on the command line, not from a call graph.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Cortex-M4F exception entry: 8 words, 26 with the lazy FP context
+EXCEPTION_FRAME = 32
+EXCEPTION_FRAME_FP = 104
+
+# Handler chains as (priority, [[alternatives called at depth 0], [depth 1], ...]).
+# Functions that run one after another at the same depth are alternatives: the
+# deeper of the two counts. Priorities match the NVIC setup in this tree.
+ISR_CHAINS = {
+    "USART2": (0, [["USART2_IRQHandler"],
+                   ["UART_ISR_Handler", "HAL_UART_IRQHandler"],
+                   ["UART_Boot_Mark", "UART_HalfDuplex_IsEcho", "UART_HalfDuplex_OnTransmit",
+                    "UART_SchedTx_Start", "UART_SchedTx_NextByte", "UART_Rtos_RxHook", "UART_Rtos_TxHook",
+                    "UART_RxThresholdCallback", "UART_TxThresholdCallback"],
+                   ["UART_TxRelease"]]),
+    "TIM2":   (2, [["TIM2_IRQHandler"],
+                   ["UART_Timebase_IRQHandler", "UART_SchedTx_IRQHandler"],
+                   ["UART_TxHold", "UART_TxStartScheduled"],
+                   ["UART_TxHold"]]),
+    "SysTick": (0, [["SysTick_Handler"],
+                    ["HAL_IncTick"]]),
+    "LPTIM1": (3, [["LPTIM1_IRQHandler"],
+                   ["UART_Idle_IRQHandler"]]),
+}
+
+SU_LINE = re.compile(r"^(?P<file>.*?):(?P<line>\d+):(?P<col>\d+):(?P<func>[^\t]+)\t(?P<bytes>\d+)\t(?P<kind>.*)$")
+
+
+def load(build_dir):
+    """Return {function: (bytes, kind, file)} from every .su file below build_dir."""
+    frames = {}
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(root, name)) as f:
+                for line in f:
+                    m = SU_LINE.match(line.rstrip("\n"))
+                    if not m:
+                        continue
+                    func = m.group("func")
+                    size = int(m.group("bytes"))
+                    # Static functions may share a name across files; keep the larger frame
+                    if func not in frames or frames[func][0] < size:
+                        frames[func] = (size, m.group("kind"), os.path.basename(m.group("file")))
+    return frames
+
+
+def chain_depth(frames, levels, missing):
+    """Sum the largest known frame at each depth of a chain."""
+    total = 0
+    for alternatives in levels:
+        known = [frames[f][0] for f in alternatives if f in frames]
+        missing.extend(f for f in alternatives if f not in frames)
+        total += max(known) if known else 0
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static stack report from GCC -fstack-usage output.",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("build_dir", nargs="?", default="Debug", help="directory holding the .su files")
+    parser.add_argument("--all", action="store_true", help="list every function, not only the driver")
+    parser.add_argument("--thread", default="", help="comma-separated thread call chain to add")
+    parser.add_argument("--budget", type=lambda v: int(v, 0), default=0x400, help="_Min_Stack_Size")
+    parser.add_argument("--no-fpu", action="store_true", help="exception frames without FP context")
+    args = parser.parse_args()
+
+    frames = load(args.build_dir)
+    if not frames:
+        sys.exit("no .su files under %s; build with -fstack-usage" % args.build_dir)
+
+    print("%-40s %-24s %6s  %s" % ("function", "file", "bytes", "kind"))
+    for func, (size, kind, src) in sorted(frames.items(), key=lambda kv: -kv[1][0]):
+        if args.all or src.startswith("uart_") or src == "stm32l4xx_it.c":
+            flag = "  <-- not static" if kind != "static" else ""
+            print("%-40s %-24s %6d  %s%s" % (func, src, size, kind, flag))
+
+    missing = []
+    frame = EXCEPTION_FRAME if args.no_fpu else EXCEPTION_FRAME_FP
+    worst_by_priority = {}
+    print("\nInterrupt chains (+%d bytes exception frame each):" % frame)
+    for name, (priority, levels) in ISR_CHAINS.items():
+        depth = chain_depth(frames, levels, missing) + frame
+        print("  %-8s prio %d  %5d" % (name, priority, depth))
+        worst_by_priority[priority] = max(worst_by_priority.get(priority, 0), depth)
+    isr_total = sum(worst_by_priority.values())
+
+    thread = [f for f in args.thread.split(",") if f]
+    thread_total = chain_depth(frames, [[f] for f in thread], missing)
+
+    print("\nThread chain       %5d  %s" % (thread_total, " > ".join(thread) or "(none given)"))
+    print("Nested interrupts  %5d  (one chain per priority level)" % isr_total)
+    print("Worst case         %5d  of %d budget" % (thread_total + isr_total, args.budget))
+    if missing:
+        print("\nNot in any .su file (inlined, not linked, or outside the build): %s"
+              % ", ".join(sorted(set(missing))))
+
+    return 0 if thread_total + isr_total <= args.budget else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
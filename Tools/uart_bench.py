@@ -0,0 +1,579 @@
+#!/usr/bin/env python3
+"""
+uart_bench.py
+
+  Created on: Oct 18, 2026
+      Author: agent
+
+Link benchmark for firmware built with UART_ENABLE_BENCHMARK=1 (uart_bench.h).
+
+    python3 Tools/uart_bench.py /dev/ttyACM0
+    python3 Tools/uart_bench.py /dev/ttyACM0 --baud 115200,460800,921600 --len 16,64,256
+    python3 Tools/uart_bench.py --sim --csv sim.csv
+
+Tests, each run per baud rate and payload length:
+
+  sink      host streams DATA, the board counts it (board-side rate and loss)
+  source    the board streams DATA as fast as its TX ring drains
+  echo      host streams DATA, the board sends every frame back
+  pingpong  one DATA frame in flight; RTT percentiles and the board's share
+
+Throughput counts framed bytes on the wire against the line rate of 10 bits
+per byte (8N1). RTT is measured on the host clock; turnaround is the board's
+tx_us - rx_us for the same frame.
+
+--sim runs the same protocol against a board emulator behind a pseudo
+terminal. The emulator paces both directions at 10 bits per byte for the
+selected baud rate and has the firmware's 1024-byte TX ring, so its numbers
+are the ceiling a real link can reach with this host; the difference to a
+board run is USB, driver and firmware cost.
+"""
+
+import argparse
+import csv
+import os
+import select
+import struct
+import sys
+import threading
+import time
+
+SOF = 0x7E
+TYPE_CTRL = 0x0A
+TYPE_DATA = 0x0B
+TYPE_REPORT = 0x0C
+TYPE_ISR = 0x0D
+
+OP_START = 1
+OP_STOP = 2
+OP_SET_BAUD = 3
+OP_ISR = 4
+
+MODE_IDLE, MODE_SINK, MODE_SOURCE, MODE_ECHO = range(4)
+
+DATA_HEADER = 16                # seq, host_us, rx_us, tx_us
+FRAME_OVERHEAD = 6              # SOF, LEN, TYPE, checksum
+MAX_PAYLOAD = 256
+BITS_PER_BYTE = 10
+REPORT = struct.Struct("<BBHIIIIIIIIII")
+REPORT_FIELDS = ("mode", "reserved", "buffer_size", "baud", "rx_frames", "rx_bytes", "tx_frames",
+                 "tx_bytes", "lost", "first_rx_us", "last_rx_us", "checksum_errors", "overruns")
+
+
+def now_us():
+    return int(time.monotonic() * 1e6) & 0xFFFFFFFF
+
+
+def fletcher16(data):
+    a = b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return (b << 8) | a
+
+
+def encode(frame_type, payload):
+    body = struct.pack("<HB", len(payload), frame_type) + payload
+    return bytes([SOF]) + body + struct.pack("<H", fletcher16(body))
+
+
+def fill(seq, length):
+    return bytes((seq + i) & 0xFF for i in range(DATA_HEADER, length))
+
+
+def data_payload(seq, length, host_us=0, rx_us=0, tx_us=0):
+    return struct.pack("<IIII", seq, host_us, rx_us, tx_us) + fill(seq, length)
+
+
+class Parser:
+    """Byte-wise frame parser, same states as uart_frame.c."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.checksum_errors = 0
+
+    def feed(self, data):
+        self.buf += data
+        frames = []
+        while True:
+            start = self.buf.find(bytes([SOF]))
+            if start < 0:
+                self.buf.clear()
+                return frames
+            del self.buf[:start]
+            if len(self.buf) < 4:
+                return frames
+            length = self.buf[1] | (self.buf[2] << 8)
+            if length > MAX_PAYLOAD:
+                del self.buf[:1]
+                continue
+            end = 4 + length + 2
+            if len(self.buf) < end:
+                return frames
+            body = bytes(self.buf[1:4 + length])
+            checksum = self.buf[4 + length] | (self.buf[5 + length] << 8)
+            if checksum != fletcher16(body):
+                self.checksum_errors += 1
+                del self.buf[:1]
+                continue
+            frames.append((body[2], body[3:]))
+            del self.buf[:end]
+
+
+class Port:
+    """Raw 8N1 serial port: pyserial when installed, termios otherwise."""
+
+    def __init__(self, path, baud):
+        self.serial = None
+        self.fd = None
+        try:
+            import serial
+            self.serial = serial.Serial(path, baud, timeout=0)
+        except ImportError:
+            import termios
+            import tty
+            self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+            tty.setraw(self.fd)
+            self.set_baud(baud)
+            termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def set_baud(self, baud):
+        if self.serial is not None:
+            self.serial.baudrate = baud
+            return
+        import termios
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is None:
+            raise SystemExit("baud %d not supported by termios; install pyserial" % baud)
+        attrs = termios.tcgetattr(self.fd)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSADRAIN, attrs)
+
+    def write(self, data):
+        if self.serial is not None:
+            self.serial.write(data)
+            return
+        view = memoryview(data)
+        while view:
+            view = view[os.write(self.fd, view):]
+
+    def read(self, timeout):
+        if self.serial is not None:
+            self.serial.timeout = timeout
+            first = self.serial.read(1)
+            return first + self.serial.read(self.serial.in_waiting) if first else b""
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        return os.read(self.fd, 4096) if ready else b""
+
+    def drain(self):
+        if self.serial is not None:
+            self.serial.flush()
+        else:
+            import termios
+            termios.tcdrain(self.fd)
+
+    def close(self):
+        if self.serial is not None:
+            self.serial.close()
+        else:
+            os.close(self.fd)
+
+
+class Link:
+    """Frame-level view of a Port."""
+
+    def __init__(self, port):
+        self.port = port
+        self.parser = Parser()
+        self.pending = []
+
+    def send(self, frame_type, payload):
+        self.port.write(encode(frame_type, payload))
+
+    def receive(self, timeout):
+        """Return (frame_type, payload, host_us) or None after timeout seconds without a frame."""
+        deadline = time.monotonic() + timeout
+        while not self.pending:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                return None
+            data = self.port.read(left)
+            stamp = now_us()
+            self.pending.extend((t, p, stamp) for t, p in self.parser.feed(data))
+        return self.pending.pop(0)
+
+    def control(self, payload, timeout):
+        """Send a BENCH_CTRL and return its REPORT as a dict, skipping stray DATA."""
+        self.send(TYPE_CTRL, payload)
+        deadline = time.monotonic() + timeout
+        while True:
+            frame = self.receive(max(0.0, deadline - time.monotonic()))
+            if frame is None:
+                raise SystemExit("no BENCH_REPORT; is the firmware built with UART_ENABLE_BENCHMARK=1?")
+            if frame[0] == TYPE_REPORT and len(frame[1]) >= REPORT.size:
+                return dict(zip(REPORT_FIELDS, REPORT.unpack_from(frame[1])))
+
+
+class SimBoard:
+    """Board emulator behind a pseudo terminal, speaking the uart_bench.c protocol."""
+
+    BUFFER_SIZE = 1024
+
+    def __init__(self, baud):
+        self.master, self.slave = os.openpty()
+        self.path = os.ttyname(self.slave)
+        import tty
+        tty.setraw(self.slave)
+        self.baud = baud
+        self.lock = threading.Condition()
+        self.tx = bytearray()
+        self.parser = Parser()
+        self.pending_baud = 0
+        self.running = True
+        self.reset(MODE_IDLE, 0, DATA_HEADER)
+        self.threads = [threading.Thread(target=self.rx_loop, daemon=True),
+                        threading.Thread(target=self.tx_loop, daemon=True)]
+        for thread in self.threads:
+            thread.start()
+
+    def reset(self, mode, count, length):
+        self.mode = mode
+        self.stats = dict.fromkeys(("rx_frames", "rx_bytes", "tx_frames", "tx_bytes", "lost",
+                                    "first_rx_us", "last_rx_us"), 0)
+        self.next_seq = 0
+        self.source_seq = 0
+        self.source_count = count
+        self.source_len = min(max(length, DATA_HEADER), MAX_PAYLOAD)
+
+    def close(self):
+        self.running = False
+        with self.lock:
+            self.lock.notify_all()
+        for thread in self.threads:
+            thread.join(1.0)
+        os.close(self.master)
+        os.close(self.slave)
+
+    def queue(self, frame_type, payload):
+        frame = encode(frame_type, payload)
+        self.tx += frame
+        self.lock.notify_all()
+        return len(frame)
+
+    def rx_loop(self):
+        wire = time.monotonic()
+        while self.running:
+            ready, _, _ = select.select([self.master], [], [], 0.05)
+            if not ready:
+                continue
+            try:
+                data = os.read(self.master, 64)
+            except OSError:
+                return
+            # Bytes cannot arrive faster than the line rate
+            wire = max(wire, time.monotonic()) + len(data) * BITS_PER_BYTE / self.baud
+            delay = wire - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            with self.lock:
+                for frame_type, payload in self.parser.feed(data):
+                    self.handle(frame_type, payload)
+
+    def tx_loop(self):
+        wire = time.monotonic()
+        while self.running:
+            with self.lock:
+                self.source()
+                if not self.tx:
+                    if self.pending_baud:
+                        self.baud, self.pending_baud = self.pending_baud, 0
+                    self.lock.wait(0.05)
+                    continue
+                chunk = bytes(self.tx[:64])
+                del self.tx[:64]
+            wire = max(wire, time.monotonic()) + len(chunk) * BITS_PER_BYTE / self.baud
+            try:
+                os.write(self.master, chunk)
+            except OSError:
+                return
+            delay = wire - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+
+    def source(self):
+        if self.mode != MODE_SOURCE:
+            return
+        size = self.source_len + FRAME_OVERHEAD
+        while self.source_seq < self.source_count and self.BUFFER_SIZE - len(self.tx) >= size:
+            payload = data_payload(self.source_seq, self.source_len, tx_us=now_us())
+            self.stats["tx_bytes"] += self.queue(TYPE_DATA, payload)
+            self.stats["tx_frames"] += 1
+            self.source_seq += 1
+        if self.source_seq >= self.source_count:
+            self.mode = MODE_IDLE
+
+    def handle(self, frame_type, payload):
+        if frame_type == TYPE_CTRL and payload:
+            op = payload[0]
+            if op == OP_START and len(payload) >= 8 and payload[1] <= MODE_ECHO:
+                count, length = struct.unpack_from("<IH", payload, 2)
+                self.reset(payload[1], count, length)
+            elif op == OP_STOP:
+                self.mode = MODE_IDLE
+            elif op == OP_SET_BAUD and len(payload) >= 5:
+                self.mode = MODE_IDLE
+                self.pending_baud = struct.unpack_from("<I", payload, 1)[0]
+            else:
+                return
+            s = self.stats
+            self.queue(TYPE_REPORT, REPORT.pack(self.mode, 0, self.BUFFER_SIZE, self.baud, s["rx_frames"],
+                                                s["rx_bytes"], s["tx_frames"], s["tx_bytes"], s["lost"],
+                                                s["first_rx_us"], s["last_rx_us"],
+                                                self.parser.checksum_errors, 0))
+        elif frame_type == TYPE_DATA and len(payload) >= DATA_HEADER and self.mode in (MODE_SINK, MODE_ECHO):
+            rx_us = now_us()
+            seq = struct.unpack_from("<I", payload)[0]
+            s = self.stats
+            if s["rx_frames"] == 0:
+                s["first_rx_us"] = rx_us
+            s["last_rx_us"] = rx_us
+            s["rx_frames"] += 1
+            s["rx_bytes"] += len(payload) + FRAME_OVERHEAD
+            if ((seq - self.next_seq) & 0xFFFFFFFF) < 0x80000000:
+                s["lost"] += (seq - self.next_seq) & 0xFFFFFFFF
+                self.next_seq = (seq + 1) & 0xFFFFFFFF
+            if self.mode == MODE_ECHO:
+                out = payload[:8] + struct.pack("<II", rx_us, now_us()) + payload[DATA_HEADER:]
+                s["tx_bytes"] += self.queue(TYPE_DATA, out)
+                s["tx_frames"] += 1
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(round(p / 100.0 * (len(ordered) - 1))))]
+
+
+def board_rate(report):
+    """Framed bytes per second between the first and last DATA SOF seen by the board."""
+    span = (report["last_rx_us"] - report["first_rx_us"]) & 0xFFFFFFFF
+    if report["rx_frames"] < 2 or span == 0:
+        return 0.0
+    per_frame = report["rx_bytes"] / report["rx_frames"]
+    return (report["rx_bytes"] - per_frame) * 1e6 / span
+
+
+def check_data(payload, length):
+    seq = struct.unpack_from("<I", payload)[0]
+    return len(payload) == length and payload[DATA_HEADER:] == fill(seq, length)
+
+
+def run_sink(link, baud, length, count, timeout):
+    # Board error counters run since boot; the START report is the baseline
+    base = link.control(struct.pack("<BBIH", OP_START, MODE_SINK, count, length), timeout)
+    frame_bytes = length + FRAME_OVERHEAD
+    start = time.monotonic()
+    for seq in range(count):
+        link.send(TYPE_DATA, data_payload(seq, length, host_us=now_us()))
+    link.port.drain()
+    # STOP queues behind the data, so its REPORT covers every frame
+    report = link.control(struct.pack("<B", OP_STOP), timeout + count * frame_bytes * BITS_PER_BYTE / baud)
+    elapsed = time.monotonic() - start
+    return {"frames": report["rx_frames"], "bytes": report["rx_bytes"], "seconds": elapsed,
+            "loss": count - report["rx_frames"], "board_Bps": board_rate(report),
+            "checksum_errors": report["checksum_errors"] - base["checksum_errors"],
+            "overruns": report["overruns"] - base["overruns"],
+            "buffer_size": report["buffer_size"]}
+
+
+def run_source(link, baud, length, count, timeout):
+    report = link.control(struct.pack("<BBIH", OP_START, MODE_SOURCE, count, length), timeout)
+    # The board starts sending right behind its START report, so every frame counts from here;
+    # timing from the first frame's arrival drops its line time and overstates the rate
+    start = last = time.monotonic()
+    received = corrupt = 0
+    while received < count:
+        frame = link.receive(timeout)
+        if frame is None:
+            break
+        frame_type, payload, stamp = frame
+        if frame_type != TYPE_DATA:
+            continue
+        received += 1
+        if not check_data(payload, length):
+            corrupt += 1
+        last = time.monotonic()
+    span = last - start
+    framed = received * (length + FRAME_OVERHEAD)
+    return {"frames": received, "bytes": framed,
+            "seconds": span, "host_Bps": framed / span if span else 0.0,
+            "loss": count - received + corrupt, "checksum_errors": link.parser.checksum_errors,
+            "buffer_size": report["buffer_size"]}
+
+
+def run_echo(link, baud, length, count, timeout):
+    report = link.control(struct.pack("<BBIH", OP_START, MODE_ECHO, count, length), timeout)
+    rtts = []
+    turnaround = []
+    received = corrupt = 0
+    done = threading.Event()
+
+    def writer():
+        for seq in range(count):
+            link.send(TYPE_DATA, data_payload(seq, length, host_us=now_us()))
+        done.set()
+
+    start = time.monotonic()
+    thread = threading.Thread(target=writer, daemon=True)
+    thread.start()
+    while received < count:
+        frame = link.receive(timeout)
+        if frame is None and done.is_set():
+            break
+        if frame is None or frame[0] != TYPE_DATA:
+            continue
+        _, payload, stamp = frame
+        received += 1
+        if not check_data(payload, length):
+            corrupt += 1
+            continue
+        _, host_us, rx_us, tx_us = struct.unpack_from("<IIII", payload)
+        rtts.append(((stamp - host_us) & 0xFFFFFFFF) / 1000.0)
+        turnaround.append(((tx_us - rx_us) & 0xFFFFFFFF) / 1000.0)
+    elapsed = time.monotonic() - start
+    thread.join()
+    return {"frames": received, "bytes": received * (length + FRAME_OVERHEAD), "seconds": elapsed,
+            "loss": count - received + corrupt, "rtt_ms": rtts, "turnaround_ms": turnaround,
+            "checksum_errors": link.parser.checksum_errors, "buffer_size": report["buffer_size"]}
+
+
+def run_pingpong(link, baud, length, count, timeout):
+    report = link.control(struct.pack("<BBIH", OP_START, MODE_ECHO, count, length), timeout)
+    rtts = []
+    turnaround = []
+    lost = 0
+    start = time.monotonic()
+    for seq in range(count):
+        link.send(TYPE_DATA, data_payload(seq, length, host_us=now_us()))
+        while True:
+            frame = link.receive(timeout)
+            if frame is None:
+                lost += 1
+                break
+            frame_type, payload, stamp = frame
+            if frame_type != TYPE_DATA or len(payload) < DATA_HEADER:
+                continue
+            echoed_seq, host_us, rx_us, tx_us = struct.unpack_from("<IIII", payload)
+            if echoed_seq != seq:
+                continue            # Late echo of a ping already counted as lost
+            if not check_data(payload, length):
+                lost += 1
+                break
+            rtts.append(((stamp - host_us) & 0xFFFFFFFF) / 1000.0)
+            turnaround.append(((tx_us - rx_us) & 0xFFFFFFFF) / 1000.0)
+            break
+    elapsed = time.monotonic() - start
+    return {"frames": len(rtts), "bytes": len(rtts) * (length + FRAME_OVERHEAD), "seconds": elapsed,
+            "loss": lost, "rtt_ms": rtts, "turnaround_ms": turnaround,
+            "checksum_errors": link.parser.checksum_errors, "buffer_size": report["buffer_size"]}
+
+
+TESTS = {"sink": run_sink, "source": run_source, "echo": run_echo, "pingpong": run_pingpong}
+
+
+def summarize(test, baud, length, result):
+    line_Bps = baud / BITS_PER_BYTE
+    # Bytes counted in one direction; echo and pingpong load both lines equally
+    if test == "source":
+        throughput = result["host_Bps"]
+    else:
+        throughput = result["bytes"] / result["seconds"] if result["seconds"] else 0.0
+    rtts = result.get("rtt_ms", [])
+    turns = result.get("turnaround_ms", [])
+    return {
+        "test": test, "baud": baud, "len": length, "buffer": result["buffer_size"],
+        "frames": result["frames"], "loss": result["loss"],
+        "throughput_Bps": round(throughput), "line_pct": round(100.0 * throughput / line_Bps, 1),
+        "board_Bps": round(result.get("board_Bps", 0.0)),
+        "rtt_p50_ms": round(percentile(rtts, 50), 3), "rtt_p90_ms": round(percentile(rtts, 90), 3),
+        "rtt_p99_ms": round(percentile(rtts, 99), 3), "rtt_max_ms": round(max(rtts), 3) if rtts else 0.0,
+        "turnaround_p50_ms": round(percentile(turns, 50), 3),
+        "checksum_errors": result["checksum_errors"], "overruns": result.get("overruns", 0),
+    }
+
+
+COLUMNS = ("test", "baud", "len", "buffer", "frames", "loss", "throughput_Bps", "line_pct", "board_Bps",
+           "rtt_p50_ms", "rtt_p90_ms", "rtt_p99_ms", "rtt_max_ms", "turnaround_p50_ms",
+           "checksum_errors", "overruns")
+
+
+def switch_baud(link, baud, timeout):
+    link.control(struct.pack("<BI", OP_SET_BAUD, baud), timeout)
+    link.port.drain()
+    time.sleep(0.05)                # The board switches once its TX line is idle
+    link.port.set_baud(baud)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Link benchmark for UART_ENABLE_BENCHMARK firmware.",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="serial device; omit with --sim")
+    parser.add_argument("--sim", action="store_true", help="run against the pty board emulator")
+    parser.add_argument("--boot-baud", type=int, default=115200, help="baud rate the firmware starts at")
+    parser.add_argument("--baud", default="115200", help="comma-separated baud rates to test")
+    parser.add_argument("--len", default="16,64,256", help="comma-separated DATA payload lengths")
+    parser.add_argument("--count", type=int, default=500, help="frames per sink/source/echo run")
+    parser.add_argument("--pings", type=int, default=200, help="round trips per pingpong run")
+    parser.add_argument("--tests", default="sink,source,echo,pingpong", help="comma-separated tests")
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds without a frame before giving up")
+    parser.add_argument("--csv", help="also write the results to this file")
+    args = parser.parse_args()
+
+    if args.sim == (args.port is not None):
+        parser.error("give a serial port or --sim")
+    tests = [t for t in args.tests.split(",") if t]
+    for test in tests:
+        if test not in TESTS:
+            parser.error("unknown test %s" % test)
+    bauds = [int(b) for b in args.baud.split(",") if b]
+    lengths = [min(max(int(n), DATA_HEADER), MAX_PAYLOAD) for n in args.len.split(",") if n]
+
+    board = SimBoard(args.boot_baud) if args.sim else None
+    port = Port(board.path if board else args.port, args.boot_baud)
+    link = Link(port)
+    current = args.boot_baud
+    rows = []
+
+    try:
+        print(" ".join("%-*s" % (max(6, len(c)), c) for c in COLUMNS))
+        for baud in bauds:
+            if baud != current:
+                switch_baud(link, baud, args.timeout)
+                current = baud
+            for length in lengths:
+                for test in tests:
+                    count = args.pings if test == "pingpong" else args.count
+                    link.parser.checksum_errors = 0
+                    row = summarize(test, baud, length, TESTS[test](link, baud, length, count, args.timeout))
+                    rows.append(row)
+                    print(" ".join("%-*s" % (max(6, len(c)), row[c]) for c in COLUMNS))
+                    sys.stdout.flush()
+        if current != args.boot_baud:
+            switch_baud(link, args.boot_baud, args.timeout)
+    finally:
+        port.close()
+        if board is not None:
+            board.close()
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=COLUMNS)
+            writer.writeheader()
+            writer.writerows(rows)
+
+    return 0 if all(row["loss"] == 0 and row["checksum_errors"] == 0 for row in rows) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())